@@ -25,6 +25,10 @@
 
 #include "scheduler.hpp"
 
+#ifdef EVENT_PROFILING
+#include "ns3/ndnSIM/utils/tracers/ndn-event-profiler.hpp"
+#endif // EVENT_PROFILING
+
 namespace ns3 {
 
 /// @cond include_hidden
@@ -49,6 +53,10 @@ namespace scheduler {
 EventId
 schedule(const time::nanoseconds& after, const std::function<void()>& event)
 {
+#ifdef EVENT_PROFILING
+  // label the event after the callback rather than std::function, when profiled
+  ns3::ndn::EventProfiler::ScopedLabel label(event.target_type());
+#endif // EVENT_PROFILING
   ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
                                              &std::function<void()>::operator(), event);
   return std::make_shared<ns3::EventId>(id);
@@ -34,7 +34,13 @@ enum
   NdnlpSequence  = 81,
   NdnlpFragIndex = 82,
   NdnlpFragCount = 83,
-  NdnlpPayload   = 84
+  NdnlpPayload   = 84,
+
+  // WLDR, see wldr.hpp
+  WldrHeader           = 85,
+  WldrSequence         = 86,
+  WldrLossNotification = 87,
+  WldrDestination      = 88
 };
 
 } // namespace tlv
@@ -0,0 +1,217 @@
+#ifdef WLDR
+
+#include "wldr.hpp"
+#include "core/logger.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace nfd {
+
+NFD_LOG_INIT("Wldr");
+
+Wldr::Wldr(uint64_t localId, size_t bufferSize, size_t maxRetransmissions)
+  : m_localId(localId)
+  , m_maxRetransmissions(maxRetransmissions)
+  , m_nextSeq(0)
+  , m_retxCounts(bufferSize, 0)
+  , m_nLosses(0)
+  , m_nRecovered(0)
+  , m_nDuplicates(0)
+  , m_nLossNotifications(0)
+  , m_nRetransmissions(0)
+  , m_nUnrecoverable(0)
+{
+  BOOST_ASSERT(bufferSize > 0);
+}
+
+uint64_t
+Wldr::assignSequence()
+{
+  uint64_t seq = m_nextSeq++;
+  m_retxCounts[seq % m_retxCounts.size()] = 0;
+  return seq;
+}
+
+bool
+Wldr::receivePacket(uint64_t peer, uint64_t seq)
+{
+  auto it = m_peers.find(peer);
+  if (it == m_peers.end()) {
+    // first packet from this peer
+    m_peers[peer].expectedSeq = seq + 1;
+    return true;
+  }
+
+  PeerState& state = it->second;
+  uint64_t bufferSize = m_retxCounts.size();
+
+  if (seq == state.expectedSeq) {
+    ++state.expectedSeq;
+    return true;
+  }
+
+  if (seq > state.expectedSeq) {
+    if (seq - state.expectedSeq > bufferSize) {
+      // peer was out of reach for a while, its buffer no longer has the missing packets
+      NFD_LOG_DEBUG("peer=" << peer << " resync " << state.expectedSeq << " -> " << seq);
+      state.missingSeqs.clear();
+    }
+    else {
+      NFD_LOG_DEBUG("peer=" << peer << " lost " << state.expectedSeq << "-" << seq - 1);
+      m_nLosses += seq - state.expectedSeq;
+      for (uint64_t missing = state.expectedSeq; missing < seq; ++missing) {
+        state.missingSeqs.insert(missing);
+      }
+      while (state.missingSeqs.size() > bufferSize) {
+        state.missingSeqs.erase(state.missingSeqs.begin());
+      }
+      this->sendLossNotification(peer, state.expectedSeq, seq - 1);
+    }
+    state.expectedSeq = seq + 1;
+    return true;
+  }
+
+  // seq < expectedSeq: retransmission
+  if (state.missingSeqs.erase(seq) > 0) {
+    NFD_LOG_DEBUG("peer=" << peer << " recovered " << seq);
+    ++m_nRecovered;
+    return true;
+  }
+
+  if (state.expectedSeq - seq > bufferSize) {
+    // peer restarted its sequence
+    NFD_LOG_DEBUG("peer=" << peer << " resync " << state.expectedSeq << " -> " << seq);
+    state.expectedSeq = seq + 1;
+    state.missingSeqs.clear();
+    return true;
+  }
+
+  ++m_nDuplicates;
+  return false;
+}
+
+void
+Wldr::sendLossNotification(uint64_t peer, uint64_t first, uint64_t last)
+{
+  ndn::EncodingBuffer buffer;
+  size_t totalLength = 0;
+
+  totalLength += encodeSequence(buffer, last);
+  totalLength += encodeSequence(buffer, first);
+  size_t destinationLength = buffer.prependNonNegativeInteger(peer);
+  totalLength += destinationLength;
+  totalLength += buffer.prependVarNumber(destinationLength);
+  totalLength += buffer.prependVarNumber(tlv::WldrDestination);
+  totalLength += buffer.prependVarNumber(totalLength);
+  totalLength += buffer.prependVarNumber(tlv::WldrLossNotification);
+
+  ++m_nLossNotifications;
+  this->onSendLossNotification(buffer.block());
+}
+
+void
+Wldr::receiveLossNotification(const Block& wire)
+{
+  uint64_t destination = 0;
+  uint64_t first = 0;
+  uint64_t last = 0;
+  try {
+    wire.parse();
+    const Block::element_container& elements = wire.elements();
+    if (wire.type() != tlv::WldrLossNotification || elements.size() != 3 ||
+        elements[0].type() != tlv::WldrDestination) {
+      NFD_LOG_WARN("malformed loss notification");
+      return;
+    }
+    destination = ndn::readNonNegativeInteger(elements[0]);
+    first = decodeSequence(elements[1]);
+    last = decodeSequence(elements[2]);
+  }
+  catch (const tlv::Error&) {
+    NFD_LOG_WARN("malformed loss notification");
+    return;
+  }
+
+  if (destination != m_localId) {
+    return;
+  }
+
+  NFD_LOG_DEBUG("notified loss " << first << "-" << last);
+
+  uint64_t bufferSize = m_retxCounts.size();
+  for (uint64_t seq = first; seq <= last && seq < m_nextSeq; ++seq) {
+    uint8_t& retxCount = m_retxCounts[seq % bufferSize];
+    if (m_nextSeq - seq > bufferSize || retxCount >= m_maxRetransmissions) {
+      ++m_nUnrecoverable;
+      continue;
+    }
+
+    ++retxCount;
+    ++m_nRetransmissions;
+    this->onRetransmit(seq);
+  }
+}
+
+template<bool T>
+size_t
+Wldr::encodeSequence(ndn::EncodingImpl<T>& blk, uint64_t seq)
+{
+  // fixed size, as NdnlpSequence
+  uint64_t sequenceBE = htobe64(seq);
+  size_t totalLength = blk.prependByteArray(reinterpret_cast<uint8_t*>(&sequenceBE),
+                                            sizeof(sequenceBE));
+  totalLength += blk.prependVarNumber(sizeof(sequenceBE));
+  totalLength += blk.prependVarNumber(tlv::WldrSequence);
+  return totalLength;
+}
+
+uint64_t
+Wldr::decodeSequence(const Block& wire)
+{
+  if (wire.type() != tlv::WldrSequence || wire.value_size() != sizeof(uint64_t)) {
+    throw tlv::Error("WldrSequence is malformed");
+  }
+  return be64toh(*reinterpret_cast<const uint64_t*>(&*wire.value_begin()));
+}
+
+Block
+Wldr::encodeHeader(uint64_t seq)
+{
+  ndn::EncodingBuffer buffer;
+  size_t totalLength = encodeSequence(buffer, seq);
+  totalLength += buffer.prependVarNumber(totalLength);
+  totalLength += buffer.prependVarNumber(tlv::WldrHeader);
+  return buffer.block();
+}
+
+std::tuple<bool, uint64_t>
+Wldr::decodeHeader(const Block& wire)
+{
+  try {
+    if (wire.type() != tlv::WldrHeader) {
+      return std::make_tuple(false, 0);
+    }
+    wire.parse();
+    if (wire.elements().size() != 1) {
+      return std::make_tuple(false, 0);
+    }
+    return std::make_tuple(true, decodeSequence(wire.elements().front()));
+  }
+  catch (const tlv::Error&) {
+    return std::make_tuple(false, 0);
+  }
+}
+
+size_t
+Wldr::getHeaderSize()
+{
+  ndn::EncodingEstimator estimator;
+  size_t totalLength = encodeSequence(estimator, 0);
+  totalLength += estimator.prependVarNumber(totalLength);
+  totalLength += estimator.prependVarNumber(tlv::WldrHeader);
+  return totalLength;
+}
+
+} // namespace nfd
+
+#endif // WLDR
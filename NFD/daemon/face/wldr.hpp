@@ -0,0 +1,198 @@
+#ifndef NFD_DAEMON_FACE_WLDR_HPP
+#define NFD_DAEMON_FACE_WLDR_HPP
+
+#ifdef WLDR
+
+#include "common.hpp"
+#include "ndnlp-tlv.hpp"
+
+#define WLDR_DEFAULT_BUFFER_SIZE 64 /* packets */
+#define WLDR_DEFAULT_MAX_RETX 2
+
+namespace nfd {
+
+/** \brief Wireless Loss Detection and Recovery (WLDR)
+ *
+ *  Link-layer loss recovery for lossy (wireless) links, without acknowledgements:
+ *
+ *  - the sender labels every network layer packet with a per-link sequence number, and keeps
+ *    the last packets in a retransmission buffer;
+ *  - the receiver detects losses as gaps in the sequence numbers received from each peer, and
+ *    sends back a loss notification with the missing range;
+ *  - the sender retransmits the notified packets that are still buffered, with their
+ *    original sequence number; the receiver passes them up only once.
+ *
+ *  A loss is only detected when a later packet is received from the same peer.  Losses at the
+ *  end of a burst are left to end-to-end recovery.
+ *
+ *  This class implements the protocol, independently of how packets are stored and sent: the
+ *  face keeps the packet of sequence number \p seq at index seq % getBufferSize(), and
+ *  retransmits it when onRetransmit fires.
+ *
+ *  WldrHeader ::= WLDR-HEADER-TYPE TLV-LENGTH
+ *                   WldrSequence
+ *  (followed by the network layer packet)
+ *
+ *  WldrLossNotification ::= WLDR-LOSS-NOTIFICATION-TYPE TLV-LENGTH
+ *                             WldrDestination
+ *                             WldrSequence (first missing)
+ *                             WldrSequence (last missing)
+ */
+class Wldr : noncopyable
+{
+public:
+  /** \param localId link-layer identifier of the local endpoint, as seen by peers
+   *  \param bufferSize number of sent packets kept for retransmission
+   *  \param maxRetransmissions maximum number of retransmissions of a packet
+   */
+  explicit
+  Wldr(uint64_t localId,
+       size_t bufferSize = WLDR_DEFAULT_BUFFER_SIZE,
+       size_t maxRetransmissions = WLDR_DEFAULT_MAX_RETX);
+
+  /** \brief assigns the sequence number of an outgoing network layer packet
+   *
+   *  The caller must keep the packet for retransmission until getBufferSize() more packets
+   *  are sent.
+   */
+  uint64_t
+  assignSequence();
+
+  /** \brief processes the sequence number of a packet received from \p peer
+   *
+   *  Fires onSendLossNotification when packets are found missing.
+   *
+   *  \return whether the packet must be passed to the network layer, false if it is a
+   *          duplicate of a packet already received
+   */
+  bool
+  receivePacket(uint64_t peer, uint64_t seq);
+
+  /** \brief processes a WldrLossNotification received from the link
+   *
+   *  Fires onRetransmit for notified packets that are still buffered.  Notifications
+   *  for other endpoints are ignored.
+   */
+  void
+  receiveLossNotification(const Block& wire);
+
+  size_t
+  getBufferSize() const
+  {
+    return m_retxCounts.size();
+  }
+
+public: // encoding
+  /** \return WldrHeader with sequence number \p seq
+   */
+  static Block
+  encodeHeader(uint64_t seq);
+
+  /** \brief parses a WldrHeader
+   *  \return whether \p wire has a valid WldrHeader, and its sequence number
+   */
+  static std::tuple<bool, uint64_t>
+  decodeHeader(const Block& wire);
+
+  /** \brief size of an encoded WldrHeader
+   */
+  static size_t
+  getHeaderSize();
+
+public: // counters
+  /** \brief number of packets found missing
+   */
+  uint64_t
+  getNLosses() const
+  {
+    return m_nLosses;
+  }
+
+  /** \brief number of missing packets received after a loss notification
+   */
+  uint64_t
+  getNRecovered() const
+  {
+    return m_nRecovered;
+  }
+
+  /** \brief number of duplicate packets dropped
+   */
+  uint64_t
+  getNDuplicates() const
+  {
+    return m_nDuplicates;
+  }
+
+  uint64_t
+  getNLossNotifications() const
+  {
+    return m_nLossNotifications;
+  }
+
+  /** \brief number of packets retransmitted
+   */
+  uint64_t
+  getNRetransmissions() const
+  {
+    return m_nRetransmissions;
+  }
+
+  /** \brief number of notified packets which could not be retransmitted
+   */
+  uint64_t
+  getNUnrecoverable() const
+  {
+    return m_nUnrecoverable;
+  }
+
+public:
+  /** \brief fires when a WldrLossNotification must be sent on the link
+   */
+  signal::Signal<Wldr, Block> onSendLossNotification;
+
+  /** \brief fires when the packet with the given sequence number must be retransmitted
+   */
+  signal::Signal<Wldr, uint64_t> onRetransmit;
+
+private:
+  template<bool T>
+  static size_t
+  encodeSequence(ndn::EncodingImpl<T>& blk, uint64_t seq);
+
+  static uint64_t
+  decodeSequence(const Block& wire);
+
+  void
+  sendLossNotification(uint64_t peer, uint64_t first, uint64_t last);
+
+private:
+  struct PeerState
+  {
+    uint64_t expectedSeq;
+    std::set<uint64_t> missingSeqs; ///< notified, not received yet
+  };
+
+  uint64_t m_localId;
+  size_t m_maxRetransmissions;
+
+  // sender
+  uint64_t m_nextSeq;
+  std::vector<uint8_t> m_retxCounts; ///< indexed by sequence number modulo buffer size
+
+  // receiver
+  std::unordered_map<uint64_t, PeerState> m_peers;
+
+  uint64_t m_nLosses;
+  uint64_t m_nRecovered;
+  uint64_t m_nDuplicates;
+  uint64_t m_nLossNotifications;
+  uint64_t m_nRetransmissions;
+  uint64_t m_nUnrecoverable;
+};
+
+} // namespace nfd
+
+#endif // WLDR
+
+#endif // NFD_DAEMON_FACE_WLDR_HPP
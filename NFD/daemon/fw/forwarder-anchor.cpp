@@ -34,8 +34,13 @@ ForwarderAnchor::ForwarderAnchor()
   , m_onProcessing(ns3::MakeNullCallback<void, std::string, uint64_t, uint64_t, uint64_t>())
 #endif // NDNSIM
 {
+#ifdef NDNSIM
+  this->setPipelines<ForwarderAnchor>();
+#endif // NDNSIM
   /* Anchor reacts to face add events to send special interests */
   getFaceTable().onAdd.connect(bind(&ForwarderAnchor::onFaceAdded, this, _1));
+  /* ... and to L2 reassociations, which do not create a new face */
+  afterFaceAssociated.connect(bind(&ForwarderAnchor::onFaceAdded, this, _1));
 }
 
 /*------------------------------------------------------------------------------
@@ -16,7 +16,7 @@
 
 namespace nfd {
 
-class ForwarderAnchor : public Forwarder
+class ForwarderAnchor final : public Forwarder
 {
 public:
   ForwarderAnchor();
@@ -39,6 +39,9 @@ private:
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 
+  // allow Forwarder to enter the pipelines of this class with static dispatch
+  friend class Forwarder;
+
 protected:
   uint64_t m_retx;
 
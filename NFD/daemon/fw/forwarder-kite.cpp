@@ -99,7 +99,6 @@
 #include "forwarder-kite.hpp"
 
 #include <vector>
-#include <boost/algorithm/string/predicate.hpp>
 
 #define MS2NS(x) time::nanoseconds(x * 1000000)
 #define IS_TRACED(interest) ((interest.getTraceForwardingFlag() != 255) && (interest.getTraceForwardingFlag() & 1))
@@ -113,6 +112,10 @@ namespace nfd {
 
 NFD_LOG_INIT("ForwarderKite");
 
+#ifdef WITH_RELIABLE_RETRANSMISSION
+static const Name KITE_TRACE_ACK_NAME(KITE_TRACE_ACK_PREFIX);
+#endif
+
 using fw::Strategy;
 
 /*------------------------------------------------------------------------------
@@ -132,8 +135,13 @@ ForwarderKite::ForwarderKite()
 #endif // NDNSIM
 
 {
+#ifdef NDNSIM
+  this->setPipelines<ForwarderKite>();
+#endif // NDNSIM
   getFaceTable().onAdd.connect(bind(&ForwarderKite::onFaceAdded, this, _1));
   getFaceTable().onRemove.connect(bind(&ForwarderKite::onFaceRemoved, this, _1));
+  // L2 reassociations do not create a new face
+  afterFaceAssociated.connect(bind(&ForwarderKite::onFaceAdded, this, _1));
 
   m_fib.onAdd.connect(bind(&ForwarderKite::onFibEntryChanged, this, _1));
   m_fib.onUpdate.connect(bind(&ForwarderKite::onFibEntryChanged, this, _1));
@@ -159,7 +167,7 @@ ForwarderKite::updateTraceToAnchor(weak_ptr<Face> wpFace)
    */
   for (auto & it : m_pendingUpdates) {
     shared_ptr<Interest> interest = make_shared<Interest>();
-    interest->setName(Name(it.first));
+    interest->setName(it.first);
     interest->setInterestLifetime(time::milliseconds(KITE_DEFAULT_RETX));
     interest->setTraceForwardingFlag(KITE_FLAG_TRACEABLE);
     
@@ -181,13 +189,13 @@ ForwarderKite::updateTraceToAnchor(weak_ptr<Face> wpFace)
     uint64_t seq = (it_seq != m_seq.end()) ? it_seq->second : -1;
     m_seq[it.first] = ++seq;
     m_retx[it.first] = RETX_INIT;
-    m_onSpecialInterest(it.first, seq, TTL_INIT, RETX_INIT);
+    m_onSpecialInterest(it.first.toUri(), seq, TTL_INIT, RETX_INIT);
   }
 }
 
 #ifdef WITH_RELIABLE_RETRANSMISSION
 void 
-ForwarderKite::sendReliableTracedInterest(weak_ptr<Face> wpFace, std::string prefix, shared_ptr<Interest> interest)
+ForwarderKite::sendReliableTracedInterest(weak_ptr<Face> wpFace, Name prefix, shared_ptr<Interest> interest)
 {
   scheduler::cancel(m_pendingRetx[prefix]);
   shared_ptr<Face> face = wpFace.lock();
@@ -207,10 +215,10 @@ ForwarderKite::sendReliableTracedInterest(weak_ptr<Face> wpFace, std::string pre
 #endif
 
 void
-ForwarderKite::refreshTraceToAnchor(std::string prefix)
+ForwarderKite::refreshTraceToAnchor(Name prefix)
 {  
   shared_ptr<Interest> interest = make_shared<Interest>();
-  interest->setName( Name(prefix));
+  interest->setName(prefix);
   interest->setInterestLifetime(time::milliseconds(KITE_DEFAULT_RETX));
   interest->setTraceForwardingFlag(KITE_FLAG_TRACEABLE);
   
@@ -239,7 +247,7 @@ ForwarderKite::refreshTraceToAnchor(std::string prefix)
   auto it_retx = m_retx.find(prefix);
   uint64_t retx = (it_retx != m_retx.end()) ? it_retx->second : 0;
   m_retx[prefix] = ++retx;
-  m_onSpecialInterest(prefix, seq, TTL_INIT, retx);
+  m_onSpecialInterest(prefix.toUri(), seq, TTL_INIT, retx);
   }
 
   // ..., clear any pending update  ...
@@ -290,7 +298,7 @@ ForwarderKite::onFibEntryChanged(shared_ptr<fib::Entry> fibEntry)
 {
   for (auto & it : fibEntry->getNextHops()) {
     if (it.getFace()->getLocalUri() == FaceUri("appFace://")) {
-      std::string prefix = fibEntry->getPrefix().toUri();
+      const Name& prefix = fibEntry->getPrefix();
       //NOTE: we need to skip the anchor application, which is not a real producer application:
 
       /* The node is a producer for prefix fibEntry->getPrefix() */
@@ -304,6 +312,15 @@ ForwarderKite::onFibEntryChanged(shared_ptr<fib::Entry> fibEntry)
   }
 }
 
+void
+ForwarderKite::setTraceLookupTimer(shared_ptr<pit::Entry> tracedPitEntry,
+                                   const time::milliseconds& lifetime)
+{
+  scheduler::cancel(tracedPitEntry->m_unsatisfyTimer);
+  tracedPitEntry->m_unsatisfyTimer = scheduler::schedule(lifetime,
+    bind(&ForwarderKite::onInterestFinalize, this, tracedPitEntry, false, time::milliseconds(-1)));
+}
+
 /*-----------------------------------------------------------------------------
  * Overloaded functions
  *----------------------------------------------------------------------------*/
@@ -363,6 +380,14 @@ ForwarderKite::onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry>
       // Note that even if we had forwarded it, it could be an old trace. That's
       // also why we forward on all of them when we find more than one.
       NFD_LOG_TRACE("traced pit entry not found, tracename="<< interest.getTraceName());
+    }
+    if (tracedPitEntry->getInRecords().empty()) {
+      // No trace was left here, the entry only serves the lookup (and holds the TNT when
+      // pulling): make sure it does not stay in the PIT forever.
+      if (m_isPull)
+        this->setTraceLookupTimer(tracedPitEntry, interest.getInterestLifetime());
+      else if (tfEntryElement.second)
+        m_pit.erase(tracedPitEntry);
     } else {
       NFD_LOG_TRACE("traced pit entry is found" << ", traced pitEntry=" << (void*)(tracedPitEntry.get()) );
       const pit::InRecordCollection& inRecords = tracedPitEntry->getInRecords();
@@ -446,13 +471,14 @@ ForwarderKite::onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry>
 
         // TODO for (auto & it : pitTntEntry->getTracingInterests()) {
         const pit::TntEntry::TracingInterestList& tracingInterestRecords = pitTntEntry->getTracingInterests();
-        pit::TntEntry::TracingInterestList::const_iterator it;
-        for (it=tracingInterestRecords.begin(); it != tracingInterestRecords.end(); ++it) {
+        pit::TntEntry::TracingInterestList::const_iterator it, next;
+        for (it=tracingInterestRecords.begin(); it != tracingInterestRecords.end(); it = next) {
+          next = std::next(it);
 
           const pit::TntRecord& TracingRecord = it->second;
           if (!TracingRecord.isValid()) {
             NFD_LOG_TRACE("SHOULD NOT HAPPEN ! meet tracing record. It's not valid, remove it");
-            pitTntEntry->removeTracingRecord(it);
+            next = pitTntEntry->removeTracingRecord(it);
             continue;
           }
 
@@ -523,13 +549,11 @@ ForwarderKite::onContentStoreMiss(const Face& inFace, shared_ptr<pit::Entry>
       else {
         // THIS IS TO DETECT WE HAVE REACHED THE ANCHOR... it has no FIB entry
 	      //automatically send an ack interest back:
-        std::ostringstream nstream;
         //NOTE: here it is assumed that prefix has only one name componet like /prefix0 ,
         //we add a sequence number in the ack name to avoid the ack to be pending somewhere
 	      //xxx, should be generalized for longer prefix
-        nstream<<KITE_TRACE_ACK_PREFIX<<"/"<<m_ack_seq++<<interest.getName().toUri();
-        // std::cout <<"***************send back ack interest="<<nstream.str()<<"\n";
-        Name ackInterestName(nstream.str());
+        Name ackInterestName(KITE_TRACE_ACK_NAME);
+        ackInterestName.append(std::to_string(m_ack_seq++)).append(interest.getName());
         shared_ptr<Interest> ackInterest = make_shared<Interest>(ackInterestName);
 
         ackInterest->setTraceForwardingFlag(2); // interest shall be forwarded using trace only
@@ -581,9 +605,9 @@ ForwarderKite::onIncomingInterest(Face& inFace, const Interest& interest)
   Interest & interest_ = const_cast<Interest &>(interest);
 
 #ifdef WITH_RELIABLE_RETRANSMISSION
-  if( boost::starts_with(interest.getName().toUri(), KITE_TRACE_ACK_PREFIX)) // an ack interest is received
+  if (KITE_TRACE_ACK_NAME.isPrefixOf(interest.getName())) // an ack interest is received
   {
-      std::string prefix=interest.getName().getSubName(2, 3).toUri();
+      Name prefix = interest.getName().getSubName(2, 3);
 //        std::cout<<"recieved ack for "<<prefix<<", at="<<(void*)this<<", from="<<inFace.getId()<<",prefix="<<prefix<<"\n";
       if(!m_pendingUpdates.empty() && m_pendingUpdates.find(prefix)!=m_pendingUpdates.end())
       {
@@ -593,7 +617,7 @@ ForwarderKite::onIncomingInterest(Face& inFace, const Interest& interest)
       }
       else
       {
-       Forwarder::onIncomingInterest(inFace, interest_);/* Add trace for regular consumer interests */
+       this->processIncomingInterest<ForwarderKite>(inFace, interest_);/* Add trace for regular consumer interests */
       }
 
       return;
@@ -601,13 +625,13 @@ ForwarderKite::onIncomingInterest(Face& inFace, const Interest& interest)
 #endif
 
   /* Tag all interests incoming from a local face with KITE flags */
-  if (inFace.isLocal() && !boost::starts_with(interest.getName().toUri(), "/localhost")) {
+  if (inFace.isLocal() && !LOCALHOST_NAME.isPrefixOf(interest.getName())) {
     /* We assume we have a default route in the FIB that we only use to get
      * the traceName, since we prefix all consumer interests with
      * KITE_BASE_TRACENAME
      *
      */
-    Name traceName(interest.getName().getSubName(0, 1).toUri());
+    Name traceName = interest.getName().getPrefix(1);
     NFD_LOG_INFO("Hooked consumer interest with traceName=" << traceName);
     interest_.setTraceName(traceName);
     interest_.setTraceForwardingFlag(KITE_FLAG_FOLLOW_TRACE_AND_FIB);
@@ -640,7 +664,7 @@ ForwarderKite::onIncomingInterest(Face& inFace, const Interest& interest)
      // detect duplicate Nonce
      int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
      bool hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
-                           m_deadNonceList.has(interest.getName(), interest.getNonce());
+                           m_deadNonceList.has(pitEntry->getNameHash(), interest.getNonce());
      if (hasDuplicateNonce) {
        // goto Interest loop pipeline
        this->onInterestLoop(inFace, interest_, pitEntry);
@@ -655,7 +679,7 @@ ForwarderKite::onIncomingInterest(Face& inFace, const Interest& interest)
    }
 
   /* Add trace for regular consumer interests */
-  Forwarder::onIncomingInterest(inFace, interest_);
+  this->processIncomingInterest<ForwarderKite>(inFace, interest_);
 
 
 
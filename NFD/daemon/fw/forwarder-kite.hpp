@@ -15,6 +15,8 @@
 
 #include "forwarder.hpp"
 
+#include <unordered_map>
+
 // DEPRECATED| static const Time TRACE_UPDATE_INTERVAL;
 // DEPRECATED| const Time Producer::TRACE_UPDATE_INTERVAL=Time("1.0s");
 #define KITE_DEFAULT_RETX 2000 /* ms */
@@ -33,7 +35,7 @@
 
 namespace nfd {
 
-class ForwarderKite : public Forwarder
+class ForwarderKite final : public Forwarder
 {
 public:
 
@@ -61,13 +63,16 @@ public:
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 
+  // allow Forwarder to enter the pipelines of this class with static dispatch
+  friend class Forwarder;
+
 private:
 
   void
   updateTraceToAnchor(weak_ptr<Face> wpFace);
 
   void
-  refreshTraceToAnchor(std::string prefix);
+  refreshTraceToAnchor(Name prefix);
 
   void
   onFaceAdded(shared_ptr<Face> face);
@@ -78,17 +83,28 @@ private:
   void
   onFibEntryChanged(shared_ptr<fib::Entry> fibEntry);
 
+  /** @brief (re)schedule removal of a PIT entry that only holds a trace lookup
+   *
+   *  A tracing interest that finds no trace leaves an entry without InRecords in the PIT,
+   *  possibly with a TNT attached. Such entries have no unsatisfy timer of their own: they
+   *  are finalized once the last tracing interest looking them up has expired, unless a
+   *  traced interest arrives and turns them into a regular trace.
+   */
+  void
+  setTraceLookupTimer(shared_ptr<pit::Entry> tracedPitEntry, const time::milliseconds& lifetime);
+
 #ifdef WITH_RELIABLE_RETRANSMISSION
   void 
-  sendReliableTracedInterest(weak_ptr<Face> wpFace, std::string prefix, shared_ptr<Interest> interest);
-  std::map<std::string, scheduler::EventId> m_pendingRetx;
+  sendReliableTracedInterest(weak_ptr<Face> wpFace, Name prefix, shared_ptr<Interest> interest);
+  std::unordered_map<Name, scheduler::EventId> m_pendingRetx;
   uint32_t m_ack_seq;///< sequence number used for sending ACK interest from anchor router
 #endif
    
 private:  
-  std::map<std::string, scheduler::EventId> m_pendingUpdates;
-  std::map<std::string, uint64_t> m_seq;
-  std::map<std::string, uint64_t> m_retx;
+  // per-prefix producer state, keyed by Name to avoid building URIs on the fast path
+  std::unordered_map<Name, scheduler::EventId> m_pendingUpdates;
+  std::unordered_map<Name, uint64_t> m_seq;
+  std::unordered_map<Name, uint64_t> m_retx;
   bool m_isPull;
 
 
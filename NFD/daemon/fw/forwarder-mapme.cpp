@@ -21,6 +21,8 @@ using fw::Strategy;
 #define TTL_NA 255
 #define RETX_NA 255
 
+static const Name MAPME_BATCH_NAME(MAPME_BATCH_PREFIX);
+
 // Currently, discovery goes in hand with notifications. We might decouple this.
 #define DO_DISCOVERY (m_Tu > 0)
 
@@ -37,16 +39,22 @@ ForwarderMapMe::ForwarderMapMe(uint64_t Tu = MAPME_DEFAULT_TU)
   : Forwarder()
   , m_Tu(Tu)
   , m_retx(MAPME_DEFAULT_RETX)
+  , m_isBatched(false)
 #ifdef NDNSIM
   , m_onSpecialInterest(ns3::MakeNullCallback<void, std::string, uint64_t, uint64_t, uint64_t>())
   , m_onProcessing(ns3::MakeNullCallback<void, std::string, uint64_t, uint64_t, uint64_t>())
 #endif // NDNSIM
 {
+#ifdef NDNSIM
+  this->setPipelines<ForwarderMapMe>();
+#endif // NDNSIM
   /* XXX This cannot be an initializer because... */
   m_removeFibEntries = false;
 
   /* MapMe reacts to face add events to send special interests */
   getFaceTable().onAdd.connect(bind(&ForwarderMapMe::onFaceAdded, this, _1));
+  /* ... and to L2 reassociations, which do not create a new face */
+  afterFaceAssociated.connect(bind(&ForwarderMapMe::onFaceAdded, this, _1));
 }
 
 /*------------------------------------------------------------------------------
@@ -140,12 +148,7 @@ ForwarderMapMe::sendSpecialInterest(Name prefix, weak_ptr<fib::Entry> wpFibEntry
   /* Heuristic: interest type */
   shared_ptr<TFibEntry> tfibEntry = dynamic_pointer_cast<TFibEntry>(fibEntry->getExtension());
   assert(tfibEntry);
-  auto it = tfibEntry->m_lastAckedUpdate.find(prefix);
-  time::steady_clock::time_point now = time::steady_clock::now();
-  double interval_s = time::duration_cast<time::duration<double>>(now - it->second).count();
-
-  tlv::SpecialInterestTypeValue type = (it != tfibEntry->m_lastAckedUpdate.end() 
-      && (S2MS(interval_s) < m_Tu) && is_first)
+  tlv::SpecialInterestTypeValue type = isNotificationAllowed(prefix, tfibEntry, is_first)
     ? tlv::TYPE_IN 
     : tlv::TYPE_IU;
 
@@ -164,6 +167,163 @@ ForwarderMapMe::sendSpecialInterest(Name prefix, weak_ptr<fib::Entry> wpFibEntry
   // - expected by onFaceAdded
 }
 
+// An IN is sent only for the first message after a move, if the last IU for
+// the prefix has been acked less than Tu ago
+bool
+ForwarderMapMe::isNotificationAllowed(const Name& prefix, shared_ptr<TFibEntry> tfibEntry, bool is_first)
+{
+  if (!is_first)
+    return false;
+
+  auto it = tfibEntry->m_lastAckedUpdate.find(prefix);
+  if (it == tfibEntry->m_lastAckedUpdate.end())
+    return false;
+
+  time::steady_clock::time_point now = time::steady_clock::now();
+  double interval_s = time::duration_cast<time::duration<double>>(now - it->second).count();
+  return S2MS(interval_s) < m_Tu;
+}
+
+/*------------------------------------------------------------------------------
+ * Batched special interests
+ *
+ * In batched mode, a face has at most one special interest in flight, which
+ * carries every prefix pending on that face:
+ *
+ *   /localhop/mapme/batch/<prefix 1 TLV>/<seq 1>/.../<prefix N TLV>/<seq N>
+ *
+ * Prefixes queued at the same time (eg. all prefixes of a producer upon a
+ * handover, or all prefixes forwarded by a router) are coalesced by deferring
+ * the transmission to the end of the current event. The receiver processes
+ * each pair as a standalone special interest, and acknowledges the whole batch
+ * with a single packet carrying the same name.
+ *
+ * The batch is an IN only if every prefix it contains would have been sent as
+ * an IN; sending an IU instead is always safe.
+ *----------------------------------------------------------------------------*/
+
+/** \brief decodes the (prefix, seq) pairs carried by a batched special interest
+ *  \return false if the name is malformed
+ */
+static bool
+decodeBatch(const Name& name, std::vector<std::pair<Name, uint64_t>>& entries)
+{
+  if ((name.size() - MAPME_BATCH_NAME.size()) % 2 != 0)
+    return false;
+
+  try {
+    for (size_t i = MAPME_BATCH_NAME.size(); i < name.size(); i += 2) {
+      entries.emplace_back(Name(name[i].blockFromValue()), name[i + 1].toNumber());
+    }
+  }
+  catch (const tlv::Error&) {
+    return false;
+  }
+  return true;
+}
+
+void
+ForwarderMapMe::enqueueBatchedUpdate(const Name& prefix, weak_ptr<fib::Entry> wpFibEntry, FaceId faceId, bool is_first)
+{
+  PendingBatch& batch = m_pendingBatches[faceId];
+  BatchedPrefix& entry = batch.prefixes[prefix];
+  entry.fibEntry = wpFibEntry;
+  entry.is_first = is_first;
+
+  // New content restarts the retransmission count. The transmission is
+  // deferred so that other prefixes queued by the current event join the batch.
+  batch.num_retx = 0;
+  if (!batch.isSendScheduled) {
+    if (batch.timer)
+      scheduler::cancel(batch.timer);
+    batch.timer = scheduler::schedule(MS2NS(0), bind(&ForwarderMapMe::sendBatchedUpdates, this, faceId));
+    batch.isSendScheduled = true;
+  }
+}
+
+void
+ForwarderMapMe::removeBatchedUpdate(FaceId faceId, const Name& prefix)
+{
+  auto it = m_pendingBatches.find(faceId);
+  if (it == m_pendingBatches.end())
+    return;
+
+  it->second.prefixes.erase(prefix);
+  if (it->second.prefixes.empty()) {
+    if (it->second.timer)
+      scheduler::cancel(it->second.timer);
+    m_pendingBatches.erase(it);
+  }
+}
+
+void
+ForwarderMapMe::sendBatchedUpdates(FaceId faceId)
+{
+  auto it = m_pendingBatches.find(faceId);
+  if (it == m_pendingBatches.end())
+    return;
+  PendingBatch& batch = it->second;
+  batch.isSendScheduled = false;
+
+  shared_ptr<Face> face = getFaceTable().get(faceId);
+  if (face == nullptr) {
+    // The face is gone and will not come back with the same id
+    NFD_LOG_INFO("Invalid face, dropping batched special interests");
+    m_pendingBatches.erase(it);
+    return;
+  }
+  if (!isFaceValidAndUp(face)) {
+    // The face is down (eg. during a reassociation): keep retrying, as the
+    // unbatched path does, until it is up again
+    NFD_LOG_INFO("Face down, deferring batched special interests");
+    batch.timer = scheduler::schedule(MS2NS(m_retx), bind(&ForwarderMapMe::sendBatchedUpdates, this, faceId));
+    return;
+  }
+
+  Name name(MAPME_BATCH_NAME);
+  bool isNotification = true;
+  size_t nPrefixes = 0;
+  for (auto i = batch.prefixes.begin(); i != batch.prefixes.end(); ) {
+    shared_ptr<fib::Entry> fibEntry = i->second.fibEntry.lock();
+    if (!fibEntry) {
+      NFD_LOG_INFO("FIB entry has been deleted, removing " << i->first << " from batch");
+      i = batch.prefixes.erase(i);
+      continue;
+    }
+    shared_ptr<TFibEntry> tfibEntry = dynamic_pointer_cast<TFibEntry>(fibEntry->getExtension());
+    assert(tfibEntry);
+
+    // The latest sequence number is read at every (re)transmission
+    uint64_t seq = fibEntry->getSeq();
+    name.append(i->first.wireEncode()).appendNumber(seq);
+    isNotification = isNotification && isNotificationAllowed(i->first, tfibEntry, i->second.is_first);
+#ifdef NDNSIM
+    m_onSpecialInterest(i->first.toUri(), seq, TTL_NA, batch.num_retx);
+#endif // NDNSIM
+    ++i;
+
+    if (++nPrefixes == MAPME_BATCH_MAX_PREFIXES || i == batch.prefixes.end()) {
+      Interest specialInterest(name);
+      specialInterest.setAsSpecialInterest(isNotification ? tlv::TYPE_IN : tlv::TYPE_IU, 0);
+      NFD_LOG_INFO(" - sendBatchedUpdates face=" << face->getDescription() << " prefixes=" <<
+                   nPrefixes << " type=" << (isNotification ? "IN" : "IU"));
+      face->sendInterest(specialInterest);
+
+      name = MAPME_BATCH_NAME;
+      isNotification = true;
+      nPrefixes = 0;
+    }
+  }
+
+  if (batch.prefixes.empty()) {
+    m_pendingBatches.erase(it);
+    return;
+  }
+
+  ++batch.num_retx;
+  batch.timer = scheduler::schedule(MS2NS(m_retx), bind(&ForwarderMapMe::sendBatchedUpdates, this, faceId));
+}
+
 /*------------------------------------------------------------------------------
  * Event handling
  *----------------------------------------------------------------------------*/
@@ -211,7 +371,7 @@ ForwarderMapMe::onFaceAdded(shared_ptr<Face> face)
 void
 ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
 {
-  uint64_t fibSeq, seq = interest.getSequenceNumber();
+  uint64_t seq = interest.getSequenceNumber();
   bool send = (interest.getSpecialInterestType() == tlv::TYPE_IU);
 
   NS_LOG_INFO("(Special) Incoming special interest " << interest.getName());
@@ -227,20 +387,52 @@ ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
   ack->setAsSpecialInterest(send ? tlv::TYPE_IU_ACK: tlv::TYPE_IN_ACK, seq);
   inFace.sendInterest(*ack);
 
-  shared_ptr<fib::Entry> fibEntry = m_fib.findExactMatch(interest.getName());
+  processSpecialInterest(inFace, interest.getName(), seq, send);
+}
+
+void
+ForwarderMapMe::onBatchedSpecialInterest(Face& inFace, const Interest& interest)
+{
+  bool send = (interest.getSpecialInterestType() == tlv::TYPE_IU);
+
+  std::vector<std::pair<Name, uint64_t>> entries;
+  if (!decodeBatch(interest.getName(), entries)) {
+    NFD_LOG_INFO("Dropped malformed batched special interest " << interest.getName());
+    return;
+  }
+  NFD_LOG_INFO("onIncomingBatchedIU(face=" << inFace.getDescription() <<
+      ", prefixes=" << entries.size() << ")");
+
+  /* A single acknowledgement covers the whole batch */
+  Interest ack(interest);
+  ack.setAsSpecialInterest(send ? tlv::TYPE_IU_ACK: tlv::TYPE_IN_ACK, interest.getSequenceNumber());
+  inFace.sendInterest(ack);
+
+  for (const auto& entry : entries) {
+    m_onProcessing(entry.first.toUri(), entry.second, TTL_NA, RETX_NA);
+    processSpecialInterest(inFace, entry.first, entry.second, send);
+  }
+}
+
+void
+ForwarderMapMe::processSpecialInterest(Face& inFace, const Name& prefix, uint64_t seq, bool send)
+{
+  uint64_t fibSeq;
+
+  shared_ptr<fib::Entry> fibEntry = m_fib.findExactMatch(prefix);
   if (!static_cast<bool>(fibEntry)) {
     /* This will typically occur for a producer that has moved, the face is
      * destroyed, and thus all corresponding FIB entries
      * Upon receiving an IU, we need to create a new FIB entry
      */
-    fibEntry = m_fib.insert(interest.getName()).first;
+    fibEntry = m_fib.insert(prefix).first;
     // XXX shall this be done atomically ?
     fibEntry->addNextHop(inFace.shared_from_this(), UNIT_COST);
     fibEntry->setSeq(0);
     fibEntry->setExtension(make_shared<TFibEntry>());
 
-    NFD_LOG_INFO("Created FIB Entry for prefix" << interest.getName()
-        << " (seqno=" << interest.getSequenceNumber()
+    NFD_LOG_INFO("Created FIB Entry for prefix" << prefix
+        << " (seqno=" << seq
         << ", face=" << inFace.getDescription() << ")"); 
     // TODO  initial prefix dissemination might be handled here
     
@@ -269,9 +461,9 @@ ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
      * NOTE: we obviously don't forward an IN. 
      */
     NS_LOG_INFO("OnSpecialInterest: forwarding IU to pending faces");
-    if (interest.getSpecialInterestType() == tlv::TYPE_IU) {
+    if (send) {
       for (auto it = tfibEntry->pendingUpdates.begin(); it != tfibEntry->pendingUpdates.end(); it++) {
-        setFacePending(interest.getName(), fibEntry, tfibEntry, it->first, send, false);
+        setFacePending(prefix, fibEntry, tfibEntry, it->first, send, false);
       }
     }
 
@@ -303,7 +495,7 @@ ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
       }
 
       // This will forward an IU + add an entry for an IU or IN
-      setFacePending(interest.getName(), fibEntry, tfibEntry, face->getId(), send, false);
+      setFacePending(prefix, fibEntry, tfibEntry, face->getId(), send, false);
       complete = false;
     }
 
@@ -324,8 +516,11 @@ ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
     if (!isAlreadyNextHop) {
       auto it = tfibEntry->pendingUpdates.find(inFace.getId());
       if (it != tfibEntry->pendingUpdates.end()) {
-        scheduler::cancel(it->second);
+        if (it->second)
+          scheduler::cancel(it->second);
         tfibEntry->pendingUpdates.erase(it);
+        if (m_isBatched)
+          removeBatchedUpdate(inFace.getId(), prefix);
       }
 
       fibEntry->removeNextHops();
@@ -367,7 +562,7 @@ ForwarderMapMe::onSpecialInterest(Face & inFace, const Interest & interest)
      * NOTE: we don't do this for IN since there is no use in sending the
      * sequence number to the producer back again ?
      */
-    setFacePending(interest.getName(), fibEntry, tfibEntry, inFace.getId(), send, false);
+    setFacePending(prefix, fibEntry, tfibEntry, inFace.getId(), send, false);
   }
 
 }
@@ -392,7 +587,12 @@ ForwarderMapMe::setFacePending(Name prefix, weak_ptr<fib::Entry> wpFibEntry, sha
   // - at producer, send always true, we always send something reliably so we
   // set the timer.
   // - in the network, we always forward an IU, and never an IN
-  if (is_first || send) {
+  if ((is_first || send) && m_isBatched) {
+    NS_LOG_INFO("** queuing special interest in face batch");
+    // Reliability is handled per face by sendBatchedUpdates
+    enqueueBatchedUpdate(prefix, wpFibEntry, faceId, is_first);
+    timer = scheduler::EventId();
+  } else if (is_first || send) {
     NS_LOG_INFO("** reliably sending special interest");
     sendSpecialInterest(prefix, wpFibEntry, faceId, is_first, num_retx);
     timer = scheduler::schedule(MS2NS(m_retx), bind(&ForwarderMapMe::setFacePending, this, prefix, wpFibEntry, tfibEntry, faceId, send, is_first, num_retx + 1));
@@ -418,8 +618,38 @@ ForwarderMapMe::onSpecialInterestAck(Face& inFace, const Interest& interest)
   NFD_LOG_INFO("onIncoming interest, type=IU_ACK, face=" << inFace.getDescription() <<
       " interest=" << interest.getName()<<", seq="<<interest.getSequenceNumber());
 
-  shared_ptr<fib::Entry> fibEntry = m_fib.findExactMatch(interest.getName());
-  assert(!!fibEntry);
+  int seqNo = interest.getSequenceNumber();
+  processSpecialInterestAck(inFace, interest.getName(),
+                            seqNo == -1 ? NO_SEQUENCE_NUMBER : static_cast<uint64_t>(seqNo),
+                            interest.getSpecialInterestType() == tlv::TYPE_IU_ACK);
+}
+
+void
+ForwarderMapMe::onBatchedSpecialInterestAck(Face& inFace, const Interest& interest)
+{
+  std::vector<std::pair<Name, uint64_t>> entries;
+  if (!decodeBatch(interest.getName(), entries)) {
+    NFD_LOG_INFO("Dropped malformed batched special interest ack " << interest.getName());
+    return;
+  }
+  NFD_LOG_INFO("onIncoming batched interest, type=IU_ACK, face=" << inFace.getDescription() <<
+      " prefixes=" << entries.size());
+
+  for (const auto& entry : entries) {
+    processSpecialInterestAck(inFace, entry.first, entry.second,
+                              interest.getSpecialInterestType() == tlv::TYPE_IU_ACK);
+  }
+}
+
+void
+ForwarderMapMe::processSpecialInterestAck(Face& inFace, const Name& prefix, uint64_t seqNo,
+                                          bool isUpdateAck)
+{
+  shared_ptr<fib::Entry> fibEntry = m_fib.findExactMatch(prefix);
+  if (!fibEntry) {
+    NS_LOG_INFO("Ignored special interest Ack for unknown prefix " << prefix);
+    return;
+  }
 
   /* Test if the latest pending update has been ack'ed, otherwise just ignore */
   // XXX notification ack use timer from pendingUpdates ?????
@@ -427,8 +657,8 @@ ForwarderMapMe::onSpecialInterestAck(Face& inFace, const Interest& interest)
   // forwarded or not. We had better name it pending or pendingSignalization
   // or...
   // XXX need better type management here 
-  if (interest.getSequenceNumber() != -1) {
-    uint64_t seq = (uint64_t)interest.getSequenceNumber();
+  if (seqNo != NO_SEQUENCE_NUMBER) {
+    uint64_t seq = seqNo;
     uint64_t seq_fib = fibEntry->getSeq();
     if (seq < seq_fib) {
       NS_LOG_INFO("Ignored special interest Ack with seq=" << seq << ", expected " << seq_fib);
@@ -451,12 +681,14 @@ ForwarderMapMe::onSpecialInterestAck(Face& inFace, const Interest& interest)
   if (it->second)
     scheduler::cancel(it->second);
   tfibEntry->pendingUpdates.erase(it);
+  if (m_isBatched)
+    removeBatchedUpdate(inFace.getId(), prefix);
   NFD_LOG_INFO(" . removed TFIB entry for ack coming on face=" << inFace.getDescription());
 
   // XXX This is for the producer only
   // We need to update the timestamp only for IU Acks, not for IN Acks
-  if (interest.getSpecialInterestType() == tlv::TYPE_IU_ACK) {
-    tfibEntry->m_lastAckedUpdate[interest.getName()] = time::steady_clock::now();
+  if (isUpdateAck) {
+    tfibEntry->m_lastAckedUpdate[prefix] = time::steady_clock::now();
   }
 }
 
@@ -529,18 +761,24 @@ ForwarderMapMe::onIncomingInterest(Face& inFace, const Interest& interest)
     case tlv::TYPE_IU:
     case tlv::TYPE_IN:
       // XXX NEW SPECIAL INTEREST
-      onSpecialInterest(inFace, interest);
+      if (MAPME_BATCH_NAME.isPrefixOf(interest.getName()))
+        onBatchedSpecialInterest(inFace, interest);
+      else
+        onSpecialInterest(inFace, interest);
       return;
 
     case tlv::TYPE_IU_ACK:
     case tlv::TYPE_IN_ACK:
       // XXX NEW SPECIAL INTEREST ACK
-      onSpecialInterestAck(inFace, interest);
+      if (MAPME_BATCH_NAME.isPrefixOf(interest.getName()))
+        onBatchedSpecialInterestAck(inFace, interest);
+      else
+        onSpecialInterestAck(inFace, interest);
       return;
 
     default:
       // Normal behaviour
-      Forwarder::onIncomingInterest(inFace, interest);
+      this->processIncomingInterest<ForwarderMapMe>(inFace, interest);
       break;
   }
 }
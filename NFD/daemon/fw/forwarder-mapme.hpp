@@ -12,6 +12,8 @@
 #include "table/fib-entry.hpp"
 #include "daemon/face/face.hpp"
 
+#include <limits>
+
 #ifdef NDNSIM
 //for logging IU overhead
 #include "ns3/callback.h"
@@ -22,6 +24,11 @@
 #define MAPME_DEFAULT_TU 5000 /* ms */
 #define MAPME_DEFAULT_RETX 20 /* ms */
 
+/* Batched updates: the name carries, after this prefix, one (prefix, seq) pair
+ * of components per moved prefix */
+#define MAPME_BATCH_PREFIX "/localhop/mapme/batch"
+#define MAPME_BATCH_MAX_PREFIXES 32
+
 namespace nfd {
 
 // XXX merge mobility manager inside this class ?
@@ -113,17 +120,42 @@ private:
  * ForwarderMapMe : forwarding pipeline
  *----------------------------------------------------------------------------*/
 
-class ForwarderMapMe : public Forwarder
+class ForwarderMapMe final : public Forwarder
 {
 public:
   ForwarderMapMe(uint64_t Tu);
 
+  /** \brief enables aggregation of special interests per face
+   *
+   *  When enabled, all prefixes pending on a face are carried by a single
+   *  special interest (up to MAPME_BATCH_MAX_PREFIXES per packet) protected by
+   *  a single retransmission timer, instead of one interest and one timer per
+   *  prefix. Both ends of a link must use the same setting.
+   */
+  void
+  setBatchedUpdates(bool isBatched)
+  {
+    m_isBatched = isBatched;
+  }
+
+  bool
+  isBatchedUpdates() const
+  {
+    return m_isBatched;
+  }
+
   void
   onSpecialInterest(Face & inFace, const Interest & interest);
 
   void
   onSpecialInterestAck(Face& inFace, const Interest& interest);
 
+  void
+  onBatchedSpecialInterest(Face& inFace, const Interest& interest);
+
+  void
+  onBatchedSpecialInterestAck(Face& inFace, const Interest& interest);
+
   virtual void
   onIncomingInterest(Face& inFace, const Interest& interest);
 
@@ -156,17 +188,77 @@ private:
   void
   setFacePending(Name prefix, weak_ptr<fib::Entry> wpFibEntry, shared_ptr<TFibEntry> tfibEntry, FaceId faceId, bool send, bool is_first, uint32_t num_retx = 0);
 
+  bool
+  isNotificationAllowed(const Name& prefix, shared_ptr<TFibEntry> tfibEntry, bool is_first);
+
+  /** \brief FIB update triggered by a special interest for one prefix
+   *  \param send true for an IU, false for an IN
+   */
+  void
+  processSpecialInterest(Face& inFace, const Name& prefix, uint64_t seq, bool send);
+
+  /** \brief processes the acknowledgement of a special interest for one prefix
+   *  \param seqNo sequence number of the acknowledged update, or NO_SEQUENCE_NUMBER
+   */
+  void
+  processSpecialInterestAck(Face& inFace, const Name& prefix, uint64_t seqNo, bool isUpdateAck);
+
+  /** \brief sequence number of an acknowledgement that does not carry one
+   */
+  static const uint64_t NO_SEQUENCE_NUMBER = std::numeric_limits<uint64_t>::max();
+
+  /** \brief adds \p prefix to the batch of face \p faceId and schedules its transmission
+   */
+  void
+  enqueueBatchedUpdate(const Name& prefix, weak_ptr<fib::Entry> wpFibEntry, FaceId faceId, bool is_first);
+
+  void
+  removeBatchedUpdate(FaceId faceId, const Name& prefix);
+
+  /** \brief sends all prefixes pending on face \p faceId and rearms the retransmission timer
+   */
+  void
+  sendBatchedUpdates(FaceId faceId);
+
 protected:
   static const time::nanoseconds IU_retransmissionTime;
 
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 
+  // allow Forwarder to enter the pipelines of this class with static dispatch
+  friend class Forwarder;
+
 protected:
 
   uint64_t m_Tu;
   uint64_t m_retx;
 
+private:
+  struct BatchedPrefix
+  {
+    weak_ptr<fib::Entry> fibEntry;
+    bool is_first;
+  };
+
+  /* Prefixes awaiting an acknowledgement on one face, in batched mode */
+  struct PendingBatch
+  {
+    PendingBatch()
+      : num_retx(0)
+      , isSendScheduled(false)
+    {
+    }
+
+    std::map<Name, BatchedPrefix> prefixes;
+    scheduler::EventId timer; // transmission or retransmission
+    uint32_t num_retx;
+    bool isSendScheduled;
+  };
+
+  bool m_isBatched;
+  std::map<FaceId, PendingBatch> m_pendingBatches;
+
 #ifdef NDNSIM
 public:
 
@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forwarder-profiler.hpp"
+
+namespace nfd {
+
+const char*
+getPipelineStageName(PipelineStage stage)
+{
+  switch (stage) {
+  case STAGE_INCOMING_INTEREST:
+    return "IncomingInterest";
+  case STAGE_PIT_INSERT:
+    return "PitInsert";
+  case STAGE_DUPLICATE_NONCE:
+    return "DuplicateNonce";
+  case STAGE_CS_LOOKUP:
+    return "CsLookup";
+  case STAGE_CONTENT_STORE_MISS:
+    return "ContentStoreMiss";
+  case STAGE_STRATEGY:
+    return "Strategy";
+  case STAGE_OUTGOING_INTEREST:
+    return "OutgoingInterest";
+  case STAGE_INCOMING_DATA:
+    return "IncomingData";
+  case STAGE_PIT_MATCH:
+    return "PitMatch";
+  case STAGE_CS_INSERT:
+    return "CsInsert";
+  case STAGE_OUTGOING_DATA:
+    return "OutgoingData";
+  default:
+    BOOST_ASSERT(false);
+    return "";
+  }
+}
+
+} // namespace nfd
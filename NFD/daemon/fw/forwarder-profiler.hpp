@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
+#define NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
+
+#include "common.hpp"
+
+#include <array>
+#include <chrono>
+
+namespace nfd {
+
+/** \brief stages of the forwarding pipelines measured by ForwarderProfiler
+ *
+ *  Stages nest: a stage includes the stages entered while it runs, e.g. STAGE_STRATEGY
+ *  includes the STAGE_OUTGOING_INTEREST of the Interests sent by the strategy.
+ */
+enum PipelineStage {
+  STAGE_INCOMING_INTEREST,  ///< incoming Interest pipeline
+  STAGE_PIT_INSERT,         ///< PIT insert of an incoming Interest
+  STAGE_DUPLICATE_NONCE,    ///< duplicate Nonce detection in PIT and Dead Nonce List
+  STAGE_CS_LOOKUP,          ///< Content Store lookup (includes the hit and miss pipelines
+                            ///< with the NFD Content Store, which calls them back)
+  STAGE_CONTENT_STORE_MISS, ///< Content Store miss pipeline
+  STAGE_STRATEGY,           ///< strategy triggers
+  STAGE_OUTGOING_INTEREST,  ///< outgoing Interest pipeline, including face encoding
+  STAGE_INCOMING_DATA,      ///< incoming Data pipeline
+  STAGE_PIT_MATCH,          ///< PIT match of an incoming Data
+  STAGE_CS_INSERT,          ///< Content Store insert
+  STAGE_OUTGOING_DATA,      ///< outgoing Data pipeline, including face encoding
+  N_PIPELINE_STAGES
+};
+
+/** \return name of \p stage, as printed by tracers
+ */
+const char*
+getPipelineStageName(PipelineStage stage);
+
+/** \brief per-stage call and cycle counters of a forwarder
+ *
+ *  The counters are only updated when the PIPELINE_PROFILING compilation flag is set, and
+ *  stay at zero otherwise.  Cycles are read from the CPU
+ *  timestamp counter on x86, and are nanoseconds of steady clock on other architectures.
+ *  The counters are cumulative, readers compute differences between samples.
+ */
+class ForwarderProfiler : noncopyable
+{
+public:
+  struct StageCounters
+  {
+    uint64_t nCalls;
+    uint64_t nCycles;
+  };
+
+  ForwarderProfiler()
+  {
+    reset();
+  }
+
+  const StageCounters&
+  get(PipelineStage stage) const
+  {
+    return m_stages[stage];
+  }
+
+  void
+  record(PipelineStage stage, uint64_t nCycles)
+  {
+    ++m_stages[stage].nCalls;
+    m_stages[stage].nCycles += nCycles;
+  }
+
+  void
+  reset()
+  {
+    m_stages.fill(StageCounters{0, 0});
+  }
+
+  static uint64_t
+  now()
+  {
+#if defined(__i386__) || defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+  }
+
+private:
+  std::array<StageCounters, N_PIPELINE_STAGES> m_stages;
+};
+
+/** \brief records the cycles between its construction and its destruction as one call
+ *         of a stage
+ */
+class ScopedStageTimer : noncopyable
+{
+public:
+  ScopedStageTimer(ForwarderProfiler& profiler, PipelineStage stage)
+    : m_profiler(profiler)
+    , m_stage(stage)
+    , m_start(ForwarderProfiler::now())
+  {
+  }
+
+  ~ScopedStageTimer()
+  {
+    m_profiler.record(m_stage, ForwarderProfiler::now() - m_start);
+  }
+
+private:
+  ForwarderProfiler& m_profiler;
+  PipelineStage m_stage;
+  uint64_t m_start;
+};
+
+} // namespace nfd
+
+#ifdef PIPELINE_PROFILING
+
+#define NFD_PROFILE_CONCAT2(a, b) a##b
+#define NFD_PROFILE_CONCAT(a, b) NFD_PROFILE_CONCAT2(a, b)
+
+/** \brief measure the rest of the enclosing scope as \p stage of m_profiler
+ */
+#define NFD_PROFILE_STAGE(stage) \
+  ::nfd::ScopedStageTimer NFD_PROFILE_CONCAT(nfdStageTimer, __LINE__)(m_profiler, stage)
+
+#else
+
+#define NFD_PROFILE_STAGE(stage)
+
+#endif // PIPELINE_PROFILING
+
+#endif // NFD_DAEMON_FW_FORWARDER_PROFILER_HPP
@@ -28,6 +28,13 @@
 #include "core/random.hpp"
 #include "strategy.hpp"
 
+#ifdef MAPME
+#include "forwarder-mapme.hpp"
+#endif // MAPME
+#ifdef KITE
+#include "forwarder-kite.hpp"
+#endif // KITE
+
 #ifdef NDNSIM
 #include "face/null-face.hpp"
 #include "utils/ndn-ns3-packet-tag.hpp"
@@ -55,6 +62,7 @@ Forwarder::Forwarder()
 {
   fw::installStrategies(*this);
 #ifdef NDNSIM
+  this->setPipelines<Forwarder>();
   getFaceTable().addReserved(m_csFace, FACEID_CONTENT_STORE);
 #endif // NDNSIM
 }
@@ -64,6 +72,16 @@ Forwarder::~Forwarder()
 
 }
 
+#ifdef MLDR
+void
+Forwarder::enableMldr()
+{
+  if (m_mldr == nullptr) {
+    m_mldr.reset(new MldrMechanism(*this));
+  }
+}
+#endif // MLDR
+
 #ifndef NDNSIM
 void
 Forwarder::startProcessInterest(Face& face, const Interest& interest)
@@ -116,11 +134,29 @@ Forwarder::startProcessNack(Face& face, const lp::Nack& nack)
 void
 Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 {
+  this->processIncomingInterest<Forwarder>(inFace, interest);
+}
+
+template<class ForwarderT>
+void
+Forwarder::processIncomingInterest(Face& inFace, const Interest& interest)
+{
+  ForwarderT& self = static_cast<ForwarderT&>(*this);
+  NFD_PROFILE_STAGE(STAGE_INCOMING_INTEREST);
+
   // receive Interest
   NFD_LOG_DEBUG("onIncomingInterest face=" << inFace.getId() <<
                 " interest=" << interest.getName());
   const_cast<Interest&>(interest).setIncomingFaceId(inFace.getId());
   ++m_counters.getNInInterests();
+
+#ifdef MLDR
+  // MLDR notification from a downstream node which reassociated
+  if (m_mldr != nullptr && MldrMechanism::isNotification(interest)) {
+    m_mldr->onNotification(inFace, interest);
+    return;
+  }
+#endif // MLDR
   
   // /localhost scope control
   bool isViolatingLocalhost = !inFace.isLocal() &&
@@ -134,12 +170,20 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
  
 
   // PIT insert
-  shared_ptr<pit::Entry> pitEntry = m_pit.insert(interest).first;
+  shared_ptr<pit::Entry> pitEntry;
+  {
+    NFD_PROFILE_STAGE(STAGE_PIT_INSERT);
+    pitEntry = m_pit.insert(interest).first;
+  }
 
   // detect duplicate Nonce
-  int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
-  bool hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
-                           m_deadNonceList.has(interest.getName(), interest.getNonce());
+  bool hasDuplicateNonce = false;
+  {
+    NFD_PROFILE_STAGE(STAGE_DUPLICATE_NONCE);
+    int dnw = pitEntry->findNonce(interest.getNonce(), inFace);
+    hasDuplicateNonce = (dnw != pit::DUPLICATE_NONCE_NONE) ||
+                        m_deadNonceList.has(pitEntry->getNameHash(), interest.getNonce());
+  }
   if (hasDuplicateNonce) {
     // goto Interest loop pipeline
     this->onInterestLoop(inFace, interest, pitEntry);
@@ -156,32 +200,63 @@ Forwarder::onIncomingInterest(Face& inFace, const Interest& interest)
 #ifdef NDNSIM
     if (m_csFromNdnSim == nullptr) {
 #endif // NDNSIM
+      // the hit and miss pipelines are called back by Cs::find, and are part of this stage
+      NFD_PROFILE_STAGE(STAGE_CS_LOOKUP);
       m_cs.find(interest,
                 bind(&Forwarder::onContentStoreHit, this, ref(inFace), pitEntry, _1, _2),
-                bind(&Forwarder::onContentStoreMiss, this, ref(inFace), pitEntry, _1));
+                [&self, &inFace, pitEntry] (const Interest& missedInterest) {
+                  self.ForwarderT::onContentStoreMiss(inFace, pitEntry, missedInterest);
+                });
 #ifdef NDNSIM
     }
     else {
-      shared_ptr<Data> match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      shared_ptr<const Data> match;
+      {
+        NFD_PROFILE_STAGE(STAGE_CS_LOOKUP);
+        match = m_csFromNdnSim->Lookup(interest.shared_from_this());
+      }
       if (match != nullptr) {
+        // The cached Data is shared with the content store and is not copied on a hit.
+        // Data added to the store by other means than the forwarder, and Data that
+        // onContentStoreHit would modify, are copied instead (cheap, the copy shares the wire
+        // encoding)
+        if (match->getIncomingFaceId() != FACEID_CONTENT_STORE
+#ifdef PATH_LABELLING
+            || !match->isPathIdEmpty()
+#endif // PATH_LABELLING
+            ) {
+          shared_ptr<Data> copy = make_shared<Data>(*match);
+          copy->setIncomingFaceId(FACEID_CONTENT_STORE);
+          match = copy;
+        }
         this->onContentStoreHit(inFace, pitEntry, interest, *match);
       }
       else {
-        this->onContentStoreMiss(inFace, pitEntry, interest);
+        self.ForwarderT::onContentStoreMiss(inFace, pitEntry, interest);
       }
     }
 #endif // NDNSIM
   }
   else {
-    this->onContentStoreMiss(inFace, pitEntry, interest);
+    self.ForwarderT::onContentStoreMiss(inFace, pitEntry, interest);
   }
 }
 
+#ifdef MAPME
+template void
+Forwarder::processIncomingInterest<ForwarderMapMe>(Face& inFace, const Interest& interest);
+#endif // MAPME
+#ifdef KITE
+template void
+Forwarder::processIncomingInterest<ForwarderKite>(Face& inFace, const Interest& interest);
+#endif // KITE
+
 void
 Forwarder::onContentStoreMiss(const Face& inFace,
                               shared_ptr<pit::Entry> pitEntry,
                               const Interest& interest)
 {
+  NFD_PROFILE_STAGE(STAGE_CONTENT_STORE_MISS);
   NFD_LOG_DEBUG("onContentStoreMiss interest=" << interest.getName());
   
   shared_ptr<Face> face = const_pointer_cast<Face>(inFace.shared_from_this());
@@ -265,7 +340,9 @@ Forwarder::onContentStoreHit(const Face& inFace,
                                           pitEntry, cref(*m_csFace), cref(data)));
 #endif // NDNSIM
 
+#ifndef NDNSIM
   const_pointer_cast<Data>(data.shared_from_this())->setIncomingFaceId(FACEID_CONTENT_STORE);
+#endif // NDNSIM
   // XXX should we lookup PIT for other Interests that also match csMatch?
 
   // set PIT straggler timer
@@ -344,6 +421,7 @@ void
 Forwarder::onOutgoingInterest(shared_ptr<pit::Entry> pitEntry, Face& outFace,
                               bool wantNewNonce)
 {  
+  NFD_PROFILE_STAGE(STAGE_OUTGOING_INTEREST);
   if (outFace.getId() == INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingInterest face=invalid interest=" << pitEntry->getName());
     return;
@@ -433,6 +511,8 @@ Forwarder::onInterestFinalize(shared_ptr<pit::Entry> pitEntry, bool isSatisfied,
 void
 Forwarder::onIncomingData(Face& inFace, const Data& data)
 {
+  NFD_PROFILE_STAGE(STAGE_INCOMING_DATA);
+
   // receive Data
   NFD_LOG_DEBUG("onIncomingData face=" << inFace.getId() << " data=" << data.getName());
   const_cast<Data&>(data).setIncomingFaceId(inFace.getId());
@@ -449,7 +529,11 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   }
 
   // PIT match
-  pit::DataMatchResult pitMatches = m_pit.findAllDataMatches(data);
+  pit::DataMatchResult pitMatches;
+  {
+    NFD_PROFILE_STAGE(STAGE_PIT_MATCH);
+    pitMatches = m_pit.findAllDataMatches(data);
+  }
   if (pitMatches.begin() == pitMatches.end()) {
     // goto Data unsolicited pipeline
     this->onDataUnsolicited(inFace, data);
@@ -466,15 +550,24 @@ Forwarder::onIncomingData(Face& inFace, const Data& data)
   // pointing to the same underlying memory buffer.
   shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
   dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+  // content stores return the cached object on a hit, mark it once here so that hits do not
+  // need to modify it
+  dataCopyWithoutPacket->setIncomingFaceId(FACEID_CONTENT_STORE);
 
   // CS insert
-  if (m_csFromNdnSim == nullptr)
-    m_cs.insert(*dataCopyWithoutPacket);
-  else
-    m_csFromNdnSim->Add(dataCopyWithoutPacket);
+  {
+    NFD_PROFILE_STAGE(STAGE_CS_INSERT);
+    if (m_csFromNdnSim == nullptr)
+      m_cs.insert(*dataCopyWithoutPacket);
+    else
+      m_csFromNdnSim->Add(dataCopyWithoutPacket);
+  }
 #else
   // CS insert
-  m_cs.insert(data);
+  {
+    NFD_PROFILE_STAGE(STAGE_CS_INSERT);
+    m_cs.insert(data);
+  }
 #endif // NDNSIM
 
 #ifdef NDNSIM
@@ -566,14 +659,21 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
   // accept to cache?
   bool acceptToCache = inFace.isLocal();
   if (acceptToCache) {
-    // CS insert
 #ifdef NDNSIM
+    // as in onIncomingData, cache a copy without the ns-3 packet and marked as coming from
+    // the content store
+    shared_ptr<Data> dataCopyWithoutPacket = make_shared<Data>(data);
+    dataCopyWithoutPacket->removeTag<ns3::ndn::Ns3PacketTag>();
+    dataCopyWithoutPacket->setIncomingFaceId(FACEID_CONTENT_STORE);
+
+    // CS insert
     if (m_csFromNdnSim == nullptr)
-#endif // NDNSIM
-      m_cs.insert(data, true);
-#ifdef NDNSIM
+      m_cs.insert(*dataCopyWithoutPacket, true);
     else
-      m_csFromNdnSim->Add(data.shared_from_this());
+      m_csFromNdnSim->Add(dataCopyWithoutPacket);
+#else
+    // CS insert
+    m_cs.insert(data, true);
 #endif // NDNSIM
   }
 
@@ -585,6 +685,7 @@ Forwarder::onDataUnsolicited(Face& inFace, const Data& data)
 void
 Forwarder::onOutgoingData(const Data& data, Face& outFace)
 {
+  NFD_PROFILE_STAGE(STAGE_OUTGOING_DATA);
   if (outFace.getId() == INVALID_FACEID) {
     NFD_LOG_WARN("onOutgoingData face=invalid data=" << data.getName());
     return;
@@ -766,7 +867,7 @@ static inline void
 insertNonceToDnl(DeadNonceList& dnl, const pit::Entry& pitEntry,
                  const pit::OutRecord& outRecord)
 {
-  dnl.add(pitEntry.getName(), outRecord.getLastNonce());
+  dnl.add(pitEntry.getNameHash(), outRecord.getLastNonce());
 }
 
 void
@@ -801,7 +902,7 @@ Forwarder::insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
     // insert outgoing Nonce of a specific face
     pit::OutRecordCollection::const_iterator outRecord = pitEntry.getOutRecord(*upstream);
     if (outRecord != pitEntry.getOutRecords().end()) {
-      m_deadNonceList.add(pitEntry.getName(), outRecord->getLastNonce());
+      m_deadNonceList.add(pitEntry.getNameHash(), outRecord->getLastNonce());
     }
   }
 }
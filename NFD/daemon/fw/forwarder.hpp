@@ -32,6 +32,7 @@
 #endif // CONF_FILE
 #include "core/scheduler.hpp"
 #include "forwarder-counters.hpp"
+#include "forwarder-profiler.hpp"
 #include "face-table.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
@@ -46,6 +47,9 @@
 #ifdef NDNSIM
 #include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
 #endif // NDNSIM
+#ifdef MLDR
+#include "mldr-mechanism.hpp"
+#endif // MLDR
 
 
 namespace nfd {
@@ -78,6 +82,13 @@ public:
   const ForwarderCounters&
   getCounters() const;
 
+  /** \brief per-stage call and cycle counters of the pipelines
+   *
+   *  The counters stay at zero unless PIPELINE_PROFILING is set.
+   */
+  const ForwarderProfiler&
+  getProfiler() const;
+
 public: // faces
   FaceTable&
   getFaceTable();
@@ -151,6 +162,41 @@ public: // forwarding entrypoints and tables
   getNetworkRegionTable();
 #endif // !NDNSIM
 
+public: // L2 mobility events
+  /** \brief report that the link of \p face has been (re)associated to an access point
+   */
+  void
+  notifyFaceAssociated(shared_ptr<Face> face);
+
+  /** \brief report that the link of \p face has been disassociated from its access point
+   */
+  void
+  notifyFaceDisassociated(shared_ptr<Face> face);
+
+  /** \brief trigger after the link of a face is (re)associated to an access point
+   *  \sa WifiReassociationProcedure
+   */
+  signal::Signal<Forwarder, shared_ptr<Face>> afterFaceAssociated;
+
+  /** \brief trigger after the link of a face is disassociated from its access point
+   *  \sa WifiReassociationProcedure
+   */
+  signal::Signal<Forwarder, shared_ptr<Face>> afterFaceDisassociated;
+
+#ifdef MLDR
+public: // mobility-triggered loss recovery
+  /** \brief enable MLDR, L2 association events must then be reported to getMldr(),
+   *         which WifiReassociationProcedure does
+   */
+  void
+  enableMldr();
+
+  /** \return MLDR mechanism, or nullptr if MLDR is not enabled
+   */
+  MldrMechanism*
+  getMldr();
+#endif // MLDR
+
 #ifdef NDNSIM
 public: // allow enabling ndnSIM content store (will be removed in the future)
   void
@@ -317,12 +363,51 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
   dispatchToStrategy(shared_ptr<pit::Entry> pitEntry, Function trigger);
 #endif
 
+protected: // static dispatch of the pipelines
+  /** \brief incoming Interest pipeline, continued with the Content Store miss pipeline
+   *         of \p ForwarderT
+   *
+   *  The Content Store miss pipeline is called with a qualified name, and is not dispatched
+   *  through the vtable. Mobility forwarders overriding onIncomingInterest call this instead
+   *  of Forwarder::onIncomingInterest to resume the normal processing.
+   *  It is explicitly instantiated in forwarder.cpp for each forwarder.
+   */
+  template<class ForwarderT>
+  void
+  processIncomingInterest(Face& inFace, const Interest& interest);
+
+#ifdef NDNSIM
+  /** \brief make faces enter the pipelines of \p ForwarderT
+   *
+   *  The receive signals of the faces added afterwards call ForwarderT::onIncomingInterest
+   *  and ForwarderT::onIncomingData with qualified names, so the entry into the pipelines is
+   *  not looked up in the vtable.  Only these entry points, and the Content Store miss
+   *  pipeline called by processIncomingInterest, are dispatched statically: the pipelines
+   *  entered by strategies (e.g. onOutgoingInterest, overridden by ForwarderAnchor) are
+   *  reached through Forwarder& and remain virtual calls.
+   *  Must be called by the constructor of \p ForwarderT, before any face is added.
+   */
+  template<class ForwarderT>
+  void
+  setPipelines();
+
+private:
+  typedef void (*FaceConnector)(Forwarder& forwarder, Face& face);
+
+  /** \brief connect the receive signals of \p face to the pipelines of \p ForwarderT
+   */
+  template<class ForwarderT>
+  static void
+  connectFace(Forwarder& forwarder, Face& face);
+#endif // NDNSIM
+
 #ifdef MAPME
 protected:
 #else
 private:
 #endif
   ForwarderCounters m_counters;
+  ForwarderProfiler m_profiler;
 
   FaceTable m_faceTable;
 
@@ -339,6 +424,12 @@ private:
 #ifdef NDNSIM
   shared_ptr<NullFace> m_csFace;
   ns3::Ptr<ns3::ndn::ContentStore> m_csFromNdnSim;
+
+  // connects new faces to the pipelines, see setPipelines
+  FaceConnector m_connectFace;
+
+  // allow FaceTable to connect faces to the pipelines
+  friend class FaceTable;
 #else
   NetworkRegionTable m_networkRegionTable;
 #endif // NDNSIM
@@ -348,6 +439,13 @@ private:
   // allow Strategy (base class) to enter pipelines
   friend class fw::Strategy;
 
+#ifdef MLDR
+  unique_ptr<MldrMechanism> m_mldr;
+
+  // allow MLDR to re-express pending Interests
+  friend class MldrMechanism;
+#endif // MLDR
+
 #ifdef MAPME
 public:
   bool m_removeFibEntries = true;
@@ -361,6 +459,12 @@ Forwarder::getCounters() const
   return m_counters;
 }
 
+inline const ForwarderProfiler&
+Forwarder::getProfiler() const
+{
+  return m_profiler;
+}
+
 inline FaceTable&
 Forwarder::getFaceTable()
 {
@@ -391,6 +495,27 @@ Forwarder::onData(Face& face, const Data& data)
 {
   this->onIncomingData(face, data);
 }
+
+template<class ForwarderT>
+inline void
+Forwarder::setPipelines()
+{
+  BOOST_ASSERT(dynamic_cast<ForwarderT*>(this) != nullptr);
+  m_connectFace = &Forwarder::connectFace<ForwarderT>;
+}
+
+template<class ForwarderT>
+inline void
+Forwarder::connectFace(Forwarder& forwarder, Face& face)
+{
+  ForwarderT& self = static_cast<ForwarderT&>(forwarder);
+  face.onReceiveInterest.connect([&self, &face] (const Interest& interest) {
+    self.ForwarderT::onIncomingInterest(face, interest);
+  });
+  face.onReceiveData.connect([&self, &face] (const Data& data) {
+    self.ForwarderT::onIncomingData(face, data);
+  });
+}
 #endif // NDNSIM
 
 inline NameTree&
@@ -443,6 +568,26 @@ Forwarder::getNetworkRegionTable()
 }
 #endif // !NDNSIM
 
+inline void
+Forwarder::notifyFaceAssociated(shared_ptr<Face> face)
+{
+  this->afterFaceAssociated(face);
+}
+
+inline void
+Forwarder::notifyFaceDisassociated(shared_ptr<Face> face)
+{
+  this->afterFaceDisassociated(face);
+}
+
+#ifdef MLDR
+inline MldrMechanism*
+Forwarder::getMldr()
+{
+  return m_mldr.get();
+}
+#endif // MLDR
+
 #ifdef NDNSIM
 inline void
 Forwarder::setCsFromNdnSim(ns3::Ptr<ns3::ndn::ContentStore> cs)
@@ -460,6 +605,7 @@ inline void
 Forwarder::dispatchToStrategy(shared_ptr<pit::Entry> pitEntry, Function trigger)
 #endif
 {
+  NFD_PROFILE_STAGE(STAGE_STRATEGY);
   fw::Strategy& strategy = m_strategyChoice.findEffectiveStrategy(*pitEntry);
   trigger(&strategy);
 }
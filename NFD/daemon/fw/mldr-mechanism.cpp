@@ -0,0 +1,165 @@
+/*
+ *  Copyright (c) 2015,  Cisco Systems Inc.
+ *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
+ */
+
+#ifdef MLDR
+
+#include "mldr-mechanism.hpp"
+#include "forwarder.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+
+NFD_LOG_INIT("MldrMechanism");
+
+static const Name MLDR_NOTIFICATION_NAME(MLDR_NOTIFICATION_PREFIX);
+static const Name LOCALHOP_NAME("/localhop");
+
+MldrMechanism::MldrMechanism(Forwarder& forwarder)
+  : m_forwarder(forwarder)
+  , m_nRetransmissions(0)
+  , m_nOutNotifications(0)
+  , m_nInNotifications(0)
+{
+}
+
+void
+MldrMechanism::onDisassociation(Face& face)
+{
+  NFD_LOG_DEBUG("onDisassociation face=" << face.getId());
+  m_detachedFaces.insert(face.getId());
+}
+
+void
+MldrMechanism::onAssociation(Face& face)
+{
+  NFD_LOG_DEBUG("onAssociation face=" << face.getId());
+
+  // first association, nothing can have been lost
+  if (m_detachedFaces.empty())
+    return;
+
+  std::set<FaceId> detachedFaces;
+  detachedFaces.swap(m_detachedFaces);
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  size_t nRetransmissions = retransmit(face, [&] (const pit::Entry& entry) {
+      const pit::OutRecordCollection& outRecords = entry.getOutRecords();
+      return std::any_of(outRecords.begin(), outRecords.end(),
+        [&] (const pit::OutRecord& outRecord) {
+          return outRecord.getExpiry() >= now &&
+                 detachedFaces.count(outRecord.getFace()->getId()) > 0;
+        });
+    });
+  NFD_LOG_INFO("onAssociation face=" << face.getId() << " retransmitted=" << nRetransmissions);
+
+  sendNotification(face);
+}
+
+bool
+MldrMechanism::isNotification(const Interest& interest)
+{
+  return MLDR_NOTIFICATION_NAME.isPrefixOf(interest.getName());
+}
+
+void
+MldrMechanism::onNotification(Face& inFace, const Interest& interest)
+{
+  ++m_nInNotifications;
+
+  const Name& name = interest.getName();
+  std::vector<Name> prefixes;
+  try {
+    for (size_t i = MLDR_NOTIFICATION_NAME.size(); i < name.size(); ++i) {
+      prefixes.emplace_back(name[i].blockFromValue());
+    }
+  }
+  catch (const tlv::Error&) {
+    NFD_LOG_DEBUG("onNotification face=" << inFace.getId() << " malformed");
+    return;
+  }
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  size_t nRetransmissions = retransmit(inFace, [&] (const pit::Entry& entry) {
+      bool isNotified = std::any_of(prefixes.begin(), prefixes.end(),
+        [&entry] (const Name& prefix) { return prefix.isPrefixOf(entry.getName()); });
+      if (!isNotified)
+        return false;
+
+      const pit::OutRecordCollection& outRecords = entry.getOutRecords();
+      return std::any_of(outRecords.begin(), outRecords.end(),
+        [&now] (const pit::OutRecord& outRecord) { return outRecord.getExpiry() >= now; });
+    });
+  NFD_LOG_INFO("onNotification face=" << inFace.getId() << " prefixes=" << prefixes.size() <<
+               " retransmitted=" << nRetransmissions);
+}
+
+size_t
+MldrMechanism::retransmit(Face& outFace, function<bool(const pit::Entry&)> predicate)
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  // the outgoing Interest pipeline must not run while the PIT is being iterated
+  std::vector<shared_ptr<pit::Entry>> entries;
+  Pit& pit = m_forwarder.getPit();
+  for (Pit::const_iterator it = pit.begin(); it != pit.end(); ++it) {
+    const pit::InRecordCollection& inRecords = it->getInRecords();
+    bool hasDownstream = std::any_of(inRecords.begin(), inRecords.end(),
+      [&outFace, &now] (const pit::InRecord& inRecord) {
+        return inRecord.getFace().get() != &outFace && inRecord.getExpiry() >= now;
+      });
+
+    if (hasDownstream && !it->violatesScope(outFace) && predicate(*it)) {
+      entries.push_back(it.operator->());
+    }
+  }
+
+  // a new Nonce is needed: the previous one may have reached upstream nodes
+  for (const shared_ptr<pit::Entry>& entry : entries) {
+    m_forwarder.onOutgoingInterest(entry, outFace, true);
+  }
+
+  m_nRetransmissions += entries.size();
+  return entries.size();
+}
+
+void
+MldrMechanism::sendNotification(Face& outFace)
+{
+  Name name(MLDR_NOTIFICATION_NAME);
+  size_t nPrefixes = 0;
+
+  Fib& fib = m_forwarder.getFib();
+  for (Fib::const_iterator it = fib.begin(); it != fib.end(); ++it) {
+    const Name& prefix = it->getPrefix();
+    if (Forwarder::LOCALHOST_NAME.isPrefixOf(prefix) || LOCALHOP_NAME.isPrefixOf(prefix))
+      continue;
+
+    const fib::NextHopList& nextHops = it->getNextHops();
+    bool isServedLocally = std::any_of(nextHops.begin(), nextHops.end(),
+      [] (const fib::NextHop& nextHop) { return nextHop.getFace()->isLocal(); });
+    if (!isServedLocally)
+      continue;
+
+    name.append(prefix.wireEncode());
+    if (++nPrefixes == MLDR_NOTIFICATION_MAX_PREFIXES) {
+      NFD_LOG_DEBUG("sendNotification face=" << outFace.getId() << " prefixes=" << nPrefixes);
+      outFace.sendInterest(Interest(name));
+      ++m_nOutNotifications;
+
+      name = MLDR_NOTIFICATION_NAME;
+      nPrefixes = 0;
+    }
+  }
+
+  if (nPrefixes > 0) {
+    NFD_LOG_DEBUG("sendNotification face=" << outFace.getId() << " prefixes=" << nPrefixes);
+    outFace.sendInterest(Interest(name));
+    ++m_nOutNotifications;
+  }
+}
+
+} // namespace nfd
+
+#endif // MLDR
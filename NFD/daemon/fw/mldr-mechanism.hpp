@@ -2,3 +2,115 @@
  *  Copyright (c) 2015,  Cisco Systems Inc.
  *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
  */
+
+#ifndef NFD_DAEMON_FW_MLDR_MECHANISM_HPP
+#define NFD_DAEMON_FW_MLDR_MECHANISM_HPP
+
+#ifdef MLDR
+
+#include "common.hpp"
+#include "face/face.hpp"
+#include "table/pit-entry.hpp"
+
+/* Notification sent upstream after a reassociation: the name carries, after
+ * this prefix, one component per prefix served by the moving node */
+#define MLDR_NOTIFICATION_PREFIX "/localhop/mldr"
+#define MLDR_NOTIFICATION_MAX_PREFIXES 32
+
+namespace nfd {
+
+class Forwarder;
+
+/** \brief Mobility-triggered Loss Detection and Recovery (MLDR)
+ *
+ *  When a node hands over, Interests forwarded on the old access link and Data
+ *  coming back on it are lost, and are only recovered after the consumer RTO.
+ *  MLDR reacts to the L2 events of the moving node instead:
+ *
+ *  - on disassociation, the face is marked as detached;
+ *  - on (re)association, every pending Interest with an unexpired out-record on
+ *    a detached face is immediately re-expressed, with a new Nonce, on the face
+ *    of the new access link;
+ *  - the upstream node is then notified of the prefixes served by the moving
+ *    node (FIB entries with a local next hop), and re-expresses its own pending
+ *    Interests for those prefixes toward the notifying face.
+ *
+ *  MLDR only recovers packets in flight: updating the FIB to follow a moving
+ *  producer is left to the mobility scheme. Notified upstream nodes re-express
+ *  all their pending Interests under the prefixes, so a few Interests that were
+ *  not lost may be sent twice.
+ */
+class MldrMechanism : noncopyable
+{
+public:
+  explicit
+  MldrMechanism(Forwarder& forwarder);
+
+  /** \brief L2 disassociation of the access link of \p face
+   */
+  void
+  onDisassociation(Face& face);
+
+  /** \brief L2 (re)association of the access link of \p face
+   *
+   *  \p face may be the face which was disassociated, when the new access point
+   *  is reached through the same device.
+   */
+  void
+  onAssociation(Face& face);
+
+  /** \return whether \p interest is an MLDR notification
+   */
+  static bool
+  isNotification(const Interest& interest);
+
+  /** \brief process a notification from a downstream node which reassociated on \p inFace
+   */
+  void
+  onNotification(Face& inFace, const Interest& interest);
+
+public: // counters
+  /** \brief number of Interests re-expressed after a reassociation or a notification
+   */
+  uint64_t
+  getNRetransmissions() const
+  {
+    return m_nRetransmissions;
+  }
+
+  uint64_t
+  getNOutNotifications() const
+  {
+    return m_nOutNotifications;
+  }
+
+  uint64_t
+  getNInNotifications() const
+  {
+    return m_nInNotifications;
+  }
+
+private:
+  /** \brief re-express on \p outFace the pending Interests matching \p predicate
+   *  \return number of re-expressed Interests
+   */
+  size_t
+  retransmit(Face& outFace, function<bool(const pit::Entry&)> predicate);
+
+  void
+  sendNotification(Face& outFace);
+
+private:
+  Forwarder& m_forwarder;
+  std::set<FaceId> m_detachedFaces;
+
+  uint64_t m_nRetransmissions;
+  uint64_t m_nOutNotifications;
+  uint64_t m_nInNotifications;
+};
+
+} // namespace nfd
+
+#endif // MLDR
+
+#endif // NFD_DAEMON_FW_MLDR_MECHANISM_HPP
@@ -2,3 +2,71 @@
  *  Copyright (c) 2015,  Cisco Systems Inc.
  *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
  */
+
+#ifdef NDNSIM
+
+#include "ns3-reassociation-procedure.hpp"
+#include "forwarder.hpp"
+#include "core/logger.hpp"
+
+#include "ns3/callback.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/sta-wifi-mac.h"
+
+namespace nfd {
+
+NFD_LOG_INIT("Ns3ReassociationProcedure");
+
+Ns3ReassociationProcedure::Ns3ReassociationProcedure(Forwarder& forwarder)
+  : WifiReassociationProcedure(forwarder)
+{
+}
+
+bool
+Ns3ReassociationProcedure::install(shared_ptr<Face> face, ns3::Ptr<ns3::NetDevice> device)
+{
+  ns3::Ptr<ns3::WifiNetDevice> wifiDevice = ns3::DynamicCast<ns3::WifiNetDevice>(device);
+  if (wifiDevice == nullptr)
+    return false;
+
+  ns3::Ptr<ns3::StaWifiMac> mac = ns3::DynamicCast<ns3::StaWifiMac>(wifiDevice->GetMac());
+  if (mac == nullptr)
+    return false;
+
+  // the face is looked up at each event, in case it has been removed meanwhile
+  mac->TraceConnectWithoutContext("Assoc",
+    ns3::MakeBoundCallback(&Ns3ReassociationProcedure::onAssoc, this, face->getId()));
+  mac->TraceConnectWithoutContext("DeAssoc",
+    ns3::MakeBoundCallback(&Ns3ReassociationProcedure::onDeAssoc, this, face->getId()));
+
+  NFD_LOG_DEBUG("install face=" << face->getId());
+  return true;
+}
+
+void
+Ns3ReassociationProcedure::onAssoc(Ns3ReassociationProcedure* self, FaceId faceId,
+                                   ns3::Mac48Address bssid)
+{
+  shared_ptr<Face> face = self->m_forwarder.getFace(faceId);
+  if (face == nullptr)
+    return;
+
+  NFD_LOG_DEBUG("Assoc face=" << faceId << " bssid=" << bssid);
+  self->onAssociation(face);
+}
+
+void
+Ns3ReassociationProcedure::onDeAssoc(Ns3ReassociationProcedure* self, FaceId faceId,
+                                     ns3::Mac48Address bssid)
+{
+  shared_ptr<Face> face = self->m_forwarder.getFace(faceId);
+  if (face == nullptr)
+    return;
+
+  NFD_LOG_DEBUG("DeAssoc face=" << faceId << " bssid=" << bssid);
+  self->onDisassociation(face);
+}
+
+} // namespace nfd
+
+#endif // NDNSIM
@@ -2,3 +2,49 @@
  *  Copyright (c) 2015,  Cisco Systems Inc.
  *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
  */
+
+#ifndef NFD_DAEMON_FW_NS3_REASSOCIATION_PROCEDURE_HPP
+#define NFD_DAEMON_FW_NS3_REASSOCIATION_PROCEDURE_HPP
+
+#ifdef NDNSIM
+
+#include "wifi-reassociation-procedure.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/net-device.h"
+#include "ns3/mac48-address.h"
+
+namespace nfd {
+
+/** \brief reassociation procedure fed by the association traces of ns-3 wifi stations
+ *
+ *  The procedure subscribes to the Assoc and DeAssoc traces of the StaWifiMac of each
+ *  installed face, so that the forwarder reacts to a handover as soon as the station
+ *  changes access point.
+ */
+class Ns3ReassociationProcedure : public WifiReassociationProcedure
+{
+public:
+  explicit
+  Ns3ReassociationProcedure(Forwarder& forwarder);
+
+  /** \brief follow the association events of \p device, the NetDevice of \p face
+   *  \return false if \p device is not a wifi station (access points and ad hoc
+   *          stations have no association)
+   */
+  bool
+  install(shared_ptr<Face> face, ns3::Ptr<ns3::NetDevice> device);
+
+private:
+  static void
+  onAssoc(Ns3ReassociationProcedure* self, FaceId faceId, ns3::Mac48Address bssid);
+
+  static void
+  onDeAssoc(Ns3ReassociationProcedure* self, FaceId faceId, ns3::Mac48Address bssid);
+};
+
+} // namespace nfd
+
+#endif // NDNSIM
+
+#endif // NFD_DAEMON_FW_NS3_REASSOCIATION_PROCEDURE_HPP
@@ -2,3 +2,56 @@
  *  Copyright (c) 2015,  Cisco Systems Inc.
  *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
  */
+
+#include "wifi-reassociation-procedure.hpp"
+#include "forwarder.hpp"
+#include "core/logger.hpp"
+
+namespace nfd {
+
+NFD_LOG_INIT("WifiReassociationProcedure");
+
+WifiReassociationProcedure::WifiReassociationProcedure(Forwarder& forwarder)
+  : m_forwarder(forwarder)
+  , m_nAssociations(0)
+  , m_nDisassociations(0)
+{
+}
+
+WifiReassociationProcedure::~WifiReassociationProcedure()
+{
+}
+
+void
+WifiReassociationProcedure::onAssociation(shared_ptr<Face> face)
+{
+  NFD_LOG_INFO("onAssociation face=" << face->getId());
+  ++m_nAssociations;
+
+  face->setUp(true);
+  m_forwarder.notifyFaceAssociated(face);
+
+#ifdef MLDR
+  if (m_forwarder.getMldr() != nullptr) {
+    m_forwarder.getMldr()->onAssociation(*face);
+  }
+#endif // MLDR
+}
+
+void
+WifiReassociationProcedure::onDisassociation(shared_ptr<Face> face)
+{
+  NFD_LOG_INFO("onDisassociation face=" << face->getId());
+  ++m_nDisassociations;
+
+  face->setUp(false);
+  m_forwarder.notifyFaceDisassociated(face);
+
+#ifdef MLDR
+  if (m_forwarder.getMldr() != nullptr) {
+    m_forwarder.getMldr()->onDisassociation(*face);
+  }
+#endif // MLDR
+}
+
+} // namespace nfd
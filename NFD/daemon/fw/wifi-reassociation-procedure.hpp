@@ -2,3 +2,68 @@
  *  Copyright (c) 2015,  Cisco Systems Inc.
  *  Author: Natalya Rozhnova <natalya.rozhnova@cisco.com>
  */
+
+#ifndef NFD_DAEMON_FW_WIFI_REASSOCIATION_PROCEDURE_HPP
+#define NFD_DAEMON_FW_WIFI_REASSOCIATION_PROCEDURE_HPP
+
+#include "common.hpp"
+#include "face/face.hpp"
+
+namespace nfd {
+
+class Forwarder;
+
+/** \brief reaction of a forwarder to the L2 (re)association events of its wireless faces
+ *
+ *  On disassociation, the face is marked down, so that mobility schemes stop using it, and
+ *  MLDR (if enabled) records that Interests in flight on it are lost.
+ *
+ *  On association, the face is marked up and Forwarder::afterFaceAssociated triggers the
+ *  update path of the mobility forwarder (MAP-Me updates, KITE traces, anchor location
+ *  updates) as the creation of a face would, without waiting for a face to be added.  MLDR
+ *  then re-expresses the Interests lost during the handover.
+ *
+ *  Events come from the platform, see Ns3ReassociationProcedure.
+ */
+class WifiReassociationProcedure : noncopyable
+{
+public:
+  explicit
+  WifiReassociationProcedure(Forwarder& forwarder);
+
+  virtual
+  ~WifiReassociationProcedure();
+
+  /** \brief the link of \p face has been (re)associated to an access point
+   */
+  void
+  onAssociation(shared_ptr<Face> face);
+
+  /** \brief the link of \p face has been disassociated from its access point
+   */
+  void
+  onDisassociation(shared_ptr<Face> face);
+
+  uint64_t
+  getNAssociations() const
+  {
+    return m_nAssociations;
+  }
+
+  uint64_t
+  getNDisassociations() const
+  {
+    return m_nDisassociations;
+  }
+
+protected:
+  Forwarder& m_forwarder;
+
+private:
+  uint64_t m_nAssociations;
+  uint64_t m_nDisassociations;
+};
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_WIFI_REASSOCIATION_PROCEDURE_HPP
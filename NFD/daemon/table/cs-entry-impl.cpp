@@ -25,19 +25,152 @@
 
 #include "cs-entry-impl.hpp"
 
+#include <cstring>
+#include <limits>
+
 namespace nfd {
 namespace cs {
 
+/** \brief appends \p number encoded as TLV-TYPE or TLV-LENGTH, in the shortest form
+ *
+ *  Shortest encodings compare with memcmp in the same order as the numbers.
+ */
+static void
+appendVarNumber(std::string& key, uint64_t number)
+{
+  size_t nBytes = 0;
+  if (number < 253) {
+    key.push_back(static_cast<char>(number));
+    return;
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    key.push_back(static_cast<char>(253));
+    nBytes = 2;
+  }
+  else if (number <= std::numeric_limits<uint32_t>::max()) {
+    key.push_back(static_cast<char>(254));
+    nBytes = 4;
+  }
+  else {
+    key.push_back(static_cast<char>(255));
+    nBytes = 8;
+  }
+
+  for (size_t i = nBytes; i > 0; --i) {
+    key.push_back(static_cast<char>(number >> (8 * (i - 1))));
+  }
+}
+
+static void
+appendComponent(std::string& key, const name::Component& component)
+{
+  appendVarNumber(key, component.type());
+  appendVarNumber(key, component.value_size());
+  key.append(reinterpret_cast<const char*>(component.value()), component.value_size());
+}
+
+/** \return size of the encoded TLV-TYPE or TLV-LENGTH at \p pos, and its value in \p number
+ */
+static size_t
+readVarNumber(const std::string& key, size_t pos, uint64_t& number)
+{
+  uint8_t first = static_cast<uint8_t>(key[pos]);
+  if (first < 253) {
+    number = first;
+    return 1;
+  }
+
+  size_t nBytes = first == 253 ? 2 : (first == 254 ? 4 : 8);
+  number = 0;
+  for (size_t i = 1; i <= nBytes; ++i) {
+    number = (number << 8) | static_cast<uint8_t>(key[pos + i]);
+  }
+  return 1 + nBytes;
+}
+
+static int
+compareKeys(const char* key1, size_t size1, const char* key2, size_t size2)
+{
+  int cmp = std::memcmp(key1, key2, std::min(size1, size2));
+  if (cmp != 0) {
+    return cmp;
+  }
+  return size1 < size2 ? -1 : (size1 > size2 ? 1 : 0);
+}
+
+EntryImpl::EntryImpl()
+  : m_nameKeySize(0)
+  , m_isFullNameQuery(false)
+{
+}
+
 EntryImpl::EntryImpl(const Name& name)
-  : m_queryName(name)
+  : m_isFullNameQuery(!name.empty() && name[-1].isImplicitSha256Digest())
 {
+  size_t nameSize = m_isFullNameQuery ? name.size() - 1 : name.size();
+  for (size_t i = 0; i < nameSize; ++i) {
+    appendComponent(m_key, name[i]);
+  }
+  m_nameKeySize = m_key.size();
+
+  if (m_isFullNameQuery) {
+    appendComponent(m_key, name[-1]);
+  }
+
   BOOST_ASSERT(this->isQuery());
 }
 
 EntryImpl::EntryImpl(shared_ptr<const Data> data, bool isUnsolicited)
+  : m_isFullNameQuery(false)
 {
   this->setData(data, isUnsolicited);
   BOOST_ASSERT(!this->isQuery());
+
+  for (const name::Component& component : data->getName()) {
+    appendComponent(m_key, component);
+  }
+  m_nameKeySize = m_key.size();
+}
+
+EntryImpl::EntryImpl(const EntryImpl& entry, size_t nComponents)
+  : m_isFullNameQuery(false)
+{
+  size_t pos = 0;
+  for (size_t i = 0; i < nComponents; ++i) {
+    uint64_t number = 0;
+    pos += readVarNumber(entry.m_key, pos, number); // TLV-TYPE
+    pos += readVarNumber(entry.m_key, pos, number); // TLV-LENGTH
+    pos += number;
+  }
+  BOOST_ASSERT(pos <= entry.m_key.size());
+
+  m_key.assign(entry.m_key, 0, pos);
+  m_nameKeySize = pos;
+  BOOST_ASSERT(this->isQuery());
+}
+
+EntryImpl
+EntryImpl::getSuccessor() const
+{
+  BOOST_ASSERT(this->isQuery());
+
+  // smallest key greater than all keys starting with m_key
+  EntryImpl successor;
+  successor.m_key = m_key;
+  while (!successor.m_key.empty() && static_cast<uint8_t>(successor.m_key.back()) == 0xFF) {
+    successor.m_key.pop_back();
+  }
+  if (successor.m_key.empty()) {
+    // no key is greater than a sequence of 0xFF, which cannot be a valid key anyway
+    successor.m_key.assign(m_key.size() + 1, static_cast<char>(0xFF));
+  }
+  else {
+    ++successor.m_key.back();
+  }
+
+  successor.m_isFullNameQuery = m_isFullNameQuery;
+  successor.m_nameKeySize = std::min(m_nameKeySize, successor.m_key.size());
+  return successor;
 }
 
 bool
@@ -61,54 +194,48 @@ EntryImpl::unsetUnsolicited()
 }
 
 int
-compareQueryWithData(const Name& queryName, const Data& data)
+EntryImpl::compareQueryWithData(const EntryImpl& query, const EntryImpl& data)
 {
-  bool queryIsFullName = !queryName.empty() && queryName[-1].isImplicitSha256Digest();
-
-  int cmp = queryIsFullName ?
-            queryName.compare(0, queryName.size() - 1, data.getName()) :
-            queryName.compare(data.getName());
+  int cmp = compareKeys(query.m_key.data(), query.m_nameKeySize,
+                        data.m_key.data(), data.m_key.size());
 
   if (cmp != 0) { // Name without digest differs
     return cmp;
   }
 
-  if (queryIsFullName) { // Name without digest equals, compare digest
-    return queryName[-1].compare(data.getFullName()[-1]);
+  if (query.m_isFullNameQuery) { // Name without digest equals, compare digest
+    std::string digest;
+    appendComponent(digest, data.getFullName()[-1]);
+    return compareKeys(query.m_key.data() + query.m_nameKeySize,
+                       query.m_key.size() - query.m_nameKeySize,
+                       digest.data(), digest.size());
   }
   else { // queryName is a proper prefix of Data fullName
     return -1;
   }
 }
 
-int
-compareDataWithData(const Data& lhs, const Data& rhs)
-{
-  int cmp = lhs.getName().compare(rhs.getName());
-  if (cmp != 0) {
-    return cmp;
-  }
-
-  return lhs.getFullName()[-1].compare(rhs.getFullName()[-1]);
-}
-
 bool
 EntryImpl::operator<(const EntryImpl& other) const
 {
   if (this->isQuery()) {
     if (other.isQuery()) {
-      return m_queryName < other.m_queryName;
+      return compareKeys(m_key.data(), m_key.size(), other.m_key.data(), other.m_key.size()) < 0;
     }
     else {
-      return compareQueryWithData(m_queryName, other.getData()) < 0;
+      return compareQueryWithData(*this, other) < 0;
     }
   }
   else {
     if (other.isQuery()) {
-      return compareQueryWithData(other.m_queryName, this->getData()) > 0;
+      return compareQueryWithData(other, *this) > 0;
     }
     else {
-      return compareDataWithData(this->getData(), other.getData()) < 0;
+      int cmp = compareKeys(m_key.data(), m_key.size(), other.m_key.data(), other.m_key.size());
+      if (cmp != 0) {
+        return cmp < 0;
+      }
+      return this->getFullName()[-1].compare(other.getFullName()[-1]) < 0;
     }
   }
 }
@@ -52,6 +52,23 @@ public:
    */
   EntryImpl(shared_ptr<const Data> data, bool isUnsolicited);
 
+  /** \brief construct Entry for query of the prefix of \p entry Name with \p nComponents
+   *         components
+   *
+   *  This is equivalent to EntryImpl(entry.getName().getPrefix(nComponents)), without
+   *  creating a Name.
+   *  \pre nComponents <= entry.getName().size()
+   */
+  EntryImpl(const EntryImpl& entry, size_t nComponents);
+
+  /** \return query Entry ordered right after all Entries under the query Name
+   *
+   *  This is equivalent to EntryImpl(queryName.getSuccessor()), without creating a Name.
+   *  \pre isQuery()
+   */
+  EntryImpl
+  getSuccessor() const;
+
   /** \return true if entry can become stale, false if entry is never stale
    */
   bool
@@ -60,15 +77,44 @@ public:
   void
   unsetUnsolicited();
 
+  /** \return size of the sort key, in bytes
+   */
+  size_t
+  getKeySize() const
+  {
+    return m_key.size();
+  }
+
   bool
   operator<(const EntryImpl& other) const;
 
 private:
+  EntryImpl();
+
   bool
   isQuery() const;
 
+  /** \brief compares query Entry \p query with stored Entry \p data
+   */
+  static int
+  compareQueryWithData(const EntryImpl& query, const EntryImpl& data);
+
 private:
-  Name m_queryName;
+  /** \brief sort key of the Name, preserving the canonical order with a byte comparison
+   *
+   *  The key is the concatenation of the components encoded as TLV, with the shortest
+   *  encoding of their TLV-TYPE and TLV-LENGTH, which makes entries comparable with a single
+   *  memcmp instead of a component-by-component comparison.
+   *
+   *  For a query with a full Name, the key includes the implicit digest component.
+   */
+  std::string m_key;
+
+  /** \brief size of the key without the implicit digest, for a query with a full Name
+   */
+  size_t m_nameKeySize;
+
+  bool m_isFullNameQuery;
 };
 
 } // namespace cs
@@ -128,10 +128,11 @@ Cs::find(const Interest& interest,
   bool isRightmost = interest.getChildSelector() == 1;
   NFD_LOG_DEBUG("find " << prefix << (isRightmost ? " R" : " L"));
 
-  iterator first = m_table.lower_bound(prefix);
+  EntryImpl query(prefix);
+  iterator first = m_table.lower_bound(query);
   iterator last = m_table.end();
   if (prefix.size() > 0) {
-    last = m_table.lower_bound(prefix.getSuccessor());
+    last = m_table.lower_bound(query.getSuccessor());
   }
 
   iterator match = last;
@@ -176,11 +177,11 @@ Cs::findRightmost(const Interest& interest, iterator first, iterator last) const
       return matchExact == right ? last : matchExact;
     }
 
-    Name prefix = prev->getName().getPrefix(interestNameLength + 1);
+    EntryImpl prefix(*prev, interestNameLength + 1);
     iterator left = m_table.lower_bound(prefix);
 
     // normal case: [left,right) are under one-component-longer prefix
-    NFD_LOG_TRACE("  find-under-prefix " << prefix);
+    NFD_LOG_TRACE("  find-under-prefix " << prev->getName().getPrefix(interestNameLength + 1));
     iterator match = this->findLeftmost(interest, left, right);
     if (match != right) {
       return match;
@@ -208,6 +209,28 @@ Cs::setPolicyImpl(unique_ptr<Policy>& policy)
   BOOST_ASSERT(m_policy->getCs() == this);
 }
 
+TableMemoryUsage
+Cs::getMemoryUsage() const
+{
+  // std::set node: parent, left and right pointers plus color, rounded up
+  static const size_t TABLE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+  TableMemoryUsage usage;
+  usage.nEntries = m_table.size();
+  usage.overheadBytes = m_table.size() * (sizeof(EntryImpl) + TABLE_NODE_OVERHEAD);
+  for (const EntryImpl& entry : m_table) {
+    usage.overheadBytes += entry.getKeySize();
+    // wireEncode() would cache an encoding that the entry does not hold
+    if (entry.getData().hasWire()) {
+      usage.payloadBytes += entry.getData().wireEncode().size();
+    }
+    else {
+      usage.payloadBytes += getNameHeapSize(entry.getName());
+    }
+  }
+  return usage;
+}
+
 void
 Cs::dump()
 {
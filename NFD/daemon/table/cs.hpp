@@ -51,6 +51,7 @@
 #include "cs-policy.hpp"
 #include "cs-internal.hpp"
 #include "cs-entry-impl.hpp"
+#include "table-memory-usage.hpp"
 #include <ndn-cxx/util/signal.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 
@@ -127,6 +128,14 @@ public:
     return m_table.size();
   }
 
+  /** \brief estimates the memory used by stored packets
+   *
+   *  Overhead counts table nodes; payload counts the encoded Data packets.
+   *  Per-entry state kept by the replacement policy is not included.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   dump();
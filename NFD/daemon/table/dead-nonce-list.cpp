@@ -24,7 +24,7 @@
  */
 
 #include "dead-nonce-list.hpp"
-#include "core/city-hash.hpp"
+#include "name-tree.hpp"
 #include "core/logger.hpp"
 
 NFD_LOG_INIT("DeadNonceList");
@@ -44,8 +44,9 @@ const size_t DeadNonceList::EVICT_LIMIT = (1 << 6);
 
 DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
   : m_lifetime(lifetime)
-  , m_queue(m_index.get<0>())
-  , m_ht(m_index.get<1>())
+  , m_queueHead(0)
+  , m_queueSize(0)
+  , m_nMarks(0)
   , m_capacity(INITIAL_CAPACITY)
   , m_markInterval(m_lifetime / EXPECTED_MARK_COUNT)
   , m_adjustCapacityInterval(m_lifetime)
@@ -54,8 +55,9 @@ DeadNonceList::DeadNonceList(const time::nanoseconds& lifetime)
     BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
   }
 
+  this->resize(2 * INITIAL_CAPACITY);
   for (size_t i = 0; i < EXPECTED_MARK_COUNT; ++i) {
-    m_queue.push_back(MARK);
+    this->pushBack(MARK);
   }
 
   m_markEvent = scheduler::schedule(m_markInterval, bind(&DeadNonceList::mark, this));
@@ -83,43 +85,189 @@ DeadNonceList::~DeadNonceList()
 size_t
 DeadNonceList::size() const
 {
-  return m_queue.size() - this->countMarks();
+  return m_queueSize - this->countMarks();
+}
+
+TableMemoryUsage
+DeadNonceList::getMemoryUsage() const
+{
+  TableMemoryUsage usage;
+  usage.nEntries = this->size();
+  usage.overheadBytes = (m_queue.capacity() + m_table.capacity()) * sizeof(Entry);
+  return usage;
 }
 
 bool
 DeadNonceList::has(const Name& name, uint32_t nonce) const
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  return m_ht.find(entry) != m_ht.end();
+  return this->has(name_tree::computeHash(name), nonce);
+}
+
+bool
+DeadNonceList::has(size_t nameHash, uint32_t nonce) const
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
+  size_t mask = m_table.size() - 1;
+  for (size_t slot = this->getHomeSlot(entry); m_table[slot] != MARK; slot = (slot + 1) & mask) {
+    if (m_table[slot] == entry) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void
 DeadNonceList::add(const Name& name, uint32_t nonce)
 {
-  Entry entry = DeadNonceList::makeEntry(name, nonce);
-  m_queue.push_back(entry);
+  this->add(name_tree::computeHash(name), nonce);
+}
+
+void
+DeadNonceList::add(size_t nameHash, uint32_t nonce)
+{
+  Entry entry = DeadNonceList::makeEntry(nameHash, nonce);
+  this->pushBack(entry);
 
   this->evictEntries();
 }
 
 DeadNonceList::Entry
-DeadNonceList::makeEntry(const Name& name, uint32_t nonce)
+DeadNonceList::makeEntry(size_t nameHash, uint32_t nonce)
+{
+  // 64-bit finalizer of MurmurHash3, mixing Nonce bits into all bits of the Entry
+  Entry entry = static_cast<Entry>(nameHash) ^ (static_cast<Entry>(nonce) * 0x9e3779b97f4a7c15ULL);
+  entry ^= entry >> 33;
+  entry *= 0xff51afd7ed558ccdULL;
+  entry ^= entry >> 33;
+  entry *= 0xc4ceb9fe1a85ec53ULL;
+  entry ^= entry >> 33;
+  return entry == MARK ? ~MARK : entry;
+}
+
+size_t
+DeadNonceList::getHomeSlot(Entry entry) const
 {
-  Block nameWire = name.wireEncode();
-  return CityHash64WithSeed(reinterpret_cast<const char*>(nameWire.wire()), nameWire.size(),
-                            static_cast<uint64_t>(nonce));
+  return static_cast<size_t>(entry) & (m_table.size() - 1);
+}
+
+void
+DeadNonceList::pushBack(Entry entry)
+{
+  if (m_queueSize == m_queue.size()) {
+    this->resize(2 * m_queue.size());
+  }
+
+  m_queue[(m_queueHead + m_queueSize) & (m_queue.size() - 1)] = entry;
+  ++m_queueSize;
+
+  if (entry == MARK) {
+    ++m_nMarks;
+    return;
+  }
+
+  size_t mask = m_table.size() - 1;
+  size_t slot = this->getHomeSlot(entry);
+  while (m_table[slot] != MARK) {
+    slot = (slot + 1) & mask;
+  }
+  m_table[slot] = entry;
+}
+
+void
+DeadNonceList::popFront()
+{
+  BOOST_ASSERT(m_queueSize > 0);
+  Entry entry = m_queue[m_queueHead];
+  m_queueHead = (m_queueHead + 1) & (m_queue.size() - 1);
+  --m_queueSize;
+
+  if (entry == MARK) {
+    --m_nMarks;
+  }
+  else {
+    this->eraseFromTable(entry);
+  }
+}
+
+void
+DeadNonceList::eraseFromTable(Entry entry)
+{
+  size_t mask = m_table.size() - 1;
+  size_t slot = this->getHomeSlot(entry);
+  while (m_table[slot] != entry) {
+    BOOST_ASSERT(m_table[slot] != MARK);
+    slot = (slot + 1) & mask;
+  }
+
+  // backward shift deletion: move up following entries that would not be reachable
+  // from their home slot once this slot is emptied
+  size_t next = slot;
+  while (true) {
+    next = (next + 1) & mask;
+    if (m_table[next] == MARK) {
+      break;
+    }
+    size_t home = this->getHomeSlot(m_table[next]);
+    bool isReachable = slot <= next ? (slot < home && home <= next) :
+                                      (slot < home || home <= next);
+    if (!isReachable) {
+      m_table[slot] = m_table[next];
+      slot = next;
+    }
+  }
+  m_table[slot] = MARK;
+}
+
+void
+DeadNonceList::resize(size_t nSlots)
+{
+  BOOST_ASSERT((nSlots & (nSlots - 1)) == 0 && nSlots >= m_queueSize);
+
+  std::vector<Entry> queue(nSlots, MARK);
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    queue[i] = m_queue[(m_queueHead + i) & (m_queue.size() - 1)];
+  }
+  m_queue.swap(queue);
+  m_queueHead = 0;
+
+  std::vector<Entry>(2 * nSlots, MARK).swap(m_table);
+  size_t mask = m_table.size() - 1;
+  for (size_t i = 0; i < m_queueSize; ++i) {
+    Entry entry = m_queue[i];
+    if (entry == MARK) {
+      continue;
+    }
+    size_t slot = this->getHomeSlot(entry);
+    while (m_table[slot] != MARK) {
+      slot = (slot + 1) & mask;
+    }
+    m_table[slot] = entry;
+  }
+}
+
+void
+DeadNonceList::compact()
+{
+  size_t nSlots = m_queue.size();
+  while (nSlots > 2 * INITIAL_CAPACITY && nSlots >= 4 * std::max(m_queueSize, m_capacity)) {
+    nSlots /= 2;
+  }
+  if (nSlots != m_queue.size()) {
+    NFD_LOG_TRACE("compact slots=" << nSlots);
+    this->resize(nSlots);
+  }
 }
 
 size_t
 DeadNonceList::countMarks() const
 {
-  return m_ht.count(MARK);
+  return m_nMarks;
 }
 
 void
 DeadNonceList::mark()
 {
-  m_queue.push_back(MARK);
+  this->pushBack(MARK);
   size_t nMarks = this->countMarks();
   m_actualMarkCounts.insert(nMarks);
 
@@ -150,6 +298,7 @@ DeadNonceList::adjustCapacity()
   m_actualMarkCounts.clear();
 
   this->evictEntries();
+  this->compact();
 
   m_adjustCapacityEvent = scheduler::schedule(m_adjustCapacityInterval,
                                               bind(&DeadNonceList::adjustCapacity, this));
@@ -158,14 +307,14 @@ DeadNonceList::adjustCapacity()
 void
 DeadNonceList::evictEntries()
 {
-  ssize_t nOverCapacity = m_queue.size() - m_capacity;
+  ssize_t nOverCapacity = m_queueSize - m_capacity;
   if (nOverCapacity <= 0) // not over capacity
     return;
 
   for (ssize_t nEvict = std::min<ssize_t>(nOverCapacity, EVICT_LIMIT); nEvict > 0; --nEvict) {
-    m_queue.erase(m_queue.begin());
+    this->popFront();
   }
-  BOOST_ASSERT(m_queue.size() >= m_capacity);
+  BOOST_ASSERT(m_queueSize >= m_capacity);
 }
 
 } // namespace nfd
@@ -27,10 +27,8 @@
 #define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_HPP
 
 #include "common.hpp"
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/sequenced_index.hpp>
-#include <boost/multi_index/hashed_index.hpp>
 #include "core/scheduler.hpp"
+#include "table-memory-usage.hpp"
 
 namespace nfd {
 
@@ -50,6 +48,11 @@ namespace nfd {
  *  At fixed intervals, the MARK, an entry with a special value, is inserted into the container.
  *  The number of MARKs stored in the container reflects the lifetime of entries,
  *  because MARKs are inserted at fixed intervals.
+ *
+ *  Entries are kept in insertion order in a ring buffer, and indexed by an open-addressing
+ *  hash table with linear probing, so that no memory is allocated per entry.
+ *  The hash is derived from the NameTree hash of the Name, which the forwarding pipelines
+ *  obtain from the PIT entry instead of hashing the Name again.
  */
 class DeadNonceList : noncopyable
 {
@@ -72,17 +75,40 @@ public:
   bool
   has(const Name& name, uint32_t nonce) const;
 
+  /** \brief determines if name+nonce exists
+   *  \param nameHash hash of Name, as returned by name_tree::computeHash
+   *         or pit::Entry::getNameHash
+   *  \return true if name+nonce exists
+   */
+  bool
+  has(size_t nameHash, uint32_t nonce) const;
+
   /** \brief records name+nonce
    */
   void
   add(const Name& name, uint32_t nonce);
 
+  /** \brief records name+nonce
+   *  \param nameHash hash of Name, as returned by name_tree::computeHash
+   *         or pit::Entry::getNameHash
+   */
+  void
+  add(size_t nameHash, uint32_t nonce);
+
   /** \return number of stored Nonces
    *  \note The return value does not contain non-Nonce entries in the index, if any.
    */
   size_t
   size() const;
 
+  /** \brief estimates the memory used by the index
+   *
+   *  Overhead counts the allocated slots of the ring buffer and of the hash table.
+   *  Entries are fixed-size hashes, so payload is always zero.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
   /** \return expected lifetime
    */
   const time::nanoseconds&
@@ -91,21 +117,34 @@ public:
 private: // Entry and Index
   typedef uint64_t Entry;
 
+  /** \return a hash of name+nonce, never equal to MARK
+   */
   static Entry
-  makeEntry(const Name& name, uint32_t nonce);
+  makeEntry(size_t nameHash, uint32_t nonce);
 
-  typedef boost::multi_index_container<
-    Entry,
-    boost::multi_index::indexed_by<
-      boost::multi_index::sequenced<>,
-      boost::multi_index::hashed_non_unique<
-        boost::multi_index::identity<Entry>
-      >
-    >
-  > Index;
+  /** \brief appends an Entry or a MARK to the queue, and indexes it
+   */
+  void
+  pushBack(Entry entry);
 
-  typedef Index::nth_index<0>::type Queue;
-  typedef Index::nth_index<1>::type Hashtable;
+  /** \brief removes the oldest Entry or MARK from the queue and the index
+   */
+  void
+  popFront();
+
+  /** \return slot of the hash table where a probe for \p entry starts
+   */
+  size_t
+  getHomeSlot(Entry entry) const;
+
+  void
+  eraseFromTable(Entry entry);
+
+  /** \brief reallocates the queue and the hash table for \p nSlots queue slots,
+   *         which must be a power of 2 not less than the queue size
+   */
+  void
+  resize(size_t nSlots);
 
 private: // actual lifetime estimation and capacity control
   /** \return number of MARKs in the index
@@ -113,6 +152,11 @@ private: // actual lifetime estimation and capacity control
   size_t
   countMarks() const;
 
+  /** \brief shrink the queue and the hash table if they are mostly unused
+   */
+  void
+  compact();
+
   /** \brief add a MARK, then record number of MARKs in m_actualMarkCounts
    */
   void
@@ -140,9 +184,21 @@ public:
 
 private:
   time::nanoseconds m_lifetime;
-  Index m_index;
-  Queue& m_queue;
-  Hashtable& m_ht;
+
+  /** \brief ring buffer of Entries and MARKs in insertion order
+   *
+   *  Its size is a power of 2.
+   */
+  std::vector<Entry> m_queue;
+  size_t m_queueHead;
+  size_t m_queueSize;
+  size_t m_nMarks;
+
+  /** \brief open-addressing hash table of Entries, MARK denotes an empty slot
+   *
+   *  Its size is twice the size of m_queue, so that load factor is at most 0.5.
+   */
+  std::vector<Entry> m_table;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity control
 
@@ -176,8 +232,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE: // actual lifetime estimation and capacity contr
   /** \brief the MARK for capacity
    *
    *  The MARK doesn't have a distinct type.
-   *  Entry is a hash. The hash function should have non-invertible property,
-   *  so it's unlikely for a usual Entry to have collision with the MARK.
+   *  makeEntry never returns this value, so a MARK is distinguished from any Entry.
+   *  MARKs are counted, but not stored in the hash table.
    */
   static const Entry MARK;
 
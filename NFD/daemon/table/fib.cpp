@@ -131,7 +131,7 @@ Fib::insert(const Name& prefix)
   shared_ptr<fib::Entry> entry = nameTreeEntry->getFibEntry();
   if (static_cast<bool>(entry))
     return std::make_pair(entry, false);
-  entry = make_shared<fib::Entry>(prefix);
+  entry = make_shared<fib::Entry>(nameTreeEntry->getPrefix());
   nameTreeEntry->setFibEntry(entry);
   ++m_nItems;
 
@@ -203,6 +203,19 @@ Fib::removeNextHopFromAllEntries(shared_ptr<Face> face)
   }
 }
 
+TableMemoryUsage
+Fib::getMemoryUsage() const
+{
+  TableMemoryUsage usage;
+  for (const fib::Entry& entry : *this) {
+    ++usage.nEntries;
+    usage.overheadBytes += sizeof(fib::Entry) +
+                           entry.getNextHops().capacity() * sizeof(fib::NextHop);
+    usage.payloadBytes += getNameHeapSize(entry.getPrefix());
+  }
+  return usage;
+}
+
 Fib::const_iterator
 Fib::begin() const
 {
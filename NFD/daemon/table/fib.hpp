@@ -52,6 +52,13 @@ public:
   size_t
   size() const;
 
+  /** \brief estimates the memory used by FIB entries
+   *
+   *  Overhead counts entries and their nexthop lists; payload counts the prefixes.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
 #ifdef FIB_EXTENSIONS
 public: // signals
   /** \brief fires after a fib::Entry is added
@@ -152,6 +152,15 @@ Measurements::extendLifetime(Entry& entry,
   entry.m_cleanup = scheduler::schedule(lifetime, bind(&Measurements::cleanup, this, ref(entry)));
 }
 
+TableMemoryUsage
+Measurements::getMemoryUsage() const
+{
+  TableMemoryUsage usage;
+  usage.nEntries = m_nItems;
+  usage.overheadBytes = m_nItems * sizeof(Entry);
+  return usage;
+}
+
 void
 Measurements::cleanup(Entry& entry)
 {
@@ -131,6 +131,13 @@ public:
   size_t
   size() const;
 
+  /** \brief estimates the memory used by Measurements entries
+   *
+   *  Overhead counts entries; StrategyInfo items attached by strategies are not included.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
 private:
   void
   cleanup(measurements::Entry& entry);
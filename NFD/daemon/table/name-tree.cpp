@@ -211,7 +211,12 @@ NameTree::lookup(const Name& prefix)
 
   for (size_t i = 0; i <= prefix.size(); i++)
     {
+#ifdef NAME_INTERNING
+      // entries share the wire buffer of identical names across the simulation
+      Name temp = prefix.getInternedPrefix(i);
+#else
       Name temp = prefix.getPrefix(i);
+#endif // NAME_INTERNING
 
       // insert() will create the entry if it does not exist.
       std::pair<shared_ptr<name_tree::Entry>, bool> ret = insert(temp);
@@ -238,6 +243,17 @@ NameTree::lookup(const Name& prefix)
   return entry;
 }
 
+void
+NameTree::prefetch(const Name& prefix) const
+{
+  for (size_t hashValue : name_tree::computeHashSet(prefix)) {
+    name_tree::Node* node = m_buckets[hashValue % m_nBuckets];
+    if (node != 0) {
+      __builtin_prefetch(node);
+    }
+  }
+}
+
 // Exact Match
 shared_ptr<name_tree::Entry>
 NameTree::findExactMatch(const Name& prefix) const
@@ -472,6 +488,28 @@ NameTree::findAllMatches(const Name& prefix,
   return {end(), end()};
 }
 
+TableMemoryUsage
+NameTree::getMemoryUsage() const
+{
+  TableMemoryUsage usage;
+  usage.nEntries = m_nItems;
+  usage.overheadBytes = m_nBuckets * sizeof(name_tree::Node*);
+
+  for (size_t i = 0; i < m_nBuckets; i++)
+    {
+      for (const name_tree::Node* node = m_buckets[i]; node != 0; node = node->m_next)
+        {
+          const name_tree::Entry& entry = *node->m_entry;
+          usage.overheadBytes += sizeof(name_tree::Node) + sizeof(name_tree::Entry) +
+            entry.m_children.capacity() * sizeof(shared_ptr<name_tree::Entry>) +
+            entry.m_pitEntries.capacity() * sizeof(shared_ptr<pit::Entry>);
+          usage.payloadBytes += getNameHeapSize(entry.m_prefix);
+        }
+    }
+
+  return usage;
+}
+
 // Hash Table Resize
 void
 NameTree::resize(size_t newNBuckets)
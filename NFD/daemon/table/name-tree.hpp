@@ -28,6 +28,7 @@
 
 #include "common.hpp"
 #include "name-tree-entry.hpp"
+#include "table-memory-usage.hpp"
 
 namespace nfd {
 namespace name_tree {
@@ -101,6 +102,15 @@ public: // information
   size_t
   getNBuckets() const;
 
+  /**
+   * \brief Estimate the memory used by the Name Tree
+   * \details Overhead counts hash buckets, nodes, entries and their child and
+   * PIT entry vectors; payload counts the Name prefixes. Tables attached to the
+   * entries (FIB, PIT, Measurements, StrategyChoice) report their own usage.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
   /**
    * \brief Dump all the information stored in the Name Tree for debugging.
    */
@@ -157,6 +167,14 @@ public: // shortcut access
   get(const strategy_choice::Entry& strategyChoiceEntry) const;
 
 public: // matching
+  /**
+   * \brief Prefetch the hash buckets of all the prefixes of a name into the CPU cache
+   * \details Issued for a batch of names before they are looked up, so that the lookups
+   * do not wait for each other's memory accesses.  The table is not modified.
+   */
+  void
+  prefetch(const Name& prefix) const;
+
   /**
    * \brief Exact match lookup for the given name prefix.
    * \return a null shared_ptr if this prefix is not found;
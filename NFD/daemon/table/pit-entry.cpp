@@ -24,6 +24,7 @@
  */
 
 #include "pit-entry.hpp"
+#include "name-tree.hpp"
 #include <algorithm>
 
 namespace nfd {
@@ -43,6 +44,15 @@ Entry::getName() const
   return m_interest->getName();
 }
 
+size_t
+Entry::getNameHash() const
+{
+  if (m_nameTreeEntry != nullptr) {
+    return m_nameTreeEntry->getHash();
+  }
+  return name_tree::computeHash(this->getName());
+}
+
 bool
 Entry::hasLocalInRecord() const
 {
@@ -133,8 +143,7 @@ Entry::insertOrUpdateInRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_inRecords.begin(), m_inRecords.end(),
     [&face] (const InRecord& inRecord) { return inRecord.getFace() == face; });
   if (it == m_inRecords.end()) {
-    m_inRecords.emplace_front(face);
-    it = m_inRecords.begin();
+    it = m_inRecords.emplace(m_inRecords.begin(), face);
   }
 
   it->update(interest);
@@ -160,8 +169,7 @@ Entry::insertOrUpdateOutRecord(shared_ptr<Face> face, const Interest& interest)
   auto it = std::find_if(m_outRecords.begin(), m_outRecords.end(),
     [&face] (const OutRecord& outRecord) { return outRecord.getFace() == face; });
   if (it == m_outRecords.end()) {
-    m_outRecords.emplace_front(face);
-    it = m_outRecords.begin();
+    it = m_outRecords.emplace(m_outRecords.begin(), face);
   }
 
   it->update(interest);
@@ -30,6 +30,11 @@
 #include "pit-out-record.hpp"
 #include "core/scheduler.hpp"
 
+#include <boost/version.hpp>
+#if BOOST_VERSION >= 105800
+#include <boost/container/small_vector.hpp>
+#endif // BOOST_VERSION >= 105800
+
 namespace nfd {
 
 class NameTree;
@@ -40,13 +45,28 @@ class Entry;
 
 namespace pit {
 
+/** \brief number of InRecords or OutRecords stored inside the PIT entry itself
+ *
+ *  Most PIT entries have a single downstream and a single upstream, so the first
+ *  record of each collection is kept inline and only additional records need
+ *  a heap allocation.
+ */
+const size_t N_INLINE_FACE_RECORDS = 1;
+
+#if BOOST_VERSION >= 105800
 /** \brief represents an unordered collection of InRecords
+ *  \note Iterators are invalidated by insertOrUpdateInRecord and deleteInRecords.
  */
-typedef std::list< InRecord>  InRecordCollection;
+typedef boost::container::small_vector<InRecord, N_INLINE_FACE_RECORDS> InRecordCollection;
 
 /** \brief represents an unordered collection of OutRecords
+ *  \note Iterators are invalidated by insertOrUpdateOutRecord and deleteOutRecord.
  */
-typedef std::list<OutRecord> OutRecordCollection;
+typedef boost::container::small_vector<OutRecord, N_INLINE_FACE_RECORDS> OutRecordCollection;
+#else
+typedef std::vector<InRecord> InRecordCollection;
+typedef std::vector<OutRecord> OutRecordCollection;
+#endif // BOOST_VERSION >= 105800
 
 /** \brief indicates where duplicate Nonces are found
  */
@@ -78,6 +98,14 @@ public:
   const Name&
   getName() const;
 
+  /** \return hash of Interest Name, as computed by name_tree::computeHash
+   *
+   *  The hash is taken from the NameTree entry if the PIT entry has been inserted,
+   *  so that it is not computed again.
+   */
+  size_t
+  getNameHash() const;
+
   /** \brief decides whether Interest can be forwarded to face
    *
    *  \return true if OutRecord of this face does not exist or has expired,
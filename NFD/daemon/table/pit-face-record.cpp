@@ -30,6 +30,7 @@ namespace pit {
 
 FaceRecord::FaceRecord(shared_ptr<Face> face)
   : m_face(face)
+  , m_faceId(face->getId())
   , m_lastNonce(0)
   , m_lastRenewed(time::steady_clock::TimePoint::min())
   , m_expiry(time::steady_clock::TimePoint::min())
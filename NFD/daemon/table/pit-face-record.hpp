@@ -43,9 +43,17 @@ public:
   explicit
   FaceRecord(shared_ptr<Face> face);
 
-  shared_ptr<Face>
+  const shared_ptr<Face>&
   getFace() const;
 
+  /** \brief gives the FaceId of the face at the time this record was created
+   *
+   *  Unlike getFace()->getId(), this does not touch the Face object,
+   *  and stays valid after the face has been removed from the FaceTable.
+   */
+  FaceId
+  getFaceId() const;
+
   uint32_t
   getLastNonce() const;
 
@@ -65,17 +73,24 @@ public:
 
 private:
   shared_ptr<Face> m_face;
+  FaceId m_faceId;
   uint32_t m_lastNonce;
   time::steady_clock::TimePoint m_lastRenewed;
   time::steady_clock::TimePoint m_expiry;
 };
 
-inline shared_ptr<Face>
+inline const shared_ptr<Face>&
 FaceRecord::getFace() const
 {
   return m_face;
 }
 
+inline FaceId
+FaceRecord::getFaceId() const
+{
+  return m_faceId;
+}
+
 inline uint32_t
 FaceRecord::getLastNonce() const
 {
@@ -25,7 +25,7 @@
 #include "fw/strategy-info.hpp"
 #include "face/face.hpp"
 #include "pit-entry.hpp"
-#include<boost/unordered_map.hpp> 
+#include <unordered_map>
 
 #include "pit-tnt-record.hpp"
 
@@ -36,6 +36,11 @@
 
 namespace nfd {
   namespace pit {
+
+/** \brief minimum number of tracing records before invalid records are collected
+ */
+const size_t TNT_MIN_CLEANUP_THRESHOLD = 16;
+
     class TntEntry: public fw::StrategyInfo
 {
   public:
@@ -50,7 +55,11 @@ namespace nfd {
       return 135246;
     }
   
-    typedef boost::unordered_map<std::string, TntRecord> TracingInterestList;
+    /** \brief tracing records, keyed by the name of the tracing Interest
+     *  \note Names are hashed over their wire encoding, which avoids building
+     *        a URI string for every tracing Interest.
+     */
+    typedef std::unordered_map<Name, TntRecord> TracingInterestList;
     
     const TracingInterestList&
     getTracingInterests() const;
@@ -59,24 +68,39 @@ namespace nfd {
     addTracingRecord(weak_ptr<const Interest> interestWeak
                     ,weak_ptr<Face> inFaceWeak
                     ,weak_ptr<pit::Entry> pitEntryWeek);
-    void
+
+    /** \brief removes a tracing record
+     *  \return iterator following the removed record
+     */
+    TracingInterestList::const_iterator
     removeTracingRecord(TracingInterestList::const_iterator it);
 
+    /** \brief removes all records that are no longer valid
+     *
+     *  This is invoked by addTracingRecord whenever the number of records doubles since
+     *  the previous collection, so that records of expired or satisfied tracing Interests
+     *  are bounded even if no traced Interest arrives to pull them.
+     */
+    void
+    removeInvalidRecords();
    
   private:
     TracingInterestList m_tracingInterests;
     Name m_tracingName;
+    size_t m_cleanupThreshold;
    
   }; 
   
 inline 
 TntEntry::TntEntry(const Name& tracingName)
                   :m_tracingName(tracingName)
+                  ,m_cleanupThreshold(TNT_MIN_CLEANUP_THRESHOLD)
 {
 }
 
 inline 
 TntEntry::TntEntry()
+                  :m_cleanupThreshold(TNT_MIN_CLEANUP_THRESHOLD)
 {
   
 }
@@ -88,10 +112,23 @@ TntEntry::getTracingInterests() const
   return m_tracingInterests;
 }
 
-inline void
+inline TntEntry::TracingInterestList::const_iterator
 TntEntry::removeTracingRecord(TracingInterestList::const_iterator it)
 {
-  m_tracingInterests.erase(it);
+  return m_tracingInterests.erase(it);
+}
+
+inline void
+TntEntry::removeInvalidRecords()
+{
+  for (TracingInterestList::const_iterator it = m_tracingInterests.begin();
+       it != m_tracingInterests.end();) {
+    if (it->second.isValid())
+      ++it;
+    else
+      it = m_tracingInterests.erase(it);
+  }
+  m_cleanupThreshold = std::max(TNT_MIN_CLEANUP_THRESHOLD, 2 * m_tracingInterests.size());
 }
 
 inline void
@@ -112,18 +149,20 @@ TntEntry::addTracingRecord(weak_ptr<const Interest> interestWeak
     return;
   } 
 
-  std::string InterestNameString=interest->getName().toUri();
   time::steady_clock::TimePoint newExpiry=time::steady_clock::now()+interest->getInterestLifetime();
-  
-  
-  if(m_tracingInterests.find(interest->getName().toUri())==m_tracingInterests.end()
-  || m_tracingInterests[InterestNameString].getExpiry() < newExpiry)
-    m_tracingInterests[InterestNameString]=TntRecord(interestWeak
-	                                            ,newExpiry
-	                                            ,inFaceWeak
-					            ,pitEntryWeek
-					            );
-    
+  TntRecord record(interestWeak
+                  ,newExpiry
+                  ,inFaceWeak
+                  ,pitEntryWeek
+                  );
+
+  std::pair<TracingInterestList::iterator, bool> inserted =
+    m_tracingInterests.insert(std::make_pair(interest->getName(), record));
+  if (!inserted.second && inserted.first->second.getExpiry() < newExpiry)
+    inserted.first->second = record;
+
+  if (m_tracingInterests.size() >= m_cleanupThreshold)
+    removeInvalidRecords();
 }
    
 }// end namespace pit
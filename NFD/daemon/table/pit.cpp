@@ -38,6 +38,20 @@ static_assert(std::is_move_constructible<DataMatchResult>::value,
               "DataMatchResult must be MoveConstructible");
 #endif // HAVE_IS_MOVE_CONSTRUCTIBLE
 
+/** \return bytes of \p records stored outside of the PIT entry
+ */
+template<typename RecordCollection>
+static size_t
+getRecordsHeapSize(const RecordCollection& records)
+{
+#if BOOST_VERSION >= 105800
+  if (records.capacity() <= N_INLINE_FACE_RECORDS) {
+    return 0;
+  }
+#endif // BOOST_VERSION >= 105800
+  return records.capacity() * sizeof(typename RecordCollection::value_type);
+}
+
 } // namespace pit
 
 // http://en.cppreference.com/w/cpp/concept/ForwardIterator
@@ -116,6 +130,26 @@ Pit::erase(shared_ptr<pit::Entry> pitEntry)
   --m_nItems;
 }
 
+TableMemoryUsage
+Pit::getMemoryUsage() const
+{
+  TableMemoryUsage usage;
+  for (const pit::Entry& entry : *this) {
+    ++usage.nEntries;
+    usage.overheadBytes += sizeof(pit::Entry) +
+                           pit::getRecordsHeapSize(entry.getInRecords()) +
+                           pit::getRecordsHeapSize(entry.getOutRecords());
+    // wireEncode() would cache an encoding that the entry does not hold
+    if (entry.getInterest().hasWire()) {
+      usage.payloadBytes += entry.getInterest().wireEncode().size();
+    }
+    else {
+      usage.payloadBytes += getNameHeapSize(entry.getName());
+    }
+  }
+  return usage;
+}
+
 Pit::const_iterator
 Pit::begin() const
 {
@@ -58,6 +58,14 @@ public:
   size_t
   size() const;
 
+  /** \brief estimates the memory used by PIT entries
+   *
+   *  Overhead counts entries and heap-allocated in/out-records; payload counts
+   *  the Interest held by each entry. NameTree nodes are reported by NameTree.
+   */
+  TableMemoryUsage
+  getMemoryUsage() const;
+
   /** \brief inserts a PIT entry for Interest
    *
    *  If an entry for exact same name and selectors exists, that entry is returned.
@@ -127,7 +127,7 @@ StrategyChoice::insert(const Name& prefix, const Name& strategyName)
 
   if (!static_cast<bool>(entry)) {
     oldStrategy = &this->findEffectiveStrategy(prefix);
-    entry = make_shared<Entry>(prefix);
+    entry = make_shared<Entry>(nte->getPrefix());
     nte->setStrategyChoiceEntry(entry);
     ++m_nItems;
     NFD_LOG_TRACE("insert(" << prefix << ") new entry " << strategy->getName());
@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2015,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_TABLE_MEMORY_USAGE_HPP
+#define NFD_DAEMON_TABLE_TABLE_MEMORY_USAGE_HPP
+
+#include "common.hpp"
+
+namespace nfd {
+
+/** \brief approximate memory footprint of a table
+ *
+ *  The figures are computed from entry counts, sizeof of the entry types and
+ *  container capacities at the time of the call; allocator bookkeeping is not included.
+ *  They are meant to compare tables and spot growth over time, not to match process RSS.
+ */
+struct TableMemoryUsage
+{
+  TableMemoryUsage()
+    : nEntries(0)
+    , overheadBytes(0)
+    , payloadBytes(0)
+  {
+  }
+
+  /** \brief number of entries in the table
+   */
+  size_t nEntries;
+
+  /** \brief bytes used by entries, index nodes and hash buckets
+   */
+  size_t overheadBytes;
+
+  /** \brief bytes of packets and names owned by the entries
+   */
+  size_t payloadBytes;
+};
+
+#ifdef NAME_INTERNING
+/** \return number of Names holding the wire buffer of \p name
+ *
+ *  The Name block and each of its parsed components hold a reference to the buffer, so each
+ *  holder accounts for name.size() + 1 references.
+ */
+inline size_t
+getNameHolderCount(const Name& name)
+{
+  // use_count includes the copy returned by getBuffer
+  size_t nReferences = name.wireEncode().getBuffer().use_count() - 1;
+  return std::max<size_t>(1, nReferences / (name.size() + 1));
+}
+#endif // NAME_INTERNING
+
+/** \return approximate heap bytes used by \p name, excluding sizeof(Name)
+ *  \note A Name without wire encoding is estimated from its components and is not encoded:
+ *        wireEncode() would cache the encoding in the Name being measured.
+ *  \note The wire buffer may be shared with other Names.  An interned buffer is split
+ *        evenly between its holders; any other buffer is counted for each holder.
+ */
+inline size_t
+getNameHeapSize(const Name& name)
+{
+  size_t wireSize = 0;
+  if (name.hasWire()) {
+    wireSize = name.wireEncode().size();
+#ifdef NAME_INTERNING
+    if (name.isInterned()) {
+      wireSize /= getNameHolderCount(name);
+    }
+#endif // NAME_INTERNING
+  }
+  else {
+    for (const name::Component& component : name) {
+      wireSize += component.size();
+    }
+  }
+  return wireSize + name.size() * sizeof(name::Component);
+}
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_TABLE_MEMORY_USAGE_HPP
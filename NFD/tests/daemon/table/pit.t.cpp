@@ -495,6 +495,59 @@ BOOST_AUTO_TEST_CASE(Iterator)
   }
 }
 
+BOOST_AUTO_TEST_CASE(MemoryUsage)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+
+  TableMemoryUsage usage = pit.getMemoryUsage();
+  BOOST_CHECK_EQUAL(usage.nEntries, 0);
+  BOOST_CHECK_EQUAL(usage.overheadBytes, 0);
+  BOOST_CHECK_EQUAL(usage.payloadBytes, 0);
+
+  // Interests received from a face are encoded
+  shared_ptr<Interest> interestA = makeInterest("/A");
+  interestA->wireEncode();
+  shared_ptr<Interest> interestB = makeInterest("/B/C");
+  interestB->wireEncode();
+  shared_ptr<pit::Entry> entryA = pit.insert(*interestA).first;
+  pit.insert(*interestB);
+
+  usage = pit.getMemoryUsage();
+  BOOST_CHECK_EQUAL(usage.nEntries, 2);
+  BOOST_CHECK_GE(usage.overheadBytes, 2 * sizeof(pit::Entry));
+  BOOST_CHECK_EQUAL(usage.payloadBytes,
+                    interestA->wireEncode().size() + interestB->wireEncode().size());
+
+  // in-records beyond the inline capacity are counted as overhead
+  size_t overheadBefore = usage.overheadBytes;
+  for (size_t i = 0; i <= pit::N_INLINE_FACE_RECORDS; ++i) {
+    entryA->insertOrUpdateInRecord(make_shared<DummyFace>(), *interestA);
+  }
+  BOOST_CHECK_GT(pit.getMemoryUsage().overheadBytes, overheadBefore);
+
+  BOOST_CHECK_GT(nameTree.getMemoryUsage().nEntries, 2);
+  BOOST_CHECK_GT(nameTree.getMemoryUsage().payloadBytes, 0);
+
+  pit.erase(entryA);
+  BOOST_CHECK_EQUAL(pit.getMemoryUsage().nEntries, 1);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryUsageUnencoded)
+{
+  NameTree nameTree(16);
+  Pit pit(nameTree);
+
+  shared_ptr<Interest> interest = makeInterest("/A/B");
+  pit.insert(*interest);
+
+  // sampling must not encode the packets held by the table
+  TableMemoryUsage usage = pit.getMemoryUsage();
+  BOOST_CHECK(!interest->hasWire());
+  BOOST_CHECK_EQUAL(usage.payloadBytes, getNameHeapSize(interest->getName()));
+  BOOST_CHECK_GT(usage.payloadBytes, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
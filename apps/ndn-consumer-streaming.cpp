@@ -24,15 +24,9 @@
 
 /**
  *
- * In order to distinguish among first transmission and retransmission, ndn-consumer must initialize
- * m_seqRetxCounts[seq] before sending the pkt. The current version of ndn-consumer, doesn't do such thing.
- * By adding:
- *  if(m_seqRetxCounts.find(seq)==m_seqRetxCounts.end()){
- *      m_seqRetxCounts[seq]=0;
- *   }
- * before calling WillSendOutInterest in ndn-consumer, the problem is solved. 
- * Other applications however might not expect this change in the consumer behaviour, thus the change is not active
- * todo: find another way to distinguish among first transmission and retransmission
+ * In order to distinguish among first transmission and retransmission, WillSendOutInterest checks whether
+ * ndn-consumer already stores a state for the sequence number (m_seqStates), before calling
+ * Consumer::WillSendOutInterest which creates it.
  *
  */
 
@@ -46,6 +40,8 @@
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
 #include <assert.h>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerStreaming");
@@ -107,6 +103,16 @@ ConsumerStreaming::GetTypeId(void)
                   UintegerValue(1040),
                   MakeUintegerAccessor(&ConsumerStreaming::m_payloadSize),
                   MakeUintegerChecker<uint32_t>())
+    .AddAttribute("LazyPlayback", "Compute playback from the arrival log, scheduling events only "
+                  "when the playback may stall or has to free buffer space, instead of one event "
+                  "per played packet",
+                  BooleanValue(true),
+                  MakeBooleanAccessor(&ConsumerStreaming::m_lazyPlayback),
+                  MakeBooleanChecker())
+    .AddAttribute("RestartDelay", "Delay (seconds) before downloading again after a failure",
+                  StringValue("ns3::UniformRandomVariable[Min=1.0|Max=5.0]"),
+                  MakePointerAccessor(&ConsumerStreaming::m_restartDelay),
+                  MakePointerChecker<RandomVariableStream>())
     .AddAttribute("PathForTrace", "The path to a folder where you want to keep your trace, default .",
                   StringValue("none"), MakeStringAccessor(&ConsumerStreaming::m_filepath),
                   MakeStringChecker())
@@ -119,6 +125,7 @@ ConsumerStreaming::ConsumerStreaming()
 , m_payloadSize(1040)
 , m_playBitRate(1000000)//1000000 <-> 480p //2500000 <-> 720p video
 , m_secondsOfBuffer(1)
+, m_lazyPlayback(true)
 , m_inFlight(0)
 , m_numberOfFailure(0)
 , m_ssthresh(50)
@@ -152,8 +159,13 @@ ConsumerStreaming::StartApplication(){
     m_interestNoRetxSent = 0;
     m_interestNoRetxSent = 0;
   
-    Simulator::Schedule(Seconds(m_secondsOfBuffer), &ConsumerStreaming::Play, this);
+    m_playPeriod = Seconds(1.0/m_playPktPerSecond);
+    m_playStartTime = Simulator::Now() + Seconds(m_secondsOfBuffer);
+    m_playStartIndex = 0;
+    m_playableEnd = 0;
+
     Consumer::StartApplication();
+    SchedulePlay();
     m_startingTime = Simulator::Now();
     NS_LOG_INFO("Second of buffer: " << m_secondsOfBuffer << " -> pkt/sec " << m_playPktPerSecond);
   
@@ -175,11 +187,10 @@ ConsumerStreaming::Reset(){
     }
     m_retxSeqs.clear();
     m_seqTimeouts.clear();
-    m_seqLastDelay.clear();
-    m_seqFullDelay.clear();
-    m_seqRetxCounts.clear();
+    m_seqStates.clear();
     
     m_playPktPerSecond = (int) (m_playBitRate/8)/m_payloadSize;
+    m_playPeriod = Seconds(1.0/m_playPktPerSecond);
     m_buffer = std::vector<uint32_t>(m_secondsOfBuffer*m_playPktPerSecond);
     for(uint32_t i=0; i<m_buffer.size(); i++){
         m_buffer[i]=std::numeric_limits<uint32_t>::max();
@@ -199,10 +210,12 @@ ConsumerStreaming::Reset(){
     m_nextIncrement = Seconds(0);
     m_inFlightCongestion = 0;
     
-    Ptr<UniformRandomVariable> delay=CreateObject<UniformRandomVariable>();
-    double nexRestart = delay->GetValue(1.0, 5.0);
+    double nexRestart = m_restartDelay->GetValue();
     
-    Simulator::Schedule(Seconds(nexRestart+m_secondsOfBuffer), &ConsumerStreaming::Play, this);
+    m_playStartTime = Simulator::Now() + Seconds(nexRestart+m_secondsOfBuffer);
+    m_playStartIndex = m_playIndex;
+    m_playableEnd = m_playIndex;
+    SchedulePlay();
     //Consumer::StartApplication();
     
     Simulator::Schedule(Seconds(nexRestart), &ConsumerStreaming::ScheduleNextPacket, this); //we will start in 1 second
@@ -217,24 +230,69 @@ ConsumerStreaming::Reset(){
     m_interestSentOld = 0;*/
 }
 
+Time
+ConsumerStreaming::GetPlayTime(uint32_t index) const
+{
+    // same as adding the period once per played packet
+    return m_playStartTime + TimeStep(m_playPeriod.GetTimeStep() * static_cast<int64_t>(index - m_playStartIndex));
+}
+
+bool
+ConsumerStreaming::UpdatePlayback()
+{
+    bool wasFull = false;
+    Time now = Simulator::Now();
+    
+    // play the packets whose time has come, as long as they have been received
+    while (m_playIndex < m_playableEnd && GetPlayTime(m_playIndex) <= now) {
+        NS_LOG_INFO("Playing " << m_playIndex);
+        m_buffer[m_playIndex%m_buffer.size()] = std::numeric_limits<uint32_t>::max();
+        m_dataPlayed++;
+        m_playIndex++;
+        m_dataBufferCounter--;
+        
+        if(m_bufferFull){
+            NS_LOG_DEBUG("The buffer was full " << m_dataBufferCounter);
+            wasFull = true;
+        }
+        m_bufferFull = false;
+    }
+    return wasFull;
+}
+
 void
-ConsumerStreaming::Play()
+ConsumerStreaming::SchedulePlay()
 {
     if(!m_active){
         return;
     }
-
     
-    if(m_buffer[m_playIndex%m_buffer.size()] == m_playIndex){
-        NS_LOG_INFO("Playing " << m_buffer[m_playIndex%m_buffer.size()]);
-        // std::cout<<GetId()<< "Playing " << m_buffer[m_playIndex%m_buffer.size()] << std::endl;
-        m_buffer[m_playIndex%m_buffer.size()] = std::numeric_limits<uint32_t>::max();
-        m_dataPlayed++;
-    } else  if (m_buffer[m_playIndex%m_buffer.size()]<m_playIndex){
-        //it should'n happen. something wrong (it never happend so far)
-        std::cout<<"something wrong, we have data already played in the buffer"<<std::endl;
+    // Playback only needs to be checked when the first missing packet is due (stall), or when
+    // the next packet is due if the buffer is full (sending resumes). Without lazy playback,
+    // every packet is played by its own event.
+    uint32_t index = (m_lazyPlayback && !m_bufferFull) ? m_playableEnd : m_playIndex;
+    Time delay = GetPlayTime(index) - Simulator::Now();
+    
+    if (m_playEvent.IsRunning()) {
+        if (Simulator::GetDelayLeft(m_playEvent) <= delay) {
+            // the event rechecks the playback and schedules the next one
+            return;
+        }
+        Simulator::Remove(m_playEvent);
+    }
+    m_playEvent = Simulator::Schedule(delay, &ConsumerStreaming::Play, this);
+}
+
+void
+ConsumerStreaming::Play()
+{
+    if(!m_active){
+        return;
     }
-    else{
+    
+    bool wasFull = UpdatePlayback();
+    
+    if(GetPlayTime(m_playIndex) <= Simulator::Now()){
         //failure!
         NS_LOG_INFO("Download failed, we were too slow. Data pkts played till now: " << m_playIndex << " " <<m_buffer[m_playIndex%m_buffer.size()] );
         //NS_LOG_INFO("Statistics: Total bytes downloaded before stopping " << (m_playIndex+m_dataBufferCounter)*m_payloadSize);
@@ -251,18 +309,12 @@ ConsumerStreaming::Play()
         
         return;
     }
-    m_playIndex++;
-    m_dataBufferCounter--;
     
-    if(m_bufferFull){
-        NS_LOG_DEBUG("The buffer was full " << m_dataBufferCounter);
-        Simulator::ScheduleNow(&ConsumerStreaming::ScheduleNextPacket, this);
-    } else {
-        NS_LOG_DEBUG("The buffer was NOT full " << m_dataBufferCounter);
+    if(wasFull){
+        ScheduleNextPacket();
     }
-    m_bufferFull = false;
     
-    Simulator::Schedule(Seconds(1.0/m_playPktPerSecond), &ConsumerStreaming::Play, this);
+    SchedulePlay();
 }
 
 void
@@ -328,6 +380,8 @@ ConsumerStreaming::SetSeqMax(uint32_t seqMax)
 
 bool
 ConsumerStreaming::CheckBufferSpace(){
+    UpdatePlayback();
+    
     //std::cout<<GetId()<< " m_dataBufferCounter " << m_dataBufferCounter  << " m_retxSeqs.size " << m_retxSeqs.size() << " m_inFlight " << m_inFlight  << " m_buffer.size() " << m_buffer.size()<< std::endl;
     if(m_dataBufferCounter+m_retxSeqs.size()+m_inFlight+1>=m_buffer.size()){
         //buffer is full
@@ -336,6 +390,7 @@ ConsumerStreaming::CheckBufferSpace(){
                      " inFlight " << m_inFlight <<
                      " Total: "<< m_dataBufferCounter+m_retxSeqs.size()+m_inFlight);
         m_bufferFull = true;
+        SchedulePlay(); //sending resumes when the next packet is played
     } else {
         NS_LOG_DEBUG("Buffer has still some space inBuffer" << m_dataBufferCounter <<
                      " Retx queue: " << m_retxSeqs.size() <<
@@ -402,6 +457,7 @@ ConsumerStreaming::OnData(shared_ptr<const Data> contentObject)
     m_dataPkt++;
   
     Consumer::OnData(contentObject);
+    UpdatePlayback();
   
     uint32_t seq = contentObject->getName().at(-1).toSequenceNumber();
     if(seq<m_playIndex){
@@ -426,6 +482,9 @@ ConsumerStreaming::OnData(shared_ptr<const Data> contentObject)
     NS_LOG_DEBUG("previous value " << m_buffer[seq%m_buffer.size()] << " compared against " << std::numeric_limits<uint32_t>::max());
     m_buffer[seq%m_buffer.size()] = seq;
     m_dataBufferCounter++;
+    while(m_playableEnd < m_playIndex + m_buffer.size() && m_buffer[m_playableEnd%m_buffer.size()] == m_playableEnd){
+        m_playableEnd++;
+    }
     NS_LOG_INFO("Data: " << m_buffer[seq%m_buffer.size()]<< " total: " << m_dataBufferCounter << " prec " <<m_buffer[(seq-1)%m_buffer.size()]);
     
     //if we want to make the playback start again after a failure, we should do something here
@@ -480,14 +539,11 @@ ConsumerStreaming::OnTimeout(uint32_t sequenceNumber)
 void
 ConsumerStreaming::WillSendOutInterest(uint32_t sequenceNumber)
 {
-    if(m_seqRetxCounts.find(sequenceNumber)==m_seqRetxCounts.end()){
-      m_seqRetxCounts[sequenceNumber]=0; //ndn-consumer doesn't initialize m_seqRetxCounts
-    }
+    bool isFirstTransmission = m_seqStates.find(sequenceNumber) == nullptr;
   
     m_interestSent++;
-    //std::cout <<GetId()<< " sequenceNumber " << m_seqRetxCounts[sequenceNumber]<< " - " << sequenceNumber << " inflight " << m_inFlight << " buffer " <<m_dataBufferCounter <<std::endl;
     m_inFlight++;
-    if(m_seqRetxCounts[sequenceNumber]==0){
+    if(isFirstTransmission){
         m_interestNoRetxSent++;
         m_inFlightCongestion++;
     }
@@ -498,6 +554,8 @@ void
 ConsumerStreaming::StopApplication()
 {
     NS_LOG_INFO("StopApplication Failueres: " <<m_numberOfFailure);
+    UpdatePlayback();
+    Simulator::Cancel(m_playEvent);
     if(m_numberOfFailure==0){
         m_onDownloadSuccess(GetId(),
                             (m_playIndex+m_dataBufferCounter-m_offset)*m_payloadSize,
@@ -525,6 +583,10 @@ ConsumerStreaming::WriteConsumerTrace(bool isInitialize)
     return;
   if(!isInitialize && !m_stop_tracing)
   {
+    if(UpdatePlayback()){
+        ScheduleNextPacket();
+    }
+    
     //double rate = 0.0, av_rate = 0.0;
     //double elapsed = Simulator::Now().GetSeconds() - m_start_period.GetSeconds();
     //double total_elapsed = Simulator::Now().GetSeconds() - m_start_time.GetSeconds();
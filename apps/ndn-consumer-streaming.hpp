@@ -101,6 +101,25 @@ private:
     void
     SetSeqMax(uint32_t seqMax);
     
+    /**
+     * \brief Time at which the packet with the given index has to be played
+     */
+    Time
+    GetPlayTime(uint32_t index) const;
+    
+    /**
+     * \brief Play all received packets whose play time has come
+     * \return true if the buffer was full before packets were played
+     */
+    bool
+    UpdatePlayback();
+    
+    /**
+     * \brief Schedule the next playback event, when a stall may occur or sending has to resume
+     */
+    void
+    SchedulePlay();
+    
     void
     Play();
     
@@ -124,6 +143,13 @@ private:
     uint32_t m_playPktPerSecond;
     uint32_t m_playIndex;
     uint32_t m_maxSortIndex;
+    bool m_lazyPlayback;
+    Ptr<RandomVariableStream> m_restartDelay;
+    Time m_playPeriod; // time to play one packet
+    Time m_playStartTime; // time at which packet m_playStartIndex is played
+    uint32_t m_playStartIndex;
+    uint32_t m_playableEnd; //first packet from m_playIndex not yet received
+    EventId m_playEvent;
     bool m_bufferFull; //if true, the buffer is full, we have to wait to download more data
     uint32_t m_dataBufferCounter; //how many pkts we have received and not yet played
     
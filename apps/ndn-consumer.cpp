@@ -99,13 +99,14 @@ void
 Consumer::SetRetxTimer(Time retxTimer)
 {
   m_retxTimer = retxTimer;
+  m_retxTimerOrigin = Simulator::Now();
   if (m_retxEvent.IsRunning()) {
     // m_retxEvent.Cancel (); // cancel any scheduled cleanup events
     Simulator::Remove(m_retxEvent); // slower, but better for memory
   }
 
   // schedule even with new timeout
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
 }
 
 Time
@@ -114,11 +115,9 @@ Consumer::GetRetxTimer() const
   return m_retxTimer;
 }
 
-void
-Consumer::CheckRetxTimeout()
+Time
+Consumer::GetRto() const
 {
-  Time now = Simulator::Now();
-
   Time rto = m_rtt->RetransmitTimeout();
 
 #ifdef BUGFIXES
@@ -126,22 +125,74 @@ Consumer::CheckRetxTimeout()
     rto = m_MaxRTO;
   }
 #endif // BUGFIXES
+  return rto;
+}
+
+void
+Consumer::CheckRetxTimeout()
+{
+  Time now = Simulator::Now();
+
+  Time rto = GetRto();
   // NS_LOG_DEBUG ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
   while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    if (entry->time + rto <= now) // timeout expired?
+    const SeqTimeout& entry = m_seqTimeouts.front();
+    SeqState* state = m_seqStates.find(entry.seq);
+    if (state == nullptr || !state->isPending || state->pendingSince != entry.time) {
+      // Data received, or timeout already handled
+      m_seqTimeouts.pop_front();
+      continue;
+    }
+
+    if (entry.time + rto <= now) // timeout expired?
     {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
+      uint32_t seqNo = entry.seq;
+      state->isPending = false;
+      m_seqTimeouts.pop_front();
       OnTimeout(seqNo);
     }
     else
       break; // nothing else to do. All later packets need not be retransmitted
   }
 
-  m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
+  ScheduleRetxCheck();
+}
+
+void
+Consumer::ScheduleRetxCheck()
+{
+  while (!m_seqTimeouts.empty()) {
+    const SeqTimeout& entry = m_seqTimeouts.front();
+    SeqState* state = m_seqStates.find(entry.seq);
+    if (state != nullptr && state->isPending && state->pendingSince == entry.time) {
+      break;
+    }
+    m_seqTimeouts.pop_front();
+  }
+
+  if (m_seqTimeouts.empty()) {
+    // nothing to retransmit, a pending check finds nothing
+    return;
+  }
+
+  Time now = Simulator::Now();
+  Time deadline = std::max(m_seqTimeouts.front().time + GetRto(), now);
+
+  // align on the retransmission timer, as if timeouts were checked every m_retxTimer
+  int64_t period = m_retxTimer.GetTimeStep();
+  if (period > 0) {
+    int64_t nPeriods = ((deadline - m_retxTimerOrigin).GetTimeStep() + period - 1) / period;
+    deadline = m_retxTimerOrigin + TimeStep(nPeriods * period);
+  }
+
+  if (m_retxEvent.IsRunning()) {
+    if (Simulator::GetDelayLeft(m_retxEvent) <= deadline - now) {
+      return;
+    }
+    Simulator::Remove(m_retxEvent); // slower, but better for memory
+  }
+  m_retxEvent = Simulator::Schedule(deadline - now, &Consumer::CheckRetxTimeout, this);
 }
 
 // Application Methods
@@ -163,6 +214,7 @@ Consumer::StopApplication() // Called at time specified by Stop
 
   // cancel periodic packet generation
   Simulator::Cancel(m_sendEvent);
+  Simulator::Cancel(m_retxEvent);
 
   // cleanup base stuff
   App::StopApplication();
@@ -247,24 +299,23 @@ Consumer::OnData(shared_ptr<const Data> data)
     }
   }
 
-  SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
-  if (entry != m_seqLastDelay.end()) {
-    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - entry->time, hopCount);
-  }
+  SeqState* state = m_seqStates.find(seq);
+  if (state != nullptr) {
+    Time lastSent = state->lastSent;
+    Time firstSent = state->firstSent;
+    uint32_t retxCount = state->retxCount;
+    m_seqStates.erase(seq); // timeout entry is skipped
 
-  entry = m_seqFullDelay.find(seq);
-  if (entry != m_seqFullDelay.end()) {
-    m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
+    m_lastRetransmittedInterestDataDelay(this, seq, Simulator::Now() - lastSent, hopCount);
+    m_firstInterestDataDelay(this, seq, Simulator::Now() - firstSent, retxCount, hopCount);
   }
 
-  m_seqRetxCounts.erase(seq);
-  m_seqFullDelay.erase(seq);
-  m_seqLastDelay.erase(seq);
-
-  m_seqTimeouts.erase(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
+
+  // RTO may have decreased
+  ScheduleRetxCheck();
 }
 
 void
@@ -285,17 +336,113 @@ void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqStates.size() << " items");
+
+  SeqState& state = m_seqStates.insert(sequenceNumber);
+  if (state.retxCount == 0) {
+    state.firstSent = Simulator::Now();
+  }
+  if (!state.isPending) {
+    state.isPending = true;
+    state.pendingSince = Simulator::Now();
+    m_seqTimeouts.push_back(SeqTimeout(sequenceNumber, Simulator::Now()));
+  }
+  state.lastSent = Simulator::Now();
+  state.retxCount++;
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
-  m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
 
-  m_seqLastDelay.erase(sequenceNumber);
-  m_seqLastDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  ScheduleRetxCheck();
+}
 
-  m_seqRetxCounts[sequenceNumber]++;
+const size_t Consumer::SeqStatesContainer::INITIAL_CAPACITY;
+const size_t Consumer::SeqStatesContainer::MAX_CAPACITY;
 
-  m_rtt->SentSeq(SequenceNumber32(sequenceNumber), 1);
+Consumer::SeqStatesContainer::SeqStatesContainer()
+  : m_slots(INITIAL_CAPACITY)
+  , m_nUsed(0)
+{
+}
+
+Consumer::SeqState*
+Consumer::SeqStatesContainer::find(uint32_t seq)
+{
+  SeqState& slot = m_slots[seq & (m_slots.size() - 1)];
+  if (slot.isUsed && slot.seq == seq) {
+    return &slot;
+  }
+
+  if (!m_overflow.empty()) {
+    auto it = m_overflow.find(seq);
+    if (it != m_overflow.end()) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
+Consumer::SeqState&
+Consumer::SeqStatesContainer::insert(uint32_t seq)
+{
+  SeqState* state = find(seq);
+  if (state != nullptr) {
+    return *state;
+  }
+
+  SeqState* slot = &m_slots[seq & (m_slots.size() - 1)];
+  while (slot->isUsed && m_slots.size() < MAX_CAPACITY) {
+    resize(m_slots.size() * 2);
+    slot = &m_slots[seq & (m_slots.size() - 1)];
+  }
+  if (slot->isUsed) {
+    NS_LOG_DEBUG("Sequence number " << seq << " collides with " << slot->seq
+                 << " at maximum capacity");
+    slot = &m_overflow[seq];
+  }
+
+  *slot = SeqState();
+  slot->seq = seq;
+  slot->isUsed = true;
+  ++m_nUsed;
+  return *slot;
+}
+
+void
+Consumer::SeqStatesContainer::erase(uint32_t seq)
+{
+  SeqState& slot = m_slots[seq & (m_slots.size() - 1)];
+  if (slot.isUsed && slot.seq == seq) {
+    slot.isUsed = false;
+    --m_nUsed;
+  }
+  else if (m_overflow.erase(seq) > 0) {
+    --m_nUsed;
+  }
+}
+
+void
+Consumer::SeqStatesContainer::clear()
+{
+  for (SeqState& slot : m_slots) {
+    slot.isUsed = false;
+  }
+  m_overflow.clear();
+  m_nUsed = 0;
+}
+
+void
+Consumer::SeqStatesContainer::resize(size_t capacity)
+{
+  NS_LOG_DEBUG("Resizing sequence number states to " << capacity);
+
+  // sequence numbers distinct modulo the capacity are distinct modulo its double
+  std::vector<SeqState> slots(capacity);
+  for (const SeqState& slot : m_slots) {
+    if (slot.isUsed) {
+      slots[slot.seq & (capacity - 1)] = slot;
+    }
+  }
+  m_slots.swap(slots);
 }
 
 } // namespace ndn
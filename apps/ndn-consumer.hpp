@@ -34,11 +34,8 @@
 
 #include <set>
 #include <map>
-
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/tag.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/member.hpp>
+#include <deque>
+#include <vector>
 
 namespace ns3 {
 namespace ndn {
@@ -114,6 +111,17 @@ protected:
   void
   CheckRetxTimeout();
 
+  /**
+   * \brief Schedules CheckRetxTimeout at the earliest retransmission timeout of outstanding
+   * Interests, unless it is already scheduled earlier
+   *
+   * The check is aligned on multiples of the retransmission timer, so timeouts are detected
+   * at the same time as if they were checked periodically.  Must be called whenever an Interest
+   * is sent or the RTO decreases.
+   */
+  void
+  ScheduleRetxCheck();
+
   /**
    * \brief Modifies the frequency of checking the retransmission timeouts
    * \param retxTimer Timeout defining how frequent retransmission timeouts should be checked
@@ -128,6 +136,13 @@ protected:
   Time
   GetRetxTimer() const;
 
+private:
+  /**
+   * \brief Returns the current retransmission timeout, capped by MaxRTO if set
+   */
+  Time
+  GetRto() const;
+
 protected:
   Ptr<UniformRandomVariable> m_rand; ///< @brief nonce generator
 
@@ -136,6 +151,7 @@ protected:
   EventId m_sendEvent; ///< @brief EventId of pending "send packet" event
   Time m_retxTimer;    ///< @brief Currently estimated retransmission timer
   EventId m_retxEvent; ///< @brief Event to check whether or not retransmission should be performed
+  Time m_retxTimerOrigin; ///< @brief Time retransmission checks are aligned on
 
   Ptr<RttEstimator> m_rtt; ///< @brief RTT estimator
     
@@ -169,41 +185,98 @@ protected:
     uint32_t seq;
     Time time;
   };
-  /// @endcond
 
-  /// @cond include_hidden
-  class i_seq {
-  };
-  class i_timestamp {
+  /**
+   * \struct This struct contains the state of a sequence number, from its first transmission
+   * until its Data is received
+   */
+  struct SeqState {
+    SeqState()
+      : seq(0)
+      , isUsed(false)
+      , isPending(false)
+      , retxCount(0)
+    {
+    }
+
+    uint32_t seq;
+    bool isUsed;
+    bool isPending;    ///< \brief waiting for Data or retransmission timeout
+    Time pendingSince; ///< \brief transmission the retransmission timeout is counted from
+    Time firstSent;    ///< \brief first transmission
+    Time lastSent;     ///< \brief last transmission
+    uint32_t retxCount; ///< \brief number of transmissions
   };
-  /// @endcond
 
-  /// @cond include_hidden
   /**
-   * \struct This struct contains a multi-index for the set of SeqTimeout structs
+   * \brief Ring buffer of SeqState indexed by sequence number
+   *
+   * A sequence number is stored at its value modulo the capacity.  The capacity is doubled
+   * whenever two live sequence numbers collide, so that it covers the span of sequence numbers
+   * waiting for Data.  Beyond MAX_CAPACITY (e.g., a sequence number never satisfied while
+   * later ones are requested), colliding sequence numbers are stored in an ordered map instead.
    */
-  struct SeqTimeoutsContainer
-    : public boost::multi_index::
-        multi_index_container<SeqTimeout,
-                              boost::multi_index::
-                                indexed_by<boost::multi_index::
-                                             ordered_unique<boost::multi_index::tag<i_seq>,
-                                                            boost::multi_index::
-                                                              member<SeqTimeout, uint32_t,
-                                                                     &SeqTimeout::seq>>,
-                                           boost::multi_index::
-                                             ordered_non_unique<boost::multi_index::
-                                                                  tag<i_timestamp>,
-                                                                boost::multi_index::
-                                                                  member<SeqTimeout, Time,
-                                                                         &SeqTimeout::time>>>> {
+  class SeqStatesContainer {
+  public:
+    static const size_t INITIAL_CAPACITY = 64;
+    static const size_t MAX_CAPACITY = 16384;
+
+    SeqStatesContainer();
+
+    /**
+     * \brief Returns the state of the sequence number, or nullptr
+     */
+    SeqState*
+    find(uint32_t seq);
+
+    /**
+     * \brief Returns the state of the sequence number, created if needed
+     *
+     * Pointers to other states are invalidated
+     */
+    SeqState&
+    insert(uint32_t seq);
+
+    void
+    erase(uint32_t seq);
+
+    void
+    clear();
+
+    size_t
+    size() const
+    {
+      return m_nUsed;
+    }
+
+    /**
+     * \brief Returns the number of slots of the ring buffer
+     */
+    size_t
+    capacity() const
+    {
+      return m_slots.size();
+    }
+
+  private:
+    void
+    resize(size_t capacity);
+
+  private:
+    std::vector<SeqState> m_slots;
+    std::map<uint32_t, SeqState> m_overflow; ///< \brief states colliding at MAX_CAPACITY
+    size_t m_nUsed;
   };
+  /// @endcond
 
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  SeqStatesContainer m_seqStates; ///< \brief state of sequence numbers waiting for Data
 
-  SeqTimeoutsContainer m_seqLastDelay;
-  SeqTimeoutsContainer m_seqFullDelay;
-  std::map<uint32_t, uint32_t> m_seqRetxCounts;
+  /**
+   * \brief pending retransmission timeouts, in transmission order
+   *
+   * Entries of sequence numbers which received Data or were retransmitted are skipped lazily.
+   */
+  std::deque<SeqTimeout> m_seqTimeouts;
 
   TracedCallback<Ptr<App> /* app */, uint32_t /* seqno */, Time /* delay */, int32_t /*hop count*/>
     m_lastRetransmittedInterestDataDelay;
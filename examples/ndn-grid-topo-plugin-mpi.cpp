@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-grid-topo-plugin-mpi.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/mpi-interface.h"
+
+#ifndef NS3_MPI
+#error "ndn-grid-topo-plugin-mpi scenario can be compiled only if NS3_MPI is enabled"
+#endif
+
+namespace ns3 {
+
+/**
+ * This scenario simulates the grid topology of ndn-grid-topo-plugin (or any other topology in
+ * the annotated format), distributed over all MPI processes:
+ *
+ * (consumer) -- ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) ----- ( )
+ *     |          |         |
+ *    ( ) ------ ( ) -- (producer)
+ *
+ * Instead of the mpi-partition column of the topology file, nodes are assigned to the
+ * processes by the topology reader, which keeps the nodes connected by short links in the
+ * same process and balances the number of nodes between processes.
+ *
+ * FIB is populated using NdnGlobalRoutingHelper, for the nodes of each process.  Each process
+ * traces its own nodes, and the traces are merged into rate-trace.txt at the end.
+ *
+ * To run scenario and see what is happening, use the following command:
+ *
+ *     NS_LOG=TopologyPartitioner mpirun -np 2 ./waf --run=ndn-grid-topo-plugin-mpi
+ */
+
+int
+main(int argc, char* argv[])
+{
+  bool nullmsg = false;
+  std::string topology = "src/ndnSIM/examples/topologies/topo-grid-3x3.txt";
+  std::string consumer = "Node0";
+  std::string producer = "Node8";
+
+  CommandLine cmd;
+  cmd.AddValue("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+  cmd.AddValue("topology", "Topology file (annotated format)", topology);
+  cmd.AddValue("consumer", "Name of the consumer node", consumer);
+  cmd.AddValue("producer", "Name of the producer node", producer);
+  cmd.Parse(argc, argv);
+
+  // Distributed simulation setup; by default use granted time window algorithm.
+  if (nullmsg) {
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::NullMessageSimulatorImpl"));
+  }
+  else {
+    GlobalValue::Bind("SimulatorImplementationType",
+                      StringValue("ns3::DistributedSimulatorImpl"));
+  }
+
+  MpiInterface::Enable(&argc, &argv);
+
+  AnnotatedTopologyReader topologyReader("", 25);
+  topologyReader.SetFileName(topology);
+  topologyReader.SetPartitions(MpiInterface::GetSize());
+  topologyReader.Read();
+
+  // Install NDN stack on all nodes (nodes of other processes get no cache)
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  // Set BestRoute strategy
+  ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+  // Installing global routing interface on all nodes
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  // Install NDN applications (only installed by the process that owns the node)
+  std::string prefix = "/prefix";
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix(prefix);
+  consumerHelper.SetAttribute("Frequency", StringValue("100")); // 100 interests a second
+  consumerHelper.Install(Names::Find<Node>(consumer));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix(prefix);
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(Names::Find<Node>(producer));
+
+  // Add /prefix origins to ndn::GlobalRouter
+  ndnGlobalRoutingHelper.AddOrigins(prefix, Names::Find<Node>(producer));
+
+  // Calculate and install FIBs
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  ndn::L3RateTracer::InstallAll("rate-trace.txt", Seconds(1.0));
+
+  Simulator::Stop(Seconds(20.0));
+
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // close the per-process trace files before merging them
+  ndn::L3RateTracer::Destroy();
+  ndn::PartitionHelper::MergeTraceFiles("rate-trace.txt");
+
+  MpiInterface::Disable();
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
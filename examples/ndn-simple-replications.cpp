@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-simple-replications.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/ndnSIM/helper/ndn-replication-helper.hpp"
+
+namespace ns3 {
+
+/**
+ * This scenario runs several replications of the topology of ndn-simple in parallel:
+ *
+ *      +----------+     1Mbps      +--------+     1Mbps      +----------+
+ *      | consumer | <------------> | router | <------------> | producer |
+ *      +----------+         10ms   +--------+          10ms  +----------+
+ *
+ * Consumer sends Interests with exponentially distributed inter-arrival times, so that every
+ * replication, which uses its own random stream (RngRun), produces different results.
+ *
+ * Each replication writes its application delays to <outputPrefix>run<N>-app-delays-trace.txt
+ * and reports the number of Interests received by the producer and of Data received by the
+ * consumer, which are merged into <outputPrefix>summary.txt.
+ *
+ * To run 20 replications, 4 at a time:
+ *
+ *     ./waf --run="ndn-simple-replications --runs=20 --jobs=4"
+ */
+
+static int
+runReplication(uint32_t run, const std::string& prefix)
+{
+  // Creating nodes
+  NodeContainer nodes;
+  nodes.Create(3);
+
+  // Connecting nodes using two links
+  PointToPointHelper p2p;
+  p2p.Install(nodes.Get(0), nodes.Get(1));
+  p2p.Install(nodes.Get(1), nodes.Get(2));
+
+  // Install NDN stack on all nodes
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  // Consumer
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", StringValue("100"));
+  consumerHelper.SetAttribute("Randomize", StringValue("exponential"));
+  consumerHelper.Install(nodes.Get(0));
+
+  // Producer
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(2));
+
+  // Per-replication trace file
+  ndn::AppDelayTracer::InstallAll(prefix + "app-delays-trace.txt");
+
+  Simulator::Stop(Seconds(20.0));
+  Simulator::Run();
+
+  // Per-replication summary, merged over all replications
+  ndn::ReplicationHelper::Report("ProducerInInterests",
+    nodes.Get(2)->GetObject<ndn::L3Protocol>()->getForwarder()->getCounters().getNInInterests());
+  ndn::ReplicationHelper::Report("ConsumerInData",
+    nodes.Get(0)->GetObject<ndn::L3Protocol>()->getForwarder()->getCounters().getNInDatas());
+
+  // the replication process ends without destroying static objects: flush the trace file
+  ndn::AppDelayTracer::Destroy();
+  Simulator::Destroy();
+  return 0;
+}
+
+int
+main(int argc, char* argv[])
+{
+  // setting default parameters for PointToPoint links and channels
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  ndn::ReplicationHelper replications;
+  replications.SetOutputPrefix("ndn-simple-replications-");
+
+  CommandLine cmd;
+  replications.AddCommandLineOptions(cmd);
+  cmd.Parse(argc, argv);
+
+  return replications.Run(&runReplication);
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
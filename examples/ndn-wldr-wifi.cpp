@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-wldr-wifi.cpp
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+
+#include "ns3/ndnSIM-module.h"
+
+#ifdef WLDR
+#include "ns3/ndnSIM/NFD/daemon/face/wldr.hpp"
+#endif // WLDR
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("ndn.WldrWifiExample");
+
+/**
+ * This scenario compares end-to-end and link-layer (WLDR) recovery of wireless losses:
+ *
+ *      +----------+    802.11a adhoc    +----------+
+ *      | consumer | <~~~~~~~~~~~~~~~~~> | producer |
+ *      +----------+     <distance> m    +----------+
+ *
+ * Broadcast frames are not acknowledged by 802.11, so every frame lost on the channel is
+ * lost for NDN as well.  Without WLDR, the consumer recovers by retransmitting the Interest
+ * after its RTO.  With WLDR, the receiving face detects the gap in the link sequence numbers
+ * of the next frame and asks the sender to retransmit the missing one, within one link RTT.
+ *
+ * Consumer requests <maxSeq> Data packets of 1200 bytes at 100 Interests per second.  At the
+ * end, the scenario prints the completion time, the number of consumer retransmissions and
+ * the WLDR counters of all faces.
+ *
+ * To compare both recovery mechanisms (ndnSIM compiled with WLDR):
+ *
+ *     ./waf --run="ndn-wldr-wifi --distance=110 --wldr=0"
+ *     ./waf --run="ndn-wldr-wifi --distance=110 --wldr=1"
+ */
+
+static Time g_lastData;
+static uint64_t g_nData = 0;
+static uint64_t g_nRetransmissions = 0;
+
+static void
+FirstInterestDataDelay(Ptr<ndn::App> app, uint32_t seqno, Time delay, uint32_t retxCount,
+                       int32_t hopCount)
+{
+  g_lastData = Simulator::Now();
+  ++g_nData;
+  g_nRetransmissions += retxCount - 1;
+}
+
+int
+main(int argc, char* argv[])
+{
+  // disable fragmentation
+  Config::SetDefault("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue("2200"));
+  Config::SetDefault("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue("2200"));
+  Config::SetDefault("ns3::WifiRemoteStationManager::NonUnicastMode",
+                     StringValue("OfdmRate24Mbps"));
+
+  bool enableWldr = true;
+  double distance = 100;
+  uint32_t maxSeq = 1000;
+
+  CommandLine cmd;
+  cmd.AddValue("wldr", "Enable WLDR on wifi faces", enableWldr);
+  cmd.AddValue("distance", "Distance between consumer and producer (m)", distance);
+  cmd.AddValue("maxSeq", "Number of Data packets requested by consumer", maxSeq);
+  cmd.Parse(argc, argv);
+
+  WifiHelper wifi = WifiHelper::Default();
+  wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode",
+                               StringValue("OfdmRate24Mbps"));
+
+  YansWifiChannelHelper wifiChannel;
+  wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+  wifiChannel.AddPropagationLoss("ns3::ThreeLogDistancePropagationLossModel");
+  wifiChannel.AddPropagationLoss("ns3::NakagamiPropagationLossModel");
+
+  YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default();
+  wifiPhyHelper.SetChannel(wifiChannel.Create());
+  wifiPhyHelper.Set("TxPowerStart", DoubleValue(5));
+  wifiPhyHelper.Set("TxPowerEnd", DoubleValue(5));
+
+  NqosWifiMacHelper wifiMacHelper = NqosWifiMacHelper::Default();
+  wifiMacHelper.SetType("ns3::AdhocWifiMac");
+
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+  positions->Add(Vector(0, 0, 0));
+  positions->Add(Vector(distance, 0, 0));
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator(positions);
+  mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+
+  NodeContainer nodes;
+  nodes.Create(2);
+
+  wifi.Install(wifiPhyHelper, wifiMacHelper, nodes);
+  mobility.Install(nodes);
+
+  ndn::StackHelper ndnHelper;
+#ifdef WLDR
+  if (enableWldr) {
+    ndnHelper.EnableWldr(WifiNetDevice::GetTypeId());
+  }
+#else
+  if (enableWldr) {
+    NS_LOG_UNCOND("ndnSIM compiled without WLDR, running with end-to-end recovery only");
+  }
+#endif // WLDR
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.Install(nodes);
+
+  ndn::StrategyChoiceHelper::Install(nodes, "/", "/localhost/nfd/strategy/best-route");
+
+  ndn::AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/test/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(100.0));
+  consumerHelper.SetAttribute("MaxSeq", IntegerValue(maxSeq - 1));
+  ApplicationContainer consumer = consumerHelper.Install(nodes.Get(0));
+  consumer.Get(0)->TraceConnectWithoutContext("FirstInterestDataDelay",
+                                               MakeCallback(&FirstInterestDataDelay));
+
+  ndn::AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1200"));
+  producerHelper.Install(nodes.Get(1));
+
+  Simulator::Stop(Seconds(maxSeq / 100.0 + 60.0));
+  Simulator::Run();
+
+  std::cout << "Data received:          " << g_nData << "/" << maxSeq << std::endl;
+  std::cout << "Completion time:        " << g_lastData.GetSeconds() << "s" << std::endl;
+  std::cout << "Consumer retransmissions: " << g_nRetransmissions << std::endl;
+
+#ifdef WLDR
+  uint64_t nLosses = 0, nRecovered = 0, nUnrecoverable = 0, nRetransmissions = 0;
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); ++node) {
+    Ptr<ndn::L3Protocol> ndn = (*node)->GetObject<ndn::L3Protocol>();
+    for (const auto& face : ndn->getForwarder()->getFaceTable()) {
+      auto netDeviceFace = std::dynamic_pointer_cast<ndn::NetDeviceFace>(face);
+      if (netDeviceFace == nullptr || netDeviceFace->getWldr() == nullptr) {
+        continue;
+      }
+      const nfd::Wldr& wldr = *netDeviceFace->getWldr();
+      nLosses += wldr.getNLosses();
+      nRecovered += wldr.getNRecovered();
+      nUnrecoverable += wldr.getNUnrecoverable();
+      nRetransmissions += wldr.getNRetransmissions();
+    }
+  }
+  std::cout << "WLDR losses detected:   " << nLosses << std::endl;
+  std::cout << "WLDR losses recovered:  " << nRecovered << std::endl;
+  std::cout << "WLDR unrecoverable:     " << nUnrecoverable << std::endl;
+  std::cout << "WLDR retransmissions:   " << nRetransmissions << std::endl;
+#endif // WLDR
+
+  Simulator::Destroy();
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  return ns3::main(argc, argv);
+}
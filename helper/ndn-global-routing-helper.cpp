@@ -27,6 +27,7 @@
 
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-partition-helper.hpp"
 #include "model/ndn-net-device-face.hpp"
 #include "model/ndn-global-router.hpp"
 
@@ -265,6 +266,10 @@ GlobalRoutingHelper::CalculateRoutes()
       continue;
     }
 
+    // FIBs of nodes simulated by other logical processes are not used
+    if (!PartitionHelper::IsLocal(*node))
+      continue;
+
     boost::DistancesMap distances;
 
     dijkstra_shortest_paths(graph, source,
@@ -330,6 +335,10 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes()
       continue;
     }
 
+    // FIBs of nodes simulated by other logical processes are not used
+    if (!PartitionHelper::IsLocal(*node))
+      continue;
+
     Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
     shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
 
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-partition-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#include <mpi.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE("ndn.PartitionHelper");
+
+namespace ns3 {
+namespace ndn {
+
+bool
+PartitionHelper::IsLocal(Ptr<Node> node)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled()) {
+    return node->GetSystemId() == MpiInterface::GetSystemId();
+  }
+#endif
+  return true;
+}
+
+NodeContainer
+PartitionHelper::GetLocalNodes()
+{
+  NodeContainer nodes;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (IsLocal(*node))
+      nodes.Add(*node);
+  }
+  return nodes;
+}
+
+std::string
+PartitionHelper::GetRankFileName(const std::string& file)
+{
+#ifdef NS3_MPI
+  if (MpiInterface::IsEnabled() && file != "-") {
+    return file + "." + boost::lexical_cast<std::string>(MpiInterface::GetSystemId());
+  }
+#endif
+  return file;
+}
+
+void
+PartitionHelper::MergeTraceFiles(const std::string& file)
+{
+#ifdef NS3_MPI
+  if (!MpiInterface::IsEnabled() || file == "-")
+    return;
+
+  // wait until all logical processes have closed their files
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  if (MpiInterface::GetSystemId() != 0)
+    return;
+
+  std::string header;
+  std::vector<std::pair<double, std::string>> records;
+
+  for (uint32_t systemId = 0; systemId < MpiInterface::GetSize(); systemId++) {
+    std::string rankFile = file + "." + boost::lexical_cast<std::string>(systemId);
+    std::ifstream is(rankFile.c_str());
+    if (!is.is_open()) {
+      NS_LOG_WARN("Trace file " << rankFile << " does not exist");
+      continue;
+    }
+
+    std::string line;
+    bool isFirstLine = true;
+    while (std::getline(is, line)) {
+      if (line.empty())
+        continue;
+
+      if (isFirstLine) {
+        isFirstLine = false;
+        header = line;
+        continue;
+      }
+
+      double time = 0;
+      std::istringstream(line) >> time;
+      records.push_back(std::make_pair(time, line));
+    }
+    is.close();
+    std::remove(rankFile.c_str());
+  }
+
+  // stable, so that records of one logical process at the same time stay in order
+  std::stable_sort(records.begin(), records.end(),
+                   [] (const std::pair<double, std::string>& a,
+                       const std::pair<double, std::string>& b) { return a.first < b.first; });
+
+  std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing");
+    return;
+  }
+
+  os << header << "\n";
+  for (const auto& record : records) {
+    os << record.second << "\n";
+  }
+#endif
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_PARTITION_HELPER_H
+#define NDN_PARTITION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper class for scenarios distributed over several logical processes (MPI)
+ *
+ * Nodes are assigned to logical processes by their system id, e.g., using
+ * AnnotatedTopologyReader::SetPartitions.  Each logical process only simulates its local
+ * nodes.  When MPI is not enabled, all nodes are local.
+ */
+class PartitionHelper {
+public:
+  /**
+   * @brief Check whether @p node is simulated by this logical process
+   */
+  static bool
+  IsLocal(Ptr<Node> node);
+
+  /**
+   * @brief Get all nodes simulated by this logical process
+   */
+  static NodeContainer
+  GetLocalNodes();
+
+  /**
+   * @brief Get the name of the file that this logical process should write to
+   *
+   * When MPI is enabled, each logical process writes its own <file>.<systemId> file, which
+   * can be merged afterwards with MergeTraceFiles.  Otherwise, @p file is returned unchanged.
+   */
+  static std::string
+  GetRankFileName(const std::string& file);
+
+  /**
+   * @brief Merge the trace files written by all logical processes into @p file
+   *
+   * Must be called by all logical processes, after the tracers writing the files have been
+   * destroyed (e.g., after L3RateTracer::Destroy or Simulator::Destroy).  The first logical
+   * process concatenates the files, keeps a single header line, orders the records by their
+   * first (time) column, and removes the per-process files.  Does nothing when MPI is not
+   * enabled.
+   */
+  static void
+  MergeTraceFiles(const std::string& file);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_PARTITION_HELPER_H
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-replication-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/command-line.h"
+#include "ns3/rng-seed-manager.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <set>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ReplicationHelper");
+
+namespace ns3 {
+namespace ndn {
+
+std::string ReplicationHelper::s_summaryFile;
+
+ReplicationHelper::ReplicationHelper()
+  : m_nRuns(10)
+  , m_firstRun(1)
+  , m_nJobs(std::max(std::thread::hardware_concurrency(), 1u))
+  , m_outputPrefix("replication-")
+{
+}
+
+void
+ReplicationHelper::SetRuns(uint32_t nRuns)
+{
+  m_nRuns = nRuns;
+}
+
+void
+ReplicationHelper::SetFirstRun(uint32_t firstRun)
+{
+  m_firstRun = firstRun;
+}
+
+void
+ReplicationHelper::SetJobs(uint32_t nJobs)
+{
+  NS_ASSERT(nJobs > 0);
+  m_nJobs = nJobs;
+}
+
+void
+ReplicationHelper::SetOutputPrefix(const std::string& prefix)
+{
+  m_outputPrefix = prefix;
+}
+
+void
+ReplicationHelper::AddCommandLineOptions(CommandLine& cmd)
+{
+  cmd.AddValue("runs", "Number of replications", m_nRuns);
+  cmd.AddValue("firstRun", "Run number (RngRun) of the first replication", m_firstRun);
+  cmd.AddValue("jobs", "Maximum number of replications running in parallel", m_nJobs);
+  cmd.AddValue("outputPrefix", "Prefix of replication output files", m_outputPrefix);
+}
+
+std::string
+ReplicationHelper::GetRunPrefix(uint32_t run) const
+{
+  return m_outputPrefix + "run" + std::to_string(run) + "-";
+}
+
+int
+ReplicationHelper::Run(const Scenario& scenario)
+{
+  NS_LOG_FUNCTION(this << m_nRuns << m_firstRun << m_nJobs << m_outputPrefix);
+
+  std::map<pid_t, uint32_t> running;
+  std::vector<uint32_t> succeeded;
+  uint32_t nFailed = 0;
+  uint32_t nextRun = m_firstRun;
+  uint32_t endRun = m_firstRun + m_nRuns;
+
+  while (nextRun != endRun || !running.empty()) {
+    if (nextRun != endRun && running.size() < std::max(m_nJobs, 1u)) {
+      // buffered output would otherwise be written by both processes
+      std::cout.flush();
+      std::cerr.flush();
+      std::fflush(nullptr);
+
+      pid_t pid = fork();
+      if (pid < 0) {
+        NS_FATAL_ERROR("Cannot fork replication " << nextRun << ": " << std::strerror(errno));
+      }
+      if (pid == 0) {
+        RunChild(scenario, nextRun);
+        // not reached
+      }
+
+      NS_LOG_INFO("Started replication " << nextRun << " (pid " << pid << ")");
+      running[pid] = nextRun++;
+      continue;
+    }
+
+    int status = 0;
+    pid_t pid = waitpid(-1, &status, 0);
+    if (pid < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      NS_FATAL_ERROR("Cannot wait for replications: " << std::strerror(errno));
+    }
+
+    auto it = running.find(pid);
+    if (it == running.end()) {
+      continue;
+    }
+    uint32_t run = it->second;
+    running.erase(it);
+
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+      NS_LOG_INFO("Replication " << run << " finished");
+      succeeded.push_back(run);
+    }
+    else {
+      ++nFailed;
+      std::cerr << "Replication " << run << " failed, see " << m_outputPrefix << "run" << run
+                << ".log" << std::endl;
+    }
+  }
+
+  std::sort(succeeded.begin(), succeeded.end());
+  MergeSummaries(succeeded);
+
+  std::cout << succeeded.size() << " of " << m_nRuns << " replications succeeded, summary in "
+            << m_outputPrefix << "summary.txt" << std::endl;
+  return nFailed == 0 ? 0 : 1;
+}
+
+void
+ReplicationHelper::RunChild(const Scenario& scenario, uint32_t run)
+{
+  s_summaryFile = GetRunPrefix(run) + "summary.txt";
+  std::remove(s_summaryFile.c_str());
+
+  std::string logFile = m_outputPrefix + "run" + std::to_string(run) + ".log";
+  int fd = open(logFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    close(fd);
+  }
+
+  RngSeedManager::SetRun(run);
+  int status = 1;
+  try {
+    status = scenario(run, GetRunPrefix(run));
+  }
+  catch (const std::exception& e) {
+    std::cerr << "Replication " << run << " failed: " << e.what() << std::endl;
+  }
+  catch (...) {
+    std::cerr << "Replication " << run << " failed with an unknown exception" << std::endl;
+  }
+
+  // never return into the fork loop of Run, nor run the exit handlers of the parent
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+  _exit(status == 0 ? 0 : 1);
+}
+
+void
+ReplicationHelper::Report(const std::string& metric, double value)
+{
+  if (s_summaryFile.empty()) {
+    return;
+  }
+
+  std::ofstream os(s_summaryFile, std::ios::app);
+  os.precision(std::numeric_limits<double>::digits10 + 2);
+  os << metric << "\t" << value << "\n";
+}
+
+void
+ReplicationHelper::MergeSummaries(const std::vector<uint32_t>& runs)
+{
+  // metric => (samples, number of runs reporting it)
+  std::map<std::string, std::pair<std::vector<double>, uint32_t>> metrics;
+
+  for (uint32_t run : runs) {
+    std::ifstream is(GetRunPrefix(run) + "summary.txt");
+    std::set<std::string> reported;
+    std::string line;
+    while (std::getline(is, line)) {
+      size_t tab = line.rfind('\t');
+      if (tab == std::string::npos) {
+        continue;
+      }
+      std::string metric = line.substr(0, tab);
+      metrics[metric].first.push_back(std::strtod(line.c_str() + tab + 1, nullptr));
+      if (reported.insert(metric).second) {
+        ++metrics[metric].second;
+      }
+    }
+  }
+
+  std::ofstream os(m_outputPrefix + "summary.txt");
+  os << "Metric"
+     << "\t"
+     << "Runs"
+     << "\t"
+     << "Samples"
+     << "\t"
+     << "Mean"
+     << "\t"
+     << "StdDev"
+     << "\t"
+     << "Min"
+     << "\t"
+     << "Max"
+     << "\n";
+
+  for (const auto& metric : metrics) {
+    const std::vector<double>& samples = metric.second.first;
+
+    double sum = 0;
+    for (double sample : samples) {
+      sum += sample;
+    }
+    double mean = sum / samples.size();
+
+    double sumSquares = 0;
+    for (double sample : samples) {
+      sumSquares += (sample - mean) * (sample - mean);
+    }
+    double stdDev = samples.size() > 1 ? std::sqrt(sumSquares / (samples.size() - 1)) : 0;
+
+    os << metric.first << "\t"
+       << metric.second.second << "\t"
+       << samples.size() << "\t"
+       << mean << "\t"
+       << stdDev << "\t"
+       << *std::min_element(samples.begin(), samples.end()) << "\t"
+       << *std::max_element(samples.begin(), samples.end()) << "\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_REPLICATION_HELPER_H
+#define NDN_REPLICATION_HELPER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+class CommandLine;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Helper to run independent replications of a scenario in parallel
+ *
+ * ns-3 Simulator is a process-wide singleton, so replications cannot share a process.  The
+ * helper forks one child process per replication, keeping at most a given number of them
+ * running at the same time.  Each child:
+ *
+ * - selects its own random stream with RngSeedManager::SetRun, using consecutive run numbers
+ *   starting from the first run, so that no two replications share random numbers;
+ * - redirects its standard output and error to `<prefix>run<N>.log`;
+ * - runs the scenario callback, which receives the run number and a per-run file prefix
+ *   (`<prefix>run<N>-`) to use for tracer output.
+ *
+ * Scalar results can be reported from the scenario with ReplicationHelper::Report.  Once all
+ * replications are finished, the helper merges them into `<prefix>summary.txt`, with the
+ * number of runs, mean, standard deviation, minimum and maximum of each metric.
+ *
+ * The whole scenario, including topology and applications, must be created inside the
+ * callback, after the run number has been selected.  A replication fails if the callback
+ * returns a non-zero status or throws.  The child process ends with _exit once the callback
+ * returns, without destroying static objects, so the callback must destroy the tracers it
+ * installed to flush their files:
+ *
+ *     int
+ *     main(int argc, char* argv[])
+ *     {
+ *       ndn::ReplicationHelper replications;
+ *       CommandLine cmd;
+ *       replications.AddCommandLineOptions(cmd);
+ *       cmd.Parse(argc, argv);
+ *
+ *       return replications.Run([] (uint32_t run, const std::string& prefix) {
+ *           ... // create topology and applications
+ *           ndn::L3RateTracer::InstallAll(prefix + "rate-trace.txt", Seconds(1.0));
+ *           Simulator::Run();
+ *           ndn::ReplicationHelper::Report("InterestsSent", ...);
+ *           ndn::L3RateTracer::Destroy();
+ *           Simulator::Destroy();
+ *           return 0;
+ *         });
+ *     }
+ */
+class ReplicationHelper {
+public:
+  /**
+   * @brief Scenario executed by each replication
+   * @param run run number (RngRun) of the replication
+   * @param prefix file name prefix for the outputs of the replication
+   * @return exit status of the replication, 0 on success
+   */
+  typedef std::function<int(uint32_t run, const std::string& prefix)> Scenario;
+
+  ReplicationHelper();
+
+  /**
+   * @brief Set number of replications (default 10)
+   */
+  void
+  SetRuns(uint32_t nRuns);
+
+  /**
+   * @brief Set run number of the first replication (default 1)
+   */
+  void
+  SetFirstRun(uint32_t firstRun);
+
+  /**
+   * @brief Set maximum number of replications running at the same time
+   *
+   * Defaults to the number of hardware threads
+   */
+  void
+  SetJobs(uint32_t nJobs);
+
+  /**
+   * @brief Set prefix of all output files (default "replication-")
+   *
+   * The prefix may contain a directory, which must exist
+   */
+  void
+  SetOutputPrefix(const std::string& prefix);
+
+  /**
+   * @brief Register --runs, --firstRun, --jobs and --outputPrefix options
+   *
+   * The helper must outlive the call to CommandLine::Parse
+   */
+  void
+  AddCommandLineOptions(CommandLine& cmd);
+
+  /**
+   * @brief Run all replications and merge their summaries
+   * @return 0 if all replications succeeded, 1 otherwise
+   */
+  int
+  Run(const Scenario& scenario);
+
+  /**
+   * @brief Report a scalar result of the current replication
+   *
+   * Values reported several times with the same name in one replication are merged as
+   * separate samples.  Outside of a replication, the call is ignored.
+   */
+  static void
+  Report(const std::string& metric, double value);
+
+private:
+  void
+  RunChild(const Scenario& scenario, uint32_t run);
+
+  std::string
+  GetRunPrefix(uint32_t run) const;
+
+  void
+  MergeSummaries(const std::vector<uint32_t>& runs);
+
+private:
+  uint32_t m_nRuns;
+  uint32_t m_firstRun;
+  uint32_t m_nJobs;
+  std::string m_outputPrefix;
+
+  static std::string s_summaryFile; ///< @brief summary file of the current replication
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REPLICATION_HELPER_H
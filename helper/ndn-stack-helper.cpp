@@ -27,8 +27,10 @@
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
 #include "utils/ndn-time.hpp"
+#include "utils/ndn-nonce-generator.hpp"
 #include "utils/dummy-keychain.hpp"
 #include "model/cs/ndn-content-store.hpp"
+#include "helper/ndn-partition-helper.hpp"
 
 #include <limits>
 #include <map>
@@ -44,6 +46,7 @@ StackHelper::StackHelper()
   , m_maxCsSize(100)
 {
   setCustomNdnCxxClocks();
+  setCustomNdnCxxNonceGenerator();
 
   m_ndnFactory.SetTypeId("ns3::ndn::L3Protocol");
   m_contentStoreFactory.SetTypeId("ns3::ndn::cs::Lru");
@@ -72,6 +75,14 @@ StackHelper::setCustomNdnCxxClocks()
                                make_shared<ns3::ndn::time::CustomSystemClock>());
 }
 
+void
+StackHelper::setCustomNdnCxxNonceGenerator()
+{
+  // single instance, so that nonce streams are not reset by another StackHelper
+  static shared_ptr<NonceGenerator> generator = make_shared<NonceGenerator>();
+  ::ndn::random::setCustomNonceGenerator(generator);
+}
+
 void
 StackHelper::SetDefaultRoutes(bool needSet)
 {
@@ -149,10 +160,13 @@ StackHelper::Install(Ptr<Node> node) const
   }
 
   Ptr<L3Protocol> ndn = m_ndnFactory.Create<L3Protocol>();
-  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
+
+  // Nodes simulated by other logical processes only need faces for global routing, not a cache
+  bool isLocal = PartitionHelper::IsLocal(node);
+  ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0 || !isLocal) ? 1 : m_maxCsSize);
 
   // Create and aggregate content store if NFD's contest store has been disabled
-  if (m_maxCsSize == 0) {
+  if (m_maxCsSize == 0 && isLocal) {
     ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
   }
 
@@ -200,6 +214,14 @@ StackHelper::RemoveNetDeviceFaceCreateCallback(TypeId netDeviceType,
     });
 }
 
+#ifdef WLDR
+void
+StackHelper::EnableWldr(TypeId netDeviceType, size_t bufferSize, size_t maxRetransmissions)
+{
+  m_wldrNetDeviceTypes.push_back(std::make_tuple(netDeviceType, bufferSize, maxRetransmissions));
+}
+#endif // WLDR
+
 shared_ptr<NetDeviceFace>
 StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
                                       Ptr<NetDevice> netDevice) const
@@ -296,6 +318,16 @@ StackHelper::createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetD
     face = DefaultNetDeviceCallback(node, ndn, device);
   }
 
+#ifdef WLDR
+  for (const auto& item : m_wldrNetDeviceTypes) {
+    if (device->GetInstanceTypeId() == std::get<0>(item) ||
+        device->GetInstanceTypeId().IsChildOf(std::get<0>(item))) {
+      face->enableWldr(std::get<1>(item), std::get<2>(item));
+      break;
+    }
+  }
+#endif // WLDR
+
   if (m_needSetDefaultRoutes) {
     // default route with lowest priority possible
     FibHelper::AddRoute(node, "/", face, std::numeric_limits<int32_t>::max());
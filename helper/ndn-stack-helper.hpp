@@ -31,6 +31,12 @@
 #include "ndn-fib-helper.hpp"
 #include "ndn-strategy-choice-helper.hpp"
 
+#ifdef WLDR
+#include "ns3/ndnSIM/NFD/daemon/face/wldr.hpp"
+
+#include <tuple>
+#endif // WLDR
+
 namespace ns3 {
 
 class Node;
@@ -121,6 +127,20 @@ public:
   void
   RemoveNetDeviceFaceCreateCallback(TypeId netDeviceType, NetDeviceFaceCreateCallback callback);
 
+#ifdef WLDR
+  /**
+   * @brief Enable WLDR (Wireless Loss Detection and Recovery) on faces created for NetDevices
+   * of the given type (e.g., WifiNetDevice)
+   *
+   * @param netDeviceType TypeId of the NetDevice, or of one of its parents
+   * @param bufferSize number of sent packets kept for retransmission
+   * @param maxRetransmissions maximum number of link retransmissions of a packet
+   */
+  void
+  EnableWldr(TypeId netDeviceType, size_t bufferSize = WLDR_DEFAULT_BUFFER_SIZE,
+             size_t maxRetransmissions = WLDR_DEFAULT_MAX_RETX);
+#endif // WLDR
+
   /**
   * \brief Install Ndn stack on the node
   *
@@ -226,6 +246,13 @@ public:
   void
   setCustomNdnCxxClocks();
 
+  /**
+   * \brief Make Interest nonces reproducible, using a per-node stream seeded from RngSeed and
+   *        RngRun (\see NonceGenerator)
+   */
+  void
+  setCustomNdnCxxNonceGenerator();
+
 private:
   ObjectFactory m_ndnFactory;
   ObjectFactory m_contentStoreFactory;
@@ -235,6 +262,11 @@ private:
 
   typedef std::list<std::pair<TypeId, NetDeviceFaceCreateCallback>> NetDeviceCallbackList;
   NetDeviceCallbackList m_netDeviceCallbacks;
+
+#ifdef WLDR
+  // NetDevice type, buffer size, maximum retransmissions
+  std::list<std::tuple<TypeId, size_t, size_t>> m_wldrNetDeviceTypes;
+#endif // WLDR
 };
 
 } // namespace ndn
@@ -119,8 +119,11 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * The returned Data is the cached object itself (no copy is made on a hit), so it must not
+   * be modified.  Any per-hop changes should be applied to a copy.
    */
-  virtual shared_ptr<Data>
+  virtual shared_ptr<const Data>
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
@@ -24,6 +24,8 @@
 #include "ns3/node.h"
 #include "ns3/assert.h"
 #include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
 
 #include "apps/ndn-app.hpp"
 
@@ -32,6 +34,15 @@ NS_LOG_COMPONENT_DEFINE("ndn.AppFace");
 namespace ns3 {
 namespace ndn {
 
+static GlobalValue g_batchedDelivery =
+  GlobalValue("NdnAppFaceBatchedDelivery",
+              "Deliver all packets sent to the applications of a node at the same time in a "
+              "single event, instead of one event per packet",
+              BooleanValue(false), MakeBooleanChecker());
+
+std::map<uint32_t, AppFace::PendingQueue> AppFace::s_pending;
+bool AppFace::s_isCleanupScheduled = false;
+
 AppFace::AppFace(Ptr<App> app)
   : LocalFace(FaceUri("appFace://"), FaceUri("appFace://"))
   , m_node(app->GetNode())
@@ -40,6 +51,10 @@ AppFace::AppFace(Ptr<App> app)
   NS_LOG_FUNCTION(this << app);
 
   NS_ASSERT(m_app != 0);
+
+  BooleanValue isBatched;
+  g_batchedDelivery.GetValue(isBatched);
+  m_isBatched = isBatched.Get();
 }
 
 AppFace::~AppFace()
@@ -61,7 +76,12 @@ AppFace::sendInterest(const Interest& interest)
   this->emitSignal(onSendInterest, interest);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  if (m_isBatched) {
+    enqueue(interest.shared_from_this(), nullptr);
+  }
+  else {
+    Simulator::ScheduleNow(&App::OnInterest, m_app, interest.shared_from_this());
+  }
 }
 
 void
@@ -72,7 +92,64 @@ AppFace::sendData(const Data& data)
   this->emitSignal(onSendData, data);
 
   // to decouple callbacks
-  Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  if (m_isBatched) {
+    enqueue(nullptr, data.shared_from_this());
+  }
+  else {
+    Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
+  }
+}
+
+void
+AppFace::enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data)
+{
+  uint32_t nodeId = m_node->GetId();
+  PendingQueue& queue = s_pending[nodeId];
+  queue.packets.push_back({m_app, interest, data});
+
+  if (queue.isDeliveryScheduled) {
+    // delivery event of the current time is pending or running
+    return;
+  }
+
+  // applications schedule their own events from the callbacks, in the context of the node
+  Simulator::ScheduleWithContext(nodeId, Seconds(0), &AppFace::deliverPending, nodeId);
+  queue.isDeliveryScheduled = true;
+
+  if (!s_isCleanupScheduled) {
+    // drop packets left over by this simulation
+    Simulator::ScheduleDestroy(&AppFace::clearPending);
+    s_isCleanupScheduled = true;
+  }
+}
+
+void
+AppFace::deliverPending(uint32_t nodeId)
+{
+  PendingQueue& queue = s_pending[nodeId];
+  NS_LOG_FUNCTION(nodeId << queue.packets.size());
+
+  // packets sent by the applications' callbacks are appended and delivered by this loop
+  while (!queue.packets.empty()) {
+    PendingDelivery delivery = std::move(queue.packets.front());
+    queue.packets.pop_front();
+
+    if (delivery.interest != nullptr) {
+      delivery.app->OnInterest(delivery.interest);
+    }
+    else {
+      delivery.app->OnData(delivery.data);
+    }
+  }
+
+  queue.isDeliveryScheduled = false;
+}
+
+void
+AppFace::clearPending()
+{
+  s_pending.clear();
+  s_isCleanupScheduled = false;
 }
 
 void
@@ -24,6 +24,11 @@
 #include "ns3/ndnSIM/NFD/daemon/face/local-face.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include "ns3/ptr.h"
+
+#include <deque>
+#include <map>
+
 namespace ns3 {
 
 class Packet;
@@ -80,9 +85,52 @@ public: // from nfd::Face
   virtual void
   close();
 
+private:
+  /**
+   * @brief Deliver packets queued for the applications of node \p nodeId, in the order they
+   *        were sent
+   */
+  static void
+  deliverPending(uint32_t nodeId);
+
+  static void
+  clearPending();
+
+  void
+  enqueue(shared_ptr<const Interest> interest, shared_ptr<const Data> data);
+
 private:
   Ptr<Node> m_node;
   Ptr<App> m_app;
+  bool m_isBatched;
+
+  struct PendingDelivery
+  {
+    Ptr<App> app;
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+  };
+
+  struct PendingQueue
+  {
+    PendingQueue()
+      : isDeliveryScheduled(false)
+    {
+    }
+
+    std::deque<PendingDelivery> packets;
+    bool isDeliveryScheduled;
+  };
+
+  /**
+   * @brief Packets sent towards applications and not yet delivered, per node
+   *
+   * The queue of a node is shared by all its AppFaces, so that a single event delivers all
+   * packets sent to the applications of the node at the same simulation time.  The event
+   * runs in the context of the node.
+   */
+  static std::map<uint32_t, PendingQueue> s_pending;
+  static bool s_isCleanupScheduled;
 };
 
 } // namespace ndn
@@ -68,7 +68,12 @@ GlobalRouter::GetL3Protocol() const
 void
 GlobalRouter::AddLocalPrefix(shared_ptr<Name> prefix)
 {
+#ifdef NAME_INTERNING
+  // the same prefix is usually announced and routed by many nodes
+  m_localPrefixes.push_back(make_shared<Name>(prefix->intern()));
+#else
   m_localPrefixes.push_back(prefix);
+#endif // NAME_INTERNING
 }
 
 #ifdef GLOBALROUTING_UPDATES
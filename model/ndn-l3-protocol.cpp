@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #ifdef CONF_FILE
 #include "ns3/enum.h"
 #endif // CONF_FILE
@@ -35,6 +36,7 @@
 #include "ndn-face.hpp"
 
 #include "ndn-net-device-face.hpp"
+#include "ndn-receive-batch.hpp"
 #include "../helper/ndn-stack-helper.hpp"
 #include "cs/ndn-content-store.hpp"
 
@@ -50,6 +52,7 @@
 #ifdef KITE
 #include "ns3/ndnSIM/NFD/daemon/fw/forwarder-kite.hpp"
 #endif // KITE
+#include "ns3/ndnSIM/NFD/daemon/fw/ns3-reassociation-procedure.hpp"
 
 #include "ns3/ndnSIM/NFD/daemon/mgmt/internal-face.hpp"
 #include "ns3/ndnSIM/NFD/daemon/mgmt/fib-manager.hpp"
@@ -112,9 +115,35 @@ L3Protocol::GetTypeId(void)
                      UintegerValue (MAPME_DEFAULT_TU),
                      MakeUintegerAccessor (&L3Protocol::m_Tu),
                      MakeUintegerChecker<uint64_t> ())
+      .AddAttribute ("BatchedUpdates", "Aggregate MAPME special interests per face",
+                     BooleanValue (false),
+                     MakeBooleanAccessor (&L3Protocol::m_mapmeBatched),
+                     MakeBooleanChecker ())
 #endif // MAPME
 #endif // CONF_FILE
 
+#ifdef MLDR
+      .AddAttribute("Mldr", "Enable mobility-triggered loss recovery (MLDR)",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isMldrEnabled),
+                    MakeBooleanChecker())
+#endif // MLDR
+
+      .AddAttribute("Reassociation",
+                    "Report wifi (re)associations of the node to the forwarder as they happen",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isReassociationEnabled),
+                    MakeBooleanChecker())
+
+      .AddAttribute("BatchedReceive",
+                    "Forward together the packets received by NetDeviceFaces at the same time. "
+                    "The batch is forwarded by an event scheduled at the time of the first "
+                    "reception, so other events of that time may run before packets they used to "
+                    "follow; disabled by default, as results may differ from unbatched runs",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&L3Protocol::m_isBatchedReceiveEnabled),
+                    MakeBooleanChecker())
+
       .AddTraceSource("OutInterests", "OutInterests",
                       MakeTraceSourceAccessor(&L3Protocol::m_outInterests),
                       "ns3::ndn::L3Protocol::InterestTraceCallback")
@@ -209,6 +238,8 @@ private:
   shared_ptr<nfd::StatusServer> m_statusServer;
   shared_ptr<nfd::rib::RibManager> m_ribManager;
   shared_ptr< ::ndn::Face> m_face;
+  std::unique_ptr<nfd::Ns3ReassociationProcedure> m_reassociation;
+  shared_ptr<ReceiveBatch> m_receiveBatch;
 
   nfd::ConfigSection m_config;
 
@@ -243,7 +274,9 @@ L3Protocol::initialize()
 
 #ifdef MAPME
     case MS_MAPME: {
-      m_impl->m_forwarder = make_shared<nfd::ForwarderMapMe>(m_Tu);
+      auto forwarder = make_shared<nfd::ForwarderMapMe>(m_Tu);
+      forwarder->setBatchedUpdates(m_mapmeBatched);
+      m_impl->m_forwarder = forwarder;
       break;
     }
 #endif // MAPME
@@ -266,6 +299,20 @@ L3Protocol::initialize()
   m_impl->m_forwarder = make_shared<nfd::Forwarder>();
 #endif // CONF_FILE
 
+#ifdef MLDR
+  if (m_isMldrEnabled) {
+    m_impl->m_forwarder->enableMldr();
+  }
+#endif // MLDR
+
+  if (m_isReassociationEnabled) {
+    m_impl->m_reassociation.reset(new nfd::Ns3ReassociationProcedure(*m_impl->m_forwarder));
+  }
+
+  if (m_isBatchedReceiveEnabled) {
+    m_impl->m_receiveBatch = make_shared<ReceiveBatch>(m_impl->m_forwarder->getNameTree());
+  }
+
   initializeManagement();
   Simulator::ScheduleWithContext(m_node->GetId(), Seconds(0), &L3Protocol::initializeRibManager, this);
 
@@ -355,6 +402,13 @@ L3Protocol::initializeMobility()
         m_Tu = (!Tu.empty()) ? atoi(Tu.c_str()) : MAPME_DEFAULT_TU;
       }
       catch (const std::runtime_error& e) { }
+
+      // MAPME - batched updates
+      try {
+        std::string batch = section.get<std::string>("batch");
+        m_mapmeBatched = (batch == "yes" || batch == "true" || batch == "1");
+      }
+      catch (const std::runtime_error& e) { }
 #endif // MAPME
     }
   }
@@ -416,6 +470,7 @@ L3Protocol::initializeManagement()
   m_impl->m_config.put("mobility.protocol", EnumValue(m_mobility_scheme).SerializeToString(L3Protocol::s_enum_checker));
 #ifdef MAPME
   m_impl->m_config.put("mobility.Tu", m_Tu);
+  m_impl->m_config.put("mobility.batch", m_mapmeBatched ? "yes" : "no");
 #endif // MAPME
 #endif // CONF_FILE
 
@@ -513,6 +568,11 @@ L3Protocol::DoDispose(void)
 {
   NS_LOG_FUNCTION(this);
 
+  // queued packets hold their faces
+  if (m_impl->m_receiveBatch != nullptr) {
+    m_impl->m_receiveBatch->clear();
+  }
+
   m_node = 0;
 
   Object::DoDispose();
@@ -525,6 +585,20 @@ L3Protocol::addFace(shared_ptr<Face> face)
 
   m_impl->m_forwarder->addFace(face);
 
+  if (m_impl->m_reassociation != nullptr) {
+    auto netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+    if (netDeviceFace != nullptr) {
+      m_impl->m_reassociation->install(face, netDeviceFace->GetNetDevice());
+    }
+  }
+
+  if (m_impl->m_receiveBatch != nullptr) {
+    auto netDeviceFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
+    if (netDeviceFace != nullptr) {
+      netDeviceFace->setReceiveBatch(m_impl->m_receiveBatch);
+    }
+  }
+
   // Connect Signals to TraceSource
   face->onReceiveInterest.connect
     ([this, face](const Interest& interest) { this->m_inInterests(interest, *face); });
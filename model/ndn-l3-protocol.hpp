@@ -238,9 +238,16 @@ private:
   enum mobility_scheme_e m_mobility_scheme;
 #ifdef MAPME
   uint64_t m_Tu;
+  bool m_mapmeBatched;
 #endif // MAPME
 #endif // CONF_FILE
 
+#ifdef MLDR
+  bool m_isMldrEnabled;
+#endif // MLDR
+  bool m_isReassociationEnabled;
+  bool m_isBatchedReceiveEnabled;
+
   TracedCallback<const Interest&, const Face&>
     m_inInterests; ///< @brief trace of incoming Interests
   TracedCallback<const Interest&, const Face&>
@@ -0,0 +1,244 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-ndnlp-header.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-tlv.hpp"
+
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(NdnlpHeader);
+
+/// @cond include_hidden
+
+static uint32_t
+sizeOfVarNumber(uint64_t number)
+{
+  return number < 253 ? 1 : number <= std::numeric_limits<uint16_t>::max() ? 3 : 5;
+}
+
+static void
+writeVarNumber(Buffer::Iterator& i, uint64_t number)
+{
+  if (number < 253) {
+    i.WriteU8(number);
+  }
+  else if (number <= std::numeric_limits<uint16_t>::max()) {
+    i.WriteU8(253);
+    i.WriteHtonU16(number);
+  }
+  else {
+    i.WriteU8(254);
+    i.WriteHtonU32(number);
+  }
+}
+
+static uint64_t
+readVarNumber(Buffer::Iterator& i)
+{
+  uint8_t first = i.ReadU8();
+  switch (first) {
+  case 253:
+    return i.ReadNtohU16();
+  case 254:
+    return i.ReadNtohU32();
+  case 255:
+    return i.ReadNtohU64();
+  default:
+    return first;
+  }
+}
+
+static uint32_t
+sizeOfNonNegativeInteger(uint16_t integer)
+{
+  return integer <= std::numeric_limits<uint8_t>::max() ? 1 : 2;
+}
+
+static void
+writeNonNegativeIntegerElement(Buffer::Iterator& i, uint32_t type, uint16_t integer)
+{
+  writeVarNumber(i, type);
+  writeVarNumber(i, sizeOfNonNegativeInteger(integer));
+  if (integer <= std::numeric_limits<uint8_t>::max())
+    i.WriteU8(integer);
+  else
+    i.WriteHtonU16(integer);
+}
+
+static uint64_t
+readNonNegativeIntegerElement(Buffer::Iterator& i, uint32_t type)
+{
+  if (readVarNumber(i) != type) {
+    throw ::ndn::tlv::Error("Unexpected NDNLP element");
+  }
+
+  switch (readVarNumber(i)) {
+  case 1:
+    return i.ReadU8();
+  case 2:
+    return i.ReadNtohU16();
+  case 4:
+    return i.ReadNtohU32();
+  case 8:
+    return i.ReadNtohU64();
+  default:
+    throw ::ndn::tlv::Error("Invalid length of NDNLP non-negative integer");
+  }
+}
+
+/// @endcond
+
+TypeId
+NdnlpHeader::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::NdnlpHeader")
+    .SetGroupName("Ndn")
+    .SetParent<Header>()
+    .AddConstructor<NdnlpHeader>()
+    ;
+  return tid;
+}
+
+TypeId
+NdnlpHeader::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+NdnlpHeader::NdnlpHeader()
+  : m_seq(0)
+  , m_fragIndex(0)
+  , m_fragCount(1)
+  , m_payloadSize(0)
+{
+}
+
+NdnlpHeader::NdnlpHeader(uint64_t seq, uint16_t fragIndex, uint16_t fragCount,
+                         uint32_t payloadSize)
+  : m_seq(seq)
+  , m_fragIndex(fragIndex)
+  , m_fragCount(fragCount)
+  , m_payloadSize(payloadSize)
+{
+}
+
+uint32_t
+NdnlpHeader::GetMaxPayloadSize(uint32_t mtu)
+{
+  // all fields at their largest size
+  NdnlpHeader header(0, std::numeric_limits<uint16_t>::max() - 1,
+                     std::numeric_limits<uint16_t>::max(), mtu);
+  return mtu - header.GetSerializedSize();
+}
+
+uint32_t
+NdnlpHeader::GetFieldsSize() const
+{
+  uint32_t size = 1 + 1 + sizeof(uint64_t); // NdnlpSequence
+  if (m_fragCount > 1) {
+    size += 1 + 1 + sizeOfNonNegativeInteger(m_fragIndex);
+    size += 1 + 1 + sizeOfNonNegativeInteger(m_fragCount);
+  }
+  return size;
+}
+
+uint32_t
+NdnlpHeader::GetSerializedSize(void) const
+{
+  uint32_t payloadElementSize = 1 + sizeOfVarNumber(m_payloadSize) + m_payloadSize;
+  uint32_t length = GetFieldsSize() + payloadElementSize;
+
+  // NdnlpData TLV-TYPE and TLV-LENGTH, fields, NdnlpPayload TLV-TYPE and TLV-LENGTH
+  return 1 + sizeOfVarNumber(length) + length - m_payloadSize;
+}
+
+void
+NdnlpHeader::Serialize(Buffer::Iterator start) const
+{
+  Buffer::Iterator i = start;
+
+  writeVarNumber(i, nfd::tlv::NdnlpData);
+  writeVarNumber(i, GetFieldsSize() + 1 + sizeOfVarNumber(m_payloadSize) + m_payloadSize);
+
+  writeVarNumber(i, nfd::tlv::NdnlpSequence);
+  writeVarNumber(i, sizeof(uint64_t));
+  i.WriteHtonU64(m_seq);
+
+  if (m_fragCount > 1) {
+    writeNonNegativeIntegerElement(i, nfd::tlv::NdnlpFragIndex, m_fragIndex);
+    writeNonNegativeIntegerElement(i, nfd::tlv::NdnlpFragCount, m_fragCount);
+  }
+
+  writeVarNumber(i, nfd::tlv::NdnlpPayload);
+  writeVarNumber(i, m_payloadSize);
+}
+
+uint32_t
+NdnlpHeader::Deserialize(Buffer::Iterator start)
+{
+  Buffer::Iterator i = start;
+
+  if (readVarNumber(i) != nfd::tlv::NdnlpData) {
+    throw ::ndn::tlv::Error("Expected NdnlpData");
+  }
+  readVarNumber(i); // length is implied by the elements
+
+  if (readVarNumber(i) != nfd::tlv::NdnlpSequence || readVarNumber(i) != sizeof(uint64_t)) {
+    throw ::ndn::tlv::Error("Malformed NdnlpSequence");
+  }
+  m_seq = i.ReadNtohU64();
+
+  uint64_t type = readVarNumber(i);
+  if (type == nfd::tlv::NdnlpFragIndex) {
+    i.Prev(1);
+    uint64_t fragIndex = readNonNegativeIntegerElement(i, nfd::tlv::NdnlpFragIndex);
+    uint64_t fragCount = readNonNegativeIntegerElement(i, nfd::tlv::NdnlpFragCount);
+    if (fragCount > std::numeric_limits<uint16_t>::max() || fragIndex >= fragCount) {
+      throw ::ndn::tlv::Error("Invalid NdnlpFragIndex or NdnlpFragCount");
+    }
+    m_fragIndex = fragIndex;
+    m_fragCount = fragCount;
+    type = readVarNumber(i);
+  }
+  else {
+    m_fragIndex = 0;
+    m_fragCount = 1;
+  }
+
+  if (type != nfd::tlv::NdnlpPayload) {
+    throw ::ndn::tlv::Error("Expected NdnlpPayload");
+  }
+  m_payloadSize = readVarNumber(i);
+
+  return i.GetDistanceFrom(start);
+}
+
+void
+NdnlpHeader::Print(std::ostream& os) const
+{
+  os << "NDNLP: " << m_seq << " " << m_fragIndex << "/" << m_fragCount;
+}
+
+} // namespace ndn
+} // namespace ns3
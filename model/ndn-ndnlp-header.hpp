@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_NDNLP_HEADER_H
+#define NDN_NDNLP_HEADER_H
+
+#include "ns3/header.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-face
+ * @brief NDNLP header of a fragment of a network layer packet
+ *
+ * Serialized as the beginning of a NdnlpData element (see nfd::ndnlp::NdnlpData), up to the
+ * TLV-TYPE and TLV-LENGTH of NdnlpPayload.  The fragment itself follows the header in the
+ * packet, so that fragments can share the buffer of the original packet.
+ */
+class NdnlpHeader : public Header {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  NdnlpHeader();
+
+  NdnlpHeader(uint64_t seq, uint16_t fragIndex, uint16_t fragCount, uint32_t payloadSize);
+
+  /**
+   * @brief Get the maximum size of a fragment, such that the fragment and its header fit in
+   *        @p mtu bytes
+   */
+  static uint32_t
+  GetMaxPayloadSize(uint32_t mtu);
+
+  uint64_t
+  GetSequence() const
+  {
+    return m_seq;
+  }
+
+  uint16_t
+  GetFragIndex() const
+  {
+    return m_fragIndex;
+  }
+
+  uint16_t
+  GetFragCount() const
+  {
+    return m_fragCount;
+  }
+
+  uint32_t
+  GetPayloadSize() const
+  {
+    return m_payloadSize;
+  }
+
+  virtual uint32_t
+  GetSerializedSize(void) const;
+
+  virtual void
+  Serialize(Buffer::Iterator start) const;
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  /// @brief size of NdnlpSequence, NdnlpFragIndex, and NdnlpFragCount elements
+  uint32_t
+  GetFieldsSize() const;
+
+private:
+  uint64_t m_seq;
+  uint16_t m_fragIndex;
+  uint16_t m_fragCount;
+  uint32_t m_payloadSize;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_NDNLP_HEADER_H
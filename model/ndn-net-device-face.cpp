@@ -19,14 +19,17 @@
 
 #include "ndn-net-device-face.hpp"
 #include "ndn-l3-protocol.hpp"
+#include "ndn-receive-batch.hpp"
 
 #include "ndn-ns3.hpp"
+#include "ndn-ndnlp-header.hpp"
 
 #include "ns3/net-device.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/node.h"
 #include "ns3/pointer.h"
+#include "ns3/simulator.h"
 
 // #include "ns3/address.h"
 #include "ns3/point-to-point-net-device.h"
@@ -34,11 +37,42 @@
 
 #include "../utils/ndn-fw-hop-count-tag.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-tlv.hpp"
+
+#include <algorithm>
+
+#ifdef WLDR
+#include "ndn-wldr-header.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/wldr.hpp"
+#endif // WLDR
+
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceFace");
 
 namespace ns3 {
 namespace ndn {
 
+/// \brief maximum number of partially received packets kept for reassembly
+static const size_t NDNLP_MAX_PARTIAL_PACKETS = 16;
+
+/// \brief time (seconds) after which an incomplete packet can be dropped
+static const double NDNLP_REASSEMBLY_TIMEOUT = 0.1;
+
+#ifdef WLDR
+/// \brief link-layer identifier of a NetDevice address, for WLDR
+static uint64_t
+getLinkId(const Address& address)
+{
+  uint8_t buffer[Address::MAX_SIZE];
+  uint32_t size = address.CopyTo(buffer);
+
+  uint64_t id = 0;
+  for (uint32_t i = 0; i < size && i < sizeof(id); ++i) {
+    id = (id << 8) | buffer[i];
+  }
+  return id;
+}
+#endif // WLDR
+
 NetDeviceFace::NetDeviceFace(Ptr<Node> node, const Ptr<NetDevice>& netDevice)
   : Face(FaceUri("netDeviceFace://"), FaceUri("netDeviceFace://"))
   , m_node(node)
@@ -95,6 +129,167 @@ NetDeviceFace::send(Ptr<Packet> packet)
   m_netDevice->Send(packet, m_netDevice->GetBroadcast(), L3Protocol::ETHERNET_FRAME_TYPE);
 }
 
+void
+NetDeviceFace::sendPacket(Ptr<Packet> packet)
+{
+  uint32_t mtu = m_netDevice->GetMtu();
+#ifdef WLDR
+  if (m_wldr != nullptr) {
+    mtu -= nfd::Wldr::getHeaderSize();
+  }
+#endif // WLDR
+
+  uint32_t size = packet->GetSize();
+  if (size <= mtu) {
+    sendFrame(packet);
+    return;
+  }
+
+  uint32_t maxPayloadSize = NdnlpHeader::GetMaxPayloadSize(mtu);
+  uint16_t fragCount = (size + maxPayloadSize - 1) / maxPayloadSize;
+  nfd::ndnlp::SequenceBlock sequences = m_ndnlpSequence.nextBlock(fragCount);
+  NS_LOG_DEBUG("Fragmenting packet of " << size << " bytes into " << fragCount << " fragments");
+
+  for (uint16_t fragIndex = 0; fragIndex < fragCount; ++fragIndex) {
+    uint32_t offset = fragIndex * maxPayloadSize;
+    uint32_t payloadSize = std::min(maxPayloadSize, size - offset);
+
+    // the fragment shares the buffer of the original packet
+    Ptr<Packet> fragment = packet->CreateFragment(offset, payloadSize);
+    fragment->AddHeader(NdnlpHeader(sequences[fragIndex], fragIndex, fragCount, payloadSize));
+    sendFrame(fragment);
+  }
+}
+
+void
+NetDeviceFace::sendFrame(Ptr<Packet> frame)
+{
+#ifdef WLDR
+  if (m_wldr != nullptr) {
+    sendWldr(frame);
+    return;
+  }
+#endif // WLDR
+  send(frame);
+}
+
+Ptr<Packet>
+NetDeviceFace::reassemble(Ptr<Packet> fragment, const Address& from)
+{
+  NdnlpHeader header;
+  fragment->RemoveHeader(header);
+  if (fragment->GetSize() != header.GetPayloadSize()) {
+    NS_LOG_DEBUG("Truncated NDNLP fragment " << header.GetSequence());
+    return 0;
+  }
+
+  if (header.GetFragCount() == 1) {
+    return fragment;
+  }
+
+  Time now = Simulator::Now();
+  std::pair<Address, uint64_t> key(from, header.GetSequence() - header.GetFragIndex());
+  auto partial = m_partialPackets.find(key);
+  if (partial == m_partialPackets.end()) {
+    // memory is bounded: idle partial packets are dropped, then the oldest if there are too many
+    for (auto i = m_partialPackets.begin(); i != m_partialPackets.end();) {
+      if (now - i->second.lastReceived > Seconds(NDNLP_REASSEMBLY_TIMEOUT))
+        i = m_partialPackets.erase(i);
+      else
+        ++i;
+    }
+
+    if (m_partialPackets.size() >= NDNLP_MAX_PARTIAL_PACKETS) {
+      auto oldest = std::min_element(m_partialPackets.begin(), m_partialPackets.end(),
+                                     [] (const PartialPacketMap::value_type& a,
+                                         const PartialPacketMap::value_type& b) {
+                                       return a.second.lastReceived < b.second.lastReceived;
+                                     });
+      NS_LOG_DEBUG("Dropping partial packet " << oldest->first.second);
+      m_partialPackets.erase(oldest);
+    }
+
+    PartialPacket newPartial;
+    newPartial.fragments.resize(header.GetFragCount());
+    newPartial.nReceived = 0;
+    newPartial.size = 0;
+    partial = m_partialPackets.insert(std::make_pair(key, newPartial)).first;
+  }
+
+  PartialPacket& partialPacket = partial->second;
+  partialPacket.lastReceived = now;
+
+  if (partialPacket.fragments.size() != header.GetFragCount()
+      || partialPacket.fragments[header.GetFragIndex()] != 0) {
+    NS_LOG_DEBUG("Inconsistent or duplicate NDNLP fragment " << header.GetSequence());
+    return 0;
+  }
+
+  partialPacket.size += fragment->GetSize();
+  if (partialPacket.size > ::ndn::MAX_NDN_PACKET_SIZE) {
+    NS_LOG_DEBUG("Reassembled packet exceeds maximum packet size");
+    m_partialPackets.erase(partial);
+    return 0;
+  }
+
+  partialPacket.fragments[header.GetFragIndex()] = fragment;
+  if (++partialPacket.nReceived < header.GetFragCount()) {
+    return 0;
+  }
+
+  Ptr<Packet> packet = partialPacket.fragments[0];
+  for (size_t i = 1; i < partialPacket.fragments.size(); ++i) {
+    packet->AddAtEnd(partialPacket.fragments[i]);
+  }
+  m_partialPackets.erase(partial);
+  return packet;
+}
+
+void
+NetDeviceFace::setReceiveBatch(shared_ptr<ReceiveBatch> batch)
+{
+  m_receiveBatch = batch;
+}
+
+#ifdef WLDR
+void
+NetDeviceFace::enableWldr(size_t bufferSize, size_t maxRetransmissions)
+{
+  NS_LOG_FUNCTION(this << bufferSize << maxRetransmissions);
+
+  m_wldr.reset(new nfd::Wldr(getLinkId(m_netDevice->GetAddress()), bufferSize,
+                             maxRetransmissions));
+  m_wldrBuffer.assign(bufferSize, nullptr);
+
+  m_wldr->onRetransmit.connect([this] (uint64_t seq) {
+      NS_LOG_DEBUG("WLDR retransmission " << seq);
+      send(m_wldrBuffer[seq % m_wldrBuffer.size()]->Copy());
+    });
+  m_wldr->onSendLossNotification.connect([this] (const Block& notification) {
+      send(Create<Packet>(notification.wire(), notification.size()));
+    });
+}
+
+void
+NetDeviceFace::sendWldr(Ptr<Packet> packet)
+{
+  uint64_t seq = m_wldr->assignSequence();
+  packet->AddHeader(WldrHeader(seq));
+
+  // kept before the hop count is incremented by send
+  m_wldrBuffer[seq % m_wldrBuffer.size()] = packet->Copy();
+  send(packet);
+}
+
+void
+NetDeviceFace::receiveWldrLossNotification(Ptr<Packet> packet)
+{
+  std::vector<uint8_t> buffer(packet->GetSize());
+  packet->CopyData(buffer.data(), buffer.size());
+  m_wldr->receiveLossNotification(Block(buffer.data(), buffer.size()));
+}
+#endif // WLDR
+
 void
 NetDeviceFace::sendInterest(const Interest& interest)
 {
@@ -103,7 +298,7 @@ NetDeviceFace::sendInterest(const Interest& interest)
   this->emitSignal(onSendInterest, interest);
 
   Ptr<Packet> packet = Convert::ToPacket(interest);
-  send(packet);
+  sendPacket(packet);
 }
 
 void
@@ -114,7 +309,7 @@ NetDeviceFace::sendData(const Data& data)
   this->emitSignal(onSendData, data);
 
   Ptr<Packet> packet = Convert::ToPacket(data);
-  send(packet);
+  sendPacket(packet);
 }
 
 // callback
@@ -127,14 +322,52 @@ NetDeviceFace::receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p,
 
   Ptr<Packet> packet = p->Copy();
   try {
-    uint32_t type = Convert::getPacketType(p);
+#ifdef WLDR
+    uint8_t linkType = 0;
+    packet->CopyData(&linkType, 1);
+    if (linkType == nfd::tlv::WldrLossNotification) {
+      if (m_wldr != nullptr) {
+        receiveWldrLossNotification(packet);
+      }
+      return;
+    }
+    if (linkType == nfd::tlv::WldrHeader) {
+      WldrHeader header;
+      packet->RemoveHeader(header);
+      if (m_wldr != nullptr && !m_wldr->receivePacket(getLinkId(from), header.GetSequence())) {
+        NS_LOG_DEBUG("Duplicate WLDR packet " << header.GetSequence());
+        return;
+      }
+    }
+#endif // WLDR
+
+    uint8_t linkPacketType = 0;
+    packet->CopyData(&linkPacketType, 1);
+    if (linkPacketType == nfd::tlv::NdnlpData) {
+      packet = reassemble(packet, from);
+      if (packet == 0)
+        return;
+    }
+
+    uint32_t type = Convert::getPacketType(packet);
     if (type == ::ndn::tlv::Interest) {
       shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
-      this->emitSignal(onReceiveInterest, *i);
+      if (m_receiveBatch != nullptr) {
+        m_receiveBatch->receiveInterest(std::static_pointer_cast<NetDeviceFace>(shared_from_this()),
+                                        i);
+      }
+      else {
+        this->emitSignal(onReceiveInterest, *i);
+      }
     }
     else if (type == ::ndn::tlv::Data) {
       shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
-      this->emitSignal(onReceiveData, *d);
+      if (m_receiveBatch != nullptr) {
+        m_receiveBatch->receiveData(std::static_pointer_cast<NetDeviceFace>(shared_from_this()), d);
+      }
+      else {
+        this->emitSignal(onReceiveData, *d);
+      }
     }
     else {
       NS_LOG_ERROR("Unsupported TLV packet");
@@ -23,11 +23,24 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-sequence-generator.hpp"
+
 #include "ns3/net-device.h"
+#include "ns3/nstime.h"
+
+#include <map>
+
+#ifdef WLDR
+namespace nfd {
+class Wldr;
+} // namespace nfd
+#endif // WLDR
 
 namespace ns3 {
 namespace ndn {
 
+class ReceiveBatch;
+
 /**
  * \ingroup ndn-face
  * \brief Implementation of layer-2 (Ethernet) Ndn face
@@ -81,6 +94,15 @@ public:
   Ptr<NetDevice>
   GetNetDevice() const;
 
+  /**
+   * \brief Queue the received packets in \p batch instead of forwarding them right away
+   *
+   * \param batch batch shared by the faces of the node, or nullptr to forward every packet
+   *        when it is received
+   */
+  void
+  setReceiveBatch(shared_ptr<ReceiveBatch> batch);
+
 #ifdef FACE_UP_DOWN
   virtual bool
   isUp() const;
@@ -89,10 +111,60 @@ public:
   setUp(bool up);
 #endif // FACE_UP_DOWN
 
+#ifdef WLDR
+  /**
+   * \brief Enable Wireless Loss Detection and Recovery (WLDR) on the face
+   *
+   * Outgoing packets carry a WLDR header and are kept for local retransmission.  Peers must
+   * enable WLDR as well to detect losses.
+   *
+   * \param bufferSize number of sent packets kept for retransmission
+   * \param maxRetransmissions maximum number of link retransmissions of a packet
+   */
+  void
+  enableWldr(size_t bufferSize, size_t maxRetransmissions);
+
+  /**
+   * \brief Get WLDR state and counters, or nullptr if WLDR is not enabled
+   */
+  const nfd::Wldr*
+  getWldr() const
+  {
+    return m_wldr.get();
+  }
+#endif // WLDR
+
 private:
+  /**
+   * \brief Send a network layer packet, fragmented with NDNLP if it exceeds the device MTU
+   */
+  void
+  sendPacket(Ptr<Packet> packet);
+
+  /**
+   * \brief Send a link layer frame (a whole packet or a fragment)
+   */
+  void
+  sendFrame(Ptr<Packet> frame);
+
   virtual void
   send(Ptr<Packet> packet);
 
+  /**
+   * \brief Add a received NDNLP fragment to its partial packet
+   * \return the reassembled network layer packet, or 0 if it is not complete yet
+   */
+  Ptr<Packet>
+  reassemble(Ptr<Packet> fragment, const Address& from);
+
+#ifdef WLDR
+  void
+  sendWldr(Ptr<Packet> packet);
+
+  void
+  receiveWldrLossNotification(Ptr<Packet> packet);
+#endif // WLDR
+
 protected:
   /// \brief callback from lower layers
   virtual void
@@ -106,6 +178,29 @@ protected:
 #ifdef FACE_UP_DOWN
   bool m_up;
 #endif // FACE_UP_DOWN
+
+  nfd::ndnlp::SequenceGenerator m_ndnlpSequence;
+
+  /// \brief fragments received so far of a network layer packet
+  struct PartialPacket {
+    std::vector<Ptr<Packet>> fragments;
+    uint16_t nReceived;
+    uint32_t size;
+    Time lastReceived;
+  };
+
+  /// \brief partial packets, by sender and NDNLP sequence of the first fragment
+  typedef std::map<std::pair<Address, uint64_t>, PartialPacket> PartialPacketMap;
+  PartialPacketMap m_partialPackets;
+
+#ifdef WLDR
+  std::unique_ptr<nfd::Wldr> m_wldr;
+  std::vector<Ptr<Packet>> m_wldrBuffer; ///< \brief sent packets, indexed by WLDR sequence modulo size
+#endif // WLDR
+
+  shared_ptr<ReceiveBatch> m_receiveBatch; ///< \brief batch of the node, if batched receive is enabled
+
+  friend class ReceiveBatch;
 };
 
 } // namespace ndn
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-receive-batch.hpp"
+#include "ndn-net-device-face.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+
+NS_LOG_COMPONENT_DEFINE("ndn.ReceiveBatch");
+
+namespace ns3 {
+namespace ndn {
+
+ReceiveBatch::ReceiveBatch(const nfd::NameTree& nameTree)
+  : m_nameTree(nameTree)
+{
+}
+
+ReceiveBatch::~ReceiveBatch()
+{
+  if (m_processEvent.IsRunning()) {
+    Simulator::Remove(m_processEvent);
+  }
+}
+
+void
+ReceiveBatch::receiveInterest(shared_ptr<NetDeviceFace> face, shared_ptr<const Interest> interest)
+{
+  schedule();
+  m_packets.push_back({face, interest, nullptr});
+}
+
+void
+ReceiveBatch::receiveData(shared_ptr<NetDeviceFace> face, shared_ptr<const Data> data)
+{
+  schedule();
+  m_packets.push_back({face, nullptr, data});
+}
+
+void
+ReceiveBatch::clear()
+{
+  if (m_processEvent.IsRunning()) {
+    Simulator::Remove(m_processEvent);
+  }
+  m_packets.clear();
+}
+
+void
+ReceiveBatch::schedule()
+{
+  if (m_packets.empty()) {
+    m_processEvent = Simulator::ScheduleNow(&ReceiveBatch::process, this);
+  }
+}
+
+void
+ReceiveBatch::process()
+{
+  // packets received while the batch is forwarded start a new batch
+  std::vector<ReceivedPacket> packets;
+  packets.swap(m_packets);
+
+  NS_LOG_DEBUG("Forwarding " << packets.size() << " packets");
+
+  for (const ReceivedPacket& packet : packets) {
+    m_nameTree.prefetch(packet.interest != nullptr ? packet.interest->getName()
+                                                   : packet.data->getName());
+  }
+
+  for (const ReceivedPacket& packet : packets) {
+    if (packet.interest != nullptr) {
+      packet.face->emitSignal(onReceiveInterest, *packet.interest);
+    }
+    else {
+      packet.face->emitSignal(onReceiveData, *packet.data);
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RECEIVE_BATCH_H
+#define NDN_RECEIVE_BATCH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/event-id.h"
+
+#include <boost/noncopyable.hpp>
+
+#include <vector>
+
+namespace nfd {
+class NameTree;
+} // namespace nfd
+
+namespace ns3 {
+namespace ndn {
+
+class NetDeviceFace;
+
+/**
+ * \ingroup ndn-face
+ * \brief Packets received by the NetDeviceFaces of a node at the same time, forwarded together
+ *
+ * Links deliver packets to a node at the same simulation time when their senders are
+ * synchronized, e.g., consumers of a dumbbell requesting at the same rate.  Instead of running
+ * the forwarding pipelines in each delivery event, the faces decode the packets and queue them
+ * in the batch of their node, and the batch is forwarded by a single event scheduled at the
+ * same time.  The Name Tree buckets of all the names are prefetched before the pipelines run,
+ * so that the lookups of the batch do not wait for memory one after the other.
+ *
+ * Packets are forwarded in the order of reception and at the time of reception.  However, the
+ * order of events at the same simulation time changes: the batch is forwarded by an event
+ * scheduled after all the events already pending at that time, so events scheduled by other
+ * components (applications, timers, other nodes) at the same time run before the batch rather
+ * than after the packets received before them.  Simulations with batching may therefore not
+ * reproduce the exact results of simulations without it, which is why batching is disabled by
+ * default.
+ *
+ * \see L3Protocol BatchedReceive attribute
+ */
+class ReceiveBatch : boost::noncopyable {
+public:
+  explicit
+  ReceiveBatch(const nfd::NameTree& nameTree);
+
+  ~ReceiveBatch();
+
+  /**
+   * \brief Queue an Interest received by \p face
+   */
+  void
+  receiveInterest(shared_ptr<NetDeviceFace> face, shared_ptr<const Interest> interest);
+
+  /**
+   * \brief Queue a Data received by \p face
+   */
+  void
+  receiveData(shared_ptr<NetDeviceFace> face, shared_ptr<const Data> data);
+
+  /**
+   * \brief Number of packets waiting to be forwarded
+   */
+  size_t
+  size() const
+  {
+    return m_packets.size();
+  }
+
+  /**
+   * \brief Drop the packets waiting to be forwarded
+   */
+  void
+  clear();
+
+private:
+  void
+  schedule();
+
+  /**
+   * \brief Forward the packets of the batch
+   */
+  void
+  process();
+
+private:
+  struct ReceivedPacket {
+    shared_ptr<NetDeviceFace> face;
+    shared_ptr<const Interest> interest;
+    shared_ptr<const Data> data;
+  };
+
+  const nfd::NameTree& m_nameTree;
+  std::vector<ReceivedPacket> m_packets;
+  EventId m_processEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RECEIVE_BATCH_H
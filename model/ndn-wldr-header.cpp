@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifdef WLDR
+
+#include "ndn-wldr-header.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/wldr.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(WldrHeader);
+
+TypeId
+WldrHeader::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::WldrHeader")
+    .SetGroupName("Ndn")
+    .SetParent<Header>()
+    .AddConstructor<WldrHeader>()
+    ;
+  return tid;
+}
+
+TypeId
+WldrHeader::GetInstanceTypeId(void) const
+{
+  return GetTypeId();
+}
+
+WldrHeader::WldrHeader()
+  : m_seq(0)
+{
+}
+
+WldrHeader::WldrHeader(uint64_t seq)
+  : m_seq(seq)
+{
+}
+
+uint32_t
+WldrHeader::GetSerializedSize(void) const
+{
+  return nfd::Wldr::getHeaderSize();
+}
+
+void
+WldrHeader::Serialize(Buffer::Iterator start) const
+{
+  Block header = nfd::Wldr::encodeHeader(m_seq);
+  start.Write(header.wire(), header.size());
+}
+
+uint32_t
+WldrHeader::Deserialize(Buffer::Iterator start)
+{
+  size_t size = nfd::Wldr::getHeaderSize();
+  std::vector<uint8_t> buffer(size);
+  start.Read(buffer.data(), size);
+
+  bool isOk = false;
+  std::tie(isOk, m_seq) = nfd::Wldr::decodeHeader(Block(buffer.data(), buffer.size()));
+  if (!isOk) {
+    throw ::ndn::tlv::Error("Malformed WldrHeader");
+  }
+  return size;
+}
+
+void
+WldrHeader::Print(std::ostream& os) const
+{
+  os << "WLDR: " << m_seq;
+}
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // WLDR
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+
+#ifndef NDN_WLDR_HEADER_H
+#define NDN_WLDR_HEADER_H
+
+#ifdef WLDR
+
+#include "ns3/header.h"
+
+#include "ndn-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-face
+ * @brief WLDR header, carrying the link sequence number of a packet
+ *
+ * Serialized as nfd::Wldr::encodeHeader, in front of the network layer packet
+ */
+class WldrHeader : public Header {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual TypeId
+  GetInstanceTypeId(void) const;
+
+  WldrHeader();
+
+  explicit WldrHeader(uint64_t seq);
+
+  uint64_t
+  GetSequence() const
+  {
+    return m_seq;
+  }
+
+  virtual uint32_t
+  GetSerializedSize(void) const;
+
+  virtual void
+  Serialize(Buffer::Iterator start) const;
+
+  virtual uint32_t
+  Deserialize(Buffer::Iterator start);
+
+  virtual void
+  Print(std::ostream& os) const;
+
+private:
+  uint64_t m_seq;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // WLDR
+
+#endif // NDN_WLDR_HEADER_H
@@ -83,7 +83,7 @@ uint32_t
 Interest::getNonce() const
 {
   if (!m_nonce.hasWire())
-    const_cast<Interest*>(this)->setNonce(random::generateWord32());
+    const_cast<Interest*>(this)->setNonce(random::generateNonce());
 
   if (m_nonce.value_size() == sizeof(uint32_t))
     return *reinterpret_cast<const uint32_t*>(m_nonce.value());
@@ -117,7 +117,7 @@ Interest::refreshNonce()
   uint32_t oldNonce = getNonce();
   uint32_t newNonce = oldNonce;
   while (newNonce == oldNonce)
-    newNonce = random::generateWord32();
+    newNonce = random::generateNonce();
 
   setNonce(newNonce);
 }
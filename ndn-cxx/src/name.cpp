@@ -32,6 +32,8 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <unordered_map>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -289,6 +291,102 @@ Name::getSubName(ssize_t iStartComponent, size_t nComponents) const
   return result;
 }
 
+namespace {
+
+/**
+ * @brief TLV-VALUE (sequence of components) of a name, used as key of the interning table
+ */
+struct InternedValue
+{
+  const uint8_t* value;
+  size_t size;
+};
+
+struct InternedValueHash
+{
+  size_t
+  operator()(const InternedValue& value) const
+  {
+    return boost::hash_range(value.value, value.value + value.size);
+  }
+};
+
+struct InternedValueEqual
+{
+  bool
+  operator()(const InternedValue& a, const InternedValue& b) const
+  {
+    return a.size == b.size && std::equal(a.value, a.value + a.size, b.value);
+  }
+};
+
+/**
+ * @brief wire buffers of the interned names, by TLV-VALUE pointing into the buffers
+ */
+typedef std::unordered_map<InternedValue, weak_ptr<const Buffer>,
+                           InternedValueHash, InternedValueEqual> InternTable;
+
+InternTable&
+getInternTable()
+{
+  // never destroyed, as interned names held by static objects can be released after it
+  static InternTable* table = new InternTable;
+  return *table;
+}
+
+/**
+ * @brief deleter of the wire buffer of an interned name, which removes the name from the table
+ */
+struct InternedBufferDeleter
+{
+  void
+  operator()(Buffer* buffer) const
+  {
+    getInternTable().erase(InternedValue{buffer->buf() + headerSize, buffer->size() - headerSize});
+    delete buffer;
+  }
+
+  size_t headerSize;
+};
+
+} // unnamed namespace
+
+Name
+Name::getInternedPrefix(ssize_t nComponents) const
+{
+  size_t n = nComponents < 0 ? std::max<ssize_t>(0, static_cast<ssize_t>(size()) + nComponents)
+                             : std::min<size_t>(size(), nComponents);
+
+  // components of the prefix are contiguous in the wire encoding of this name
+  const Block& wire = wireEncode();
+  const uint8_t* value = wire.wire() + (wire.size() - wire.value_size());
+  size_t valueSize = n == 0 ? 0 : (at(n - 1).wire() + at(n - 1).size()) - value;
+
+  InternTable& table = getInternTable();
+  auto it = table.find(InternedValue{value, valueSize});
+  if (it != table.end()) {
+    return Name(Block(it->second.lock()));
+  }
+
+  EncodingBuffer encoder(valueSize + 2 * tlv::sizeOfVarNumber(valueSize), 0);
+  encoder.prependByteArray(value, valueSize);
+  encoder.prependVarNumber(valueSize);
+  encoder.prependVarNumber(tlv::Name);
+
+  size_t headerSize = encoder.size() - valueSize;
+  shared_ptr<Buffer> buffer(new Buffer(encoder.buf(), encoder.size()),
+                            InternedBufferDeleter{headerSize});
+  table.insert({InternedValue{buffer->buf() + headerSize, valueSize}, buffer});
+  return Name(Block(buffer));
+}
+
+bool
+Name::isInterned() const
+{
+  return m_nameBlock.hasWire() &&
+         std::get_deleter<InternedBufferDeleter>(m_nameBlock.getBuffer()) != nullptr;
+}
+
 Name
 Name::getSuccessor() const
 {
@@ -248,12 +248,51 @@ public:
   PartialName
   getPrefix(ssize_t nComponents) const
   {
+#ifdef NDN_CXX_NAME_INTERNING
+    if (isInterned())
+      return getInternedPrefix(nComponents);
+#endif // NDN_CXX_NAME_INTERNING
+
     if (nComponents < 0)
       return getSubName(0, m_nameBlock.elements_size() + nComponents);
     else
       return getSubName(0, nComponents);
   }
 
+  /**
+   * @brief Get the interned copy of this name
+   *
+   * All the interned copies of a name share one immutable wire buffer, which is released when
+   * the last copy is destroyed.  Names kept by many tables (e.g., routable prefixes on every
+   * node of a simulation) are then stored once, and do not keep alive the packets they were
+   * decoded from.
+   *
+   * @note The interning table is not thread-safe.
+   */
+  Name
+  intern() const
+  {
+    return getInternedPrefix(size());
+  }
+
+  /**
+   * @brief Get the interned copy of a prefix of the name
+   *
+   * The prefix is looked up in the interning table from the wire encoding of this name,
+   * without encoding it again.  When compiled with NDN_CXX_NAME_INTERNING, getPrefix of an
+   * interned name returns the interned prefix.
+   *
+   * @param nComponents The number of prefix components, as in getPrefix
+   */
+  Name
+  getInternedPrefix(ssize_t nComponents) const;
+
+  /**
+   * @brief Check if the name shares its wire encoding with the other interned copies
+   */
+  bool
+  isInterned() const;
+
   /**
    * Encode this name as a URI.
    * @return The encoded URI.
@@ -25,6 +25,7 @@
 #include "common.hpp"
 #include "tag.hpp"
 
+#include <array>
 #include <map>
 
 namespace ndn {
@@ -34,6 +35,10 @@ namespace ndn {
 class TagHost
 {
 public:
+  /** \brief number of inline tag slots, \see TagSlot
+   */
+  static constexpr size_t N_TAG_SLOTS = 2;
+
   /** \brief get a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \retval nullptr if no Tag of type T is stored
@@ -58,7 +63,8 @@ public:
   removeTag() const;
 
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  mutable std::array<shared_ptr<Tag>, N_TAG_SLOTS> m_tagSlots; ///< tags with an inline slot
+  mutable std::map<size_t, shared_ptr<Tag>> m_tags; ///< other tags, indexed by type id
 };
 
 
@@ -67,6 +73,12 @@ inline shared_ptr<T>
 TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+  static_assert(TagSlot<T>::value == NO_TAG_SLOT || TagSlot<T>::value < N_TAG_SLOTS,
+                "TagSlot<T> must be below N_TAG_SLOTS");
+
+  if (TagSlot<T>::value != NO_TAG_SLOT) {
+    return static_pointer_cast<T>(m_tagSlots[TagSlot<T>::value]);
+  }
 
   auto it = m_tags.find(T::getTypeId());
   if (it == m_tags.end()) {
@@ -80,6 +92,13 @@ inline void
 TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
+  static_assert(TagSlot<T>::value == NO_TAG_SLOT || TagSlot<T>::value < N_TAG_SLOTS,
+                "TagSlot<T> must be below N_TAG_SLOTS");
+
+  if (TagSlot<T>::value != NO_TAG_SLOT) {
+    m_tagSlots[TagSlot<T>::value] = std::move(tag);
+    return;
+  }
 
   if (tag == nullptr) {
     m_tags.erase(T::getTypeId());
@@ -22,6 +22,8 @@
 #ifndef NDN_TAG_HPP
 #define NDN_TAG_HPP
 
+#include <cstddef>
+
 namespace ndn {
 
 /**
@@ -50,6 +52,23 @@ Tag::~Tag()
 {
 }
 
+/**
+ * @brief Inline storage slot of a Tag type inside TagHost
+ *
+ * Tags that are attached to most packets may specialize this template with a value below
+ * TagHost::N_TAG_SLOTS, so that they are stored in a fixed array instead of a map (no tree
+ * lookup and no heap node on each operation).  Other tags use the default, NO_TAG_SLOT.
+ *
+ * Slot 0 is used by ndnSIM for Ns3PacketTag.
+ */
+template<typename T>
+struct TagSlot
+{
+  static constexpr size_t value = static_cast<size_t>(-1);
+};
+
+static constexpr size_t NO_TAG_SLOT = TagSlot<Tag>::value;
+
 } // namespace ndn
 
 #endif // NDN_TAG_HPP
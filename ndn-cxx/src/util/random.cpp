@@ -83,6 +83,25 @@ generateWord64()
   return distribution(getRandomGenerator());
 }
 
+// Interest nonces
+
+static shared_ptr<CustomNonceGenerator> g_nonceGenerator;
+
+void
+setCustomNonceGenerator(shared_ptr<CustomNonceGenerator> generator)
+{
+  g_nonceGenerator = generator;
+}
+
+uint32_t
+generateNonce()
+{
+  if (g_nonceGenerator == nullptr) {
+    return generateWord32();
+  }
+
+  return g_nonceGenerator->generateNonce();
+}
 
 } // namespace random
 } // namespace ndn
@@ -67,6 +67,41 @@ generateWord32();
 uint64_t
 generateWord64();
 
+/**
+ * @brief Class implementing a custom source of Interest nonces
+ *
+ * Instance of this class may be passed to setCustomNonceGenerator() free function in order
+ * to change how nonces are generated for Interest packets (e.g., to make simulations
+ * reproducible).
+ */
+class CustomNonceGenerator
+{
+public:
+  virtual
+  ~CustomNonceGenerator()
+  {
+  }
+
+  virtual uint32_t
+  generateNonce() = 0;
+};
+
+/**
+ * @brief Set custom source of Interest nonces
+ *
+ * When \p generator is set to nullptr, generateWord32() is used
+ */
+void
+setCustomNonceGenerator(shared_ptr<CustomNonceGenerator> generator = nullptr);
+
+/**
+ * @brief Generate a nonce for an Interest packet
+ *
+ * This method uses the custom nonce generator if one is set, and generateWord32() otherwise
+ */
+uint32_t
+generateNonce();
+
 } // namespace random
 } // namespace ndn
 
@@ -559,6 +559,35 @@ BOOST_AUTO_TEST_CASE(SubNameOutOfRangeIndexes)
   BOOST_CHECK_EQUAL("/first/second/last", name.getSubName(-10, 10));
 }
 
+BOOST_AUTO_TEST_CASE(Intern)
+{
+  Name name("/first/second/last");
+  BOOST_CHECK(!name.isInterned());
+
+  Name interned = name.intern();
+  BOOST_CHECK(interned.isInterned());
+  BOOST_CHECK_EQUAL(interned, name);
+
+  // interned copies share their wire encoding
+  Name interned2 = Name("/first/second/last").intern();
+  BOOST_CHECK(interned2.wireEncode().getBuffer() == interned.wireEncode().getBuffer());
+
+  Name prefix = name.getInternedPrefix(-1);
+  BOOST_CHECK(prefix.isInterned());
+  BOOST_CHECK_EQUAL(prefix, "/first/second");
+  BOOST_CHECK(prefix.wireEncode().getBuffer() ==
+              interned.getInternedPrefix(2).wireEncode().getBuffer());
+  BOOST_CHECK_EQUAL(name.getInternedPrefix(0), "/");
+  BOOST_CHECK_EQUAL(name.getInternedPrefix(10), name);
+
+  // modified copies are not interned
+  Name appended = prefix;
+  appended.append("other");
+  BOOST_CHECK(!appended.isInterned());
+  BOOST_CHECK_EQUAL(appended, "/first/second/other");
+  BOOST_CHECK_EQUAL(prefix, "/first/second");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -52,6 +52,26 @@ public:
   }
 };
 
+class TestSlotTag : public Tag
+{
+public:
+  static constexpr size_t
+  getTypeId()
+  {
+    return 3;
+  }
+};
+
+} // namespace tests
+
+template<>
+struct TagSlot<tests::TestSlotTag>
+{
+  static constexpr size_t value = 1;
+};
+
+namespace tests {
+
 typedef boost::mpl::vector<TagHost, Interest, Data> Fixtures;
 
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
@@ -80,6 +100,27 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(InlineSlot, T, Fixtures, T)
+{
+  BOOST_CHECK(this->template getTag<TestSlotTag>() == nullptr);
+
+  auto tag = make_shared<TestSlotTag>();
+  this->setTag(tag);
+  this->setTag(make_shared<TestTag>());
+
+  BOOST_CHECK(this->template getTag<TestSlotTag>() == tag);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+
+  T copy(*this);
+  BOOST_CHECK(copy.template getTag<TestSlotTag>() == tag);
+
+  this->template removeTag<TestSlotTag>();
+
+  BOOST_CHECK(this->template getTag<TestSlotTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+  BOOST_CHECK(copy.template getTag<TestSlotTag>() == tag);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -20,6 +20,7 @@
  */
 
 #include "util/random.hpp"
+#include "interest.hpp"
 
 #include "boost-test.hpp"
 #include <boost/mpl/vector.hpp>
@@ -107,6 +108,32 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GoodnessOfFit, RandomGenerator, RandomGenerators)
   BOOST_WARN_LE(t, 0.230);
 }
 
+class SequentialNonceGenerator : public random::CustomNonceGenerator
+{
+public:
+  virtual uint32_t
+  generateNonce()
+  {
+    return ++m_nonce;
+  }
+
+private:
+  uint32_t m_nonce = 0;
+};
+
+BOOST_AUTO_TEST_CASE(CustomNonceGenerator)
+{
+  random::setCustomNonceGenerator(make_shared<SequentialNonceGenerator>());
+
+  Interest interest("/A");
+  BOOST_CHECK_EQUAL(interest.getNonce(), 1);
+  interest.refreshNonce();
+  BOOST_CHECK_EQUAL(interest.getNonce(), 2);
+  BOOST_CHECK_EQUAL(random::generateNonce(), 3);
+
+  random::setCustomNonceGenerator(nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "benchmark-common.hpp"
+
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace ns3 {
+namespace ndn {
+
+static uint64_t g_nAllocations = 0;
+
+} // namespace ndn
+} // namespace ns3
+
+// Counts the heap allocations of the whole benchmark program, only read by the suite below
+void*
+operator new(std::size_t size)
+{
+  ++ns3::ndn::g_nAllocations;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(Allocation, BenchmarkFixture)
+
+/**
+ * Heap allocations per packet processed by the forwarders of a chain of 10 nodes:
+ *
+ *      +----------+     +--------+           +--------+     +----------+
+ *      | consumer | --- | router | --- ... --- | router | --- | producer |
+ *      +----------+     +--------+           +--------+     +----------+
+ *
+ * Every packet received from a NetDevice is decoded with its ns-3 packet attached as a tag,
+ * so that the number of allocations per packet depends on the cost of tag storage.
+ */
+BOOST_AUTO_TEST_CASE(Chain)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Gbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("1ms"));
+
+  NodeContainer nodes;
+  nodes.Create(10);
+
+  PointToPointHelper p2p;
+  for (uint32_t i = 0; i + 1 < nodes.GetN(); ++i) {
+    p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+  }
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+  routingHelper.AddOrigins("/prefix", nodes.Get(nodes.GetN() - 1));
+  GlobalRoutingHelper::CalculateRoutes();
+
+  AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+  consumerHelper.SetPrefix("/prefix");
+  consumerHelper.SetAttribute("Frequency", DoubleValue(1000));
+  consumerHelper.Install(nodes.Get(0));
+
+  AppHelper producerHelper("ns3::ndn::Producer");
+  producerHelper.SetPrefix("/prefix");
+  producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+  producerHelper.Install(nodes.Get(nodes.GetN() - 1));
+
+  Simulator::Stop(Seconds(10));
+
+  uint64_t beginAllocations = g_nAllocations;
+  time::nanoseconds d = timedRun([] { Simulator::Run(); });
+  uint64_t nAllocations = g_nAllocations - beginAllocations;
+
+  uint64_t nPackets = getNForwardedPackets();
+  BOOST_REQUIRE_GT(nPackets, 0);
+  report(nPackets, d);
+  reportMetric("AllocationsPerPacket", 1.0 * nAllocations / nPackets);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
+#define NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
+
+#include "ns3/core-module.h"
+#include "ns3/map-scheduler.h"
+#include "ns3/node-list.h"
+#include "model/ndn-common.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "utils/topology/rocketfuel-map-reader.hpp"
+
+#include "../unit-tests/tests-common.hpp"
+
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Map scheduler counting the number of scheduled events
+ */
+class CountingScheduler : public MapScheduler
+{
+public:
+  static TypeId
+  GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::ndn::CountingScheduler")
+                          .SetParent<MapScheduler>()
+                          .AddConstructor<CountingScheduler>();
+    return tid;
+  }
+
+  virtual void
+  Insert(const Scheduler::Event& ev)
+  {
+    ++getNEvents();
+    MapScheduler::Insert(ev);
+  }
+
+  /**
+   * \brief Number of events scheduled since the last BenchmarkFixture::useCountingScheduler
+   */
+  static uint64_t&
+  getNEvents()
+  {
+    static uint64_t nEvents = 0;
+    return nEvents;
+  }
+};
+
+/**
+ * \brief Fixture of the benchmarks
+ *
+ * Each measurement is reported as a tab-separated line:
+ *
+ *     <benchmark>  <operations>  <real time (s)>  <operations per second>
+ *
+ * Lines are appended to the file named by the NDNSIM_BENCHMARK_RESULTS environment variable,
+ * or printed to the standard output if it is not set.  The random seed is fixed, so that
+ * every run executes the same workload.
+ */
+class BenchmarkFixture : public CleanupFixture
+{
+protected:
+  BenchmarkFixture()
+  {
+#ifdef _DEBUG
+    BOOST_TEST_MESSAGE("Benchmark compiled in debug mode is unreliable, "
+                       "please compile in release mode.");
+#endif // _DEBUG
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+  }
+
+  ~BenchmarkFixture()
+  {
+    // attribute defaults set by a benchmark do not leak into the next ones
+    Config::Reset();
+  }
+
+  time::nanoseconds
+  timedRun(std::function<void()> f)
+  {
+    time::steady_clock::TimePoint t1 = time::steady_clock::now();
+    f();
+    time::steady_clock::TimePoint t2 = time::steady_clock::now();
+    return t2 - t1;
+  }
+
+  /**
+   * \brief Report a measurement, named after the current test case
+   */
+  void
+  report(uint64_t nOperations, time::nanoseconds duration)
+  {
+    double seconds = duration.count() / 1e9;
+    std::ostringstream os;
+    os << getTestName() << "\t"
+       << nOperations << "\t"
+       << seconds << "\t"
+       << (seconds == 0 ? 0 : nOperations / seconds) << "\n";
+    write(os.str());
+  }
+
+  /**
+   * \brief Report a quantity other than real time, e.g. events per packet or convergence time
+   *
+   * The line is named after the current test case, followed by \p metric:
+   *
+   *     <benchmark>:<metric>  <value>
+   */
+  void
+  reportMetric(const std::string& metric, double value)
+  {
+    std::ostringstream os;
+    os << getTestName() << ":" << metric << "\t" << value << "\n";
+    write(os.str());
+  }
+
+  /**
+   * \brief Count the events scheduled in the simulator from now on
+   *
+   * Must be called before anything is scheduled, CountingScheduler::getNEvents() then
+   * returns the number of scheduled events.
+   */
+  static void
+  useCountingScheduler()
+  {
+    ObjectFactory scheduler;
+    scheduler.SetTypeId(CountingScheduler::GetTypeId());
+    Simulator::SetScheduler(scheduler);
+    CountingScheduler::getNEvents() = 0;
+  }
+
+  /**
+   * \brief Number of Interests and Data received by the forwarders of all nodes
+   */
+  static uint64_t
+  getNForwardedPackets()
+  {
+    uint64_t nPackets = 0;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      const auto& counters = (*node)->GetObject<L3Protocol>()->getForwarder()->getCounters();
+      nPackets += counters.getNInInterests() + counters.getNInDatas();
+    }
+    return nPackets;
+  }
+
+  /**
+   * \brief Rocketfuel map (.cch file) named by the NDNSIM_BENCHMARK_ROCKETFUEL_MAP environment
+   *        variable, or an empty string if it is not set
+   *
+   * Rocketfuel maps are not shipped with ndnSIM, benchmarks on them are skipped without a map.
+   */
+  static std::string
+  getRocketfuelMap()
+  {
+    const char* path = std::getenv("NDNSIM_BENCHMARK_ROCKETFUEL_MAP");
+    if (path == nullptr) {
+      BOOST_TEST_MESSAGE("NDNSIM_BENCHMARK_ROCKETFUEL_MAP is not set, skipping");
+      return "";
+    }
+    return path;
+  }
+
+  /**
+   * \brief Link parameters given to RocketfuelMapReader::Read
+   */
+  static RocketfuelParams
+  getRocketfuelParams()
+  {
+    RocketfuelParams params;
+    params.averageRtt = 0.25;
+    params.clientNodeDegrees = 2;
+    params.minb2bBandwidth = "40Mbps";
+    params.minb2bDelay = "5ms";
+    params.maxb2bBandwidth = "100Mbps";
+    params.maxb2bDelay = "10ms";
+    params.minb2gBandwidth = "10Mbps";
+    params.minb2gDelay = "5ms";
+    params.maxb2gBandwidth = "20Mbps";
+    params.maxb2gDelay = "10ms";
+    params.ming2cBandwidth = "1Mbps";
+    params.ming2cDelay = "70ms";
+    params.maxg2cBandwidth = "3Mbps";
+    params.maxg2cDelay = "10ms";
+    return params;
+  }
+
+  static shared_ptr<Interest>
+  makeInterest(const Name& name)
+  {
+    auto interest = make_shared<Interest>(name);
+    interest->setNonce(1);
+    interest->wireEncode();
+    return interest;
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name, size_t payloadSize = 1024)
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(time::seconds(3600));
+    data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+
+    data->wireEncode();
+    return data;
+  }
+
+  /**
+   * \brief Name of the i-th packet of a workload, /benchmark/<i % 4>/<i>
+   */
+  static Name
+  makeName(size_t i)
+  {
+    Name name("/benchmark");
+    name.appendNumber(i % 4);
+    name.appendNumber(i);
+    return name;
+  }
+
+private:
+  static std::string
+  getTestName()
+  {
+    const auto& testCase = boost::unit_test::framework::current_test_case();
+    return boost::unit_test::framework::get<boost::unit_test::test_suite>(
+             testCase.p_parent_id).p_name.get() + "/" + testCase.p_name.get();
+  }
+
+  static void
+  write(const std::string& line)
+  {
+    const char* path = std::getenv("NDNSIM_BENCHMARK_RESULTS");
+    if (path != nullptr) {
+      std::ofstream results(path, std::ios::app);
+      results << line;
+    }
+    else {
+      std::cout << line;
+    }
+  }
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_TESTS_BENCHMARKS_BENCHMARK_COMMON_HPP
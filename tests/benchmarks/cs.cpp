@@ -0,0 +1,162 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark-common.hpp"
+
+#include "NFD/daemon/table/cs.hpp"
+#include "model/cs/ndn-content-store.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const size_t N_ENTRIES = 50000;
+const size_t N_LOOKUPS = 200000;
+
+class CsBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  CsBenchmarkFixture()
+  {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      interests.push_back(makeInterest(makeName(i)));
+      datas.push_back(makeData(makeName(i)));
+    }
+  }
+
+  /**
+   * \brief Fill a content store of the ndnSIM \p typeId, then look up cached Data
+   */
+  void
+  runNdnSimContentStore(const std::string& typeId)
+  {
+    ObjectFactory factory;
+    factory.SetTypeId(typeId);
+    factory.Set("MaxSize", StringValue(std::to_string(N_ENTRIES)));
+    Ptr<ContentStore> cs = factory.Create<ContentStore>();
+
+    for (const shared_ptr<Data>& data : datas) {
+      cs->Add(data);
+    }
+
+    size_t nHits = 0;
+    time::nanoseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_LOOKUPS; ++i) {
+        if (cs->Lookup(interests[i % N_ENTRIES]) != nullptr) {
+          ++nHits;
+        }
+      }
+    });
+    BOOST_CHECK_EQUAL(nHits, N_LOOKUPS);
+    report(N_LOOKUPS, d);
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TableCs, CsBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(NfdInsert)
+{
+  nfd::Cs cs(N_ENTRIES);
+  time::nanoseconds d = timedRun([&] {
+    for (const shared_ptr<Data>& data : datas) {
+      cs.insert(*data);
+    }
+  });
+  BOOST_CHECK_EQUAL(cs.size(), N_ENTRIES);
+  report(N_ENTRIES, d);
+}
+
+BOOST_AUTO_TEST_CASE(NfdFindHit)
+{
+  nfd::Cs cs(N_ENTRIES);
+  for (const shared_ptr<Data>& data : datas) {
+    cs.insert(*data);
+  }
+
+  size_t nHits = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_LOOKUPS; ++i) {
+      cs.find(*interests[i % N_ENTRIES],
+              [&nHits] (const Interest&, const Data&) { ++nHits; },
+              [] (const Interest&) {});
+    }
+  });
+  BOOST_CHECK_EQUAL(nHits, N_LOOKUPS);
+  report(N_LOOKUPS, d);
+}
+
+BOOST_AUTO_TEST_CASE(NfdFindRightmostDeep)
+{
+  // versioned segments under deep hierarchical prefixes, looked up with ChildSelector=1
+  const size_t N_CHILDREN = 10;
+  const size_t N_PREFIXES = N_ENTRIES / N_CHILDREN;
+  const Name ROOT("/ndn/edu/university/department/group/user/application/video/stream");
+
+  nfd::Cs cs(N_ENTRIES);
+  std::vector<shared_ptr<Interest>> rightmostInterests;
+  for (size_t i = 0; i < N_PREFIXES; ++i) {
+    Name prefix = Name(ROOT).appendNumber(i);
+    for (size_t j = 0; j < N_CHILDREN; ++j) {
+      cs.insert(*makeData(Name(prefix).appendVersion(j).appendSegment(0)));
+    }
+    shared_ptr<Interest> interest = makeInterest(prefix);
+    interest->setChildSelector(1);
+    rightmostInterests.push_back(interest);
+  }
+  BOOST_REQUIRE_EQUAL(cs.size(), N_ENTRIES);
+
+  size_t nHits = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_LOOKUPS; ++i) {
+      cs.find(*rightmostInterests[i % N_PREFIXES],
+              [&nHits] (const Interest&, const Data&) { ++nHits; },
+              [] (const Interest&) {});
+    }
+  });
+  BOOST_CHECK_EQUAL(nHits, N_LOOKUPS);
+  report(N_LOOKUPS, d);
+}
+
+BOOST_AUTO_TEST_CASE(NdnSimLru)
+{
+  runNdnSimContentStore("ns3::ndn::cs::Lru");
+}
+
+BOOST_AUTO_TEST_CASE(NdnSimStatsLru)
+{
+  runNdnSimContentStore("ns3::ndn::cs::Stats::Lru");
+}
+
+BOOST_AUTO_TEST_CASE(NdnSimFreshnessLru)
+{
+  runNdnSimContentStore("ns3::ndn::cs::Freshness::Lru");
+}
+
+BOOST_AUTO_TEST_CASE(NdnSimProbabilityLru)
+{
+  runNdnSimContentStore("ns3::ndn::cs::Probability::Lru");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,126 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "benchmark-common.hpp"
+
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "model/ndn-net-device-face.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Goodput of Data packets sent over 802.11a, which NetDeviceFace fragments with NDNLP
+ *        when they exceed the MTU (2296 bytes)
+ *
+ *      +----------+     802.11a     +----------+
+ *      | consumer | <~~~~~~~~~~~~~> | producer |
+ *      +----------+     (adhoc)     +----------+
+ *
+ * The consumer sends 200 Interests per second during 10 seconds of simulated time.  Interests
+ * that are not satisfied (e.g., because a fragment was lost) are not retransmitted within the
+ * measurement, so the loss rate is reported as well.  The operations are the Data received.
+ */
+class FragmentationBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  void
+  run(uint32_t payloadSize)
+  {
+    const std::string dataMode = "OfdmRate54Mbps";
+    const Time simulationTime = Seconds(10);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    Ptr<Node> consumer = nodes.Get(0);
+    Ptr<Node> producer = nodes.Get(1);
+
+    WifiHelper wifi = WifiHelper::Default();
+    wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode",
+                                 StringValue(dataMode), "NonUnicastMode", StringValue(dataMode));
+
+    YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default();
+    wifiPhyHelper.SetChannel(wifiChannel.Create());
+
+    NqosWifiMacHelper wifiMacHelper = NqosWifiMacHelper::Default();
+    wifiMacHelper.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(wifiPhyHelper, wifiMacHelper, nodes);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    positions->Add(Vector(10, 0, 0));
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    ndnHelper.InstallAll();
+
+    StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(200));
+    consumerHelper.Install(consumer).Stop(simulationTime);
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", UintegerValue(payloadSize));
+    producerHelper.Install(producer);
+
+    // let the last Data packets arrive
+    Simulator::Stop(simulationTime + Seconds(1));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    const nfd::FaceCounters& counters =
+      consumer->GetObject<L3Protocol>()->getFaceByNetDevice(devices.Get(0))->getCounters();
+    uint64_t nInterests = counters.getNOutInterests();
+    uint64_t nDatas = counters.getNInDatas();
+
+    BOOST_REQUIRE_GT(nInterests, 0);
+    report(nDatas, d);
+    reportMetric("GoodputMbps", nDatas * payloadSize * 8.0 / simulationTime.GetSeconds() / 1e6);
+    reportMetric("LossRate", 1.0 - 1.0 * nDatas / nInterests);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(FaceFragmentation, FragmentationBenchmarkFixture)
+
+// below the MTU, as a reference
+BOOST_AUTO_TEST_CASE(Payload1024)
+{
+  run(1024);
+}
+
+BOOST_AUTO_TEST_CASE(Payload8192)
+{
+  run(8192);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
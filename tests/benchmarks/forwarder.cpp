@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark-common.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/fw/forwarder-mapme.hpp"
+#include "NFD/daemon/fw/forwarder-kite.hpp"
+#include "NFD/daemon/fw/forwarder-anchor.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const size_t N_PACKETS = 50000;
+
+/**
+ * \brief Face which discards the packets sent by the forwarder
+ */
+class BenchmarkFace : public nfd::Face
+{
+public:
+  BenchmarkFace()
+    : Face(nfd::FaceUri("benchmark://"), nfd::FaceUri("benchmark://"))
+    , nSentInterests(0)
+    , nSentDatas(0)
+  {
+  }
+
+  void
+  sendInterest(const Interest& interest) DECL_OVERRIDE
+  {
+    ++nSentInterests;
+  }
+
+  void
+  sendData(const Data& data) DECL_OVERRIDE
+  {
+    ++nSentDatas;
+  }
+
+  void
+  close() DECL_OVERRIDE
+  {
+    this->fail("close");
+  }
+
+  void
+  receiveInterest(const Interest& interest)
+  {
+    this->emitSignal(onReceiveInterest, interest);
+  }
+
+  void
+  receiveData(const Data& data)
+  {
+    this->emitSignal(onReceiveData, data);
+  }
+
+public:
+  size_t nSentInterests;
+  size_t nSentDatas;
+};
+
+class ForwarderBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  ForwarderBenchmarkFixture()
+  {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      interests.push_back(makeInterest(makeName(i)));
+      datas.push_back(makeData(makeName(i)));
+    }
+  }
+
+  /**
+   * \brief Forward Interests from a downstream face to the producer face, then the Data back
+   *
+   * A packet is either an Interest or a Data, each Interest is satisfied.
+   */
+  void
+  runPipelines(nfd::Forwarder& forwarder)
+  {
+    auto downstream = make_shared<BenchmarkFace>();
+    auto upstream = make_shared<BenchmarkFace>();
+    forwarder.addFace(downstream);
+    forwarder.addFace(upstream);
+    forwarder.getFib().insert("/benchmark").first->addNextHop(upstream, 0);
+
+    time::nanoseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        downstream->receiveInterest(*interests[i]);
+        upstream->receiveData(*datas[i]);
+      }
+    });
+    BOOST_CHECK_GE(upstream->nSentInterests, N_PACKETS);
+    BOOST_CHECK_EQUAL(downstream->nSentDatas, N_PACKETS);
+    report(N_PACKETS * 2, d);
+  }
+
+protected:
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FwForwarder, ForwarderBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Vanilla)
+{
+  nfd::Forwarder forwarder;
+  runPipelines(forwarder);
+}
+
+#ifdef MAPME
+BOOST_AUTO_TEST_CASE(MapMe)
+{
+  nfd::ForwarderMapMe forwarder(MAPME_DEFAULT_TU);
+  runPipelines(forwarder);
+}
+#endif // MAPME
+
+#ifdef ANCHOR
+BOOST_AUTO_TEST_CASE(Anchor)
+{
+  nfd::ForwarderAnchor forwarder;
+  runPipelines(forwarder);
+}
+#endif // ANCHOR
+
+#ifdef KITE
+BOOST_AUTO_TEST_CASE(Kite)
+{
+  nfd::ForwarderKite forwarder;
+  runPipelines(forwarder);
+}
+#endif // KITE
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,761 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "benchmark-common.hpp"
+
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "model/ndn-net-device-face.hpp"
+#include "utils/mem-usage.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#ifdef MAPME
+#include "NFD/daemon/fw/forwarder-mapme.hpp"
+#endif // MAPME
+
+#ifdef KITE
+#include "NFD/daemon/fw/forwarder-kite.hpp"
+#endif // KITE
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Fixture of the mobility benchmarks
+ *
+ * Tree scenarios move a producer between the access routers (leaves) of a tree of routers,
+ * by replacing its point-to-point link:
+ *
+ *                          +--------+
+ *                          |  root  |
+ *                          +--------+
+ *                         /    |     \
+ *                       ...   ...    ...       (fanout^depth access routers)
+ *                      /        |       \
+ *              +--------+   +--------+   +--------+
+ *              | access |   | access |   | access |
+ *              +--------+   +--------+   +--------+
+ *                               :
+ *                           producer
+ *
+ * Wifi scenarios move a node back and forth between two access points 80m apart, with a
+ * range of 50m, serving the same SSID on the same channel.  The wifi interface of the node
+ * is the same before and after a handover, the forwarder learns about the moves from the
+ * reassociation procedure.
+ */
+class MobilityBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  MobilityBenchmarkFixture()
+    : nWifiHandovers(0)
+    , isAssociated(false)
+    , hasFirstData(true)
+    , nRecoveredHandovers(0)
+  {
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("2ms"));
+  }
+
+  /**
+   * \brief Create a tree of routers and the producer, attached to the first access router
+   *
+   * The root is routers.Get(0), the children of router i are fanout*i+1 ... fanout*i+fanout.
+   * The stack must be installed after the tree is created.
+   */
+  void
+  createTree(uint32_t fanout, uint32_t depth)
+  {
+    uint32_t nRouters = 1;
+    uint32_t levelSize = 1;
+    for (uint32_t level = 0; level < depth; ++level) {
+      levelSize *= fanout;
+      nRouters += levelSize;
+    }
+    routers.Create(nRouters);
+
+    for (uint32_t i = 1; i < nRouters; ++i) {
+      p2p.Install(routers.Get((i - 1) / fanout), routers.Get(i));
+    }
+    for (uint32_t i = nRouters - levelSize; i < nRouters; ++i) {
+      accessRouters.Add(routers.Get(i));
+    }
+
+    producer = CreateObject<Node>();
+    attachProducer(accessRouters.Get(0));
+  }
+
+  /**
+   * \brief Detach the producer from its access router and attach it to \p accessRouter
+   *
+   * The faces of the new link are added to the forwarders, which triggers the mobility scheme.
+   */
+  void
+  attachProducer(Ptr<Node> accessRouter)
+  {
+    if (producerDevice != nullptr) {
+      for (Ptr<NetDevice> device : {producerDevice, accessDevice}) {
+        Ptr<L3Protocol> ndn = device->GetNode()->GetObject<L3Protocol>();
+        shared_ptr<Face> face = ndn->getFaceByNetDevice(device);
+        if (face != nullptr) {
+          ndn->removeFace(face);
+        }
+      }
+    }
+
+    NetDeviceContainer devices = p2p.Install(producer, accessRouter);
+    producerDevice = devices.Get(0);
+    accessDevice = devices.Get(1);
+
+    if (producer->GetObject<L3Protocol>() == nullptr) {
+      // initial attachment, the stack is installed with all other nodes
+      return;
+    }
+
+    for (Ptr<NetDevice> device : {accessDevice, producerDevice}) {
+      Ptr<Node> node = device->GetNode();
+      node->GetObject<L3Protocol>()->addFace(std::make_shared<NetDeviceFace>(node, device));
+    }
+  }
+
+  /**
+   * \brief Index of the access router of the producer in accessRouters
+   */
+  uint32_t
+  getProducerAccessRouter() const
+  {
+    uint32_t current = 0;
+    while (accessRouters.Get(current) != accessDevice->GetNode()) {
+      ++current;
+    }
+    return current;
+  }
+
+  /**
+   * \brief Create two access points below \p parent, and a \p mobile node moving between them
+   *
+   * The access points are aps.Get(0) and aps.Get(1).  The mobile node starts under the first
+   * one, then crosses \p nCrossings times.  The simulation is stopped after the last crossing.
+   *
+   * \return the wifi device of the mobile node
+   */
+  Ptr<NetDevice>
+  createWifiAccess(Ptr<Node> parent, Ptr<Node> mobile, uint32_t nCrossings)
+  {
+    const double apDistance = 80;
+    const double speed = 5;
+
+    // disable fragmentation
+    Config::SetDefault("ns3::WifiRemoteStationManager::FragmentationThreshold",
+                       StringValue("2200"));
+    Config::SetDefault("ns3::WifiRemoteStationManager::RtsCtsThreshold", StringValue("2200"));
+
+    aps.Create(2);
+    p2p.Install(parent, aps.Get(0));
+    p2p.Install(parent, aps.Get(1));
+
+    WifiHelper wifi = WifiHelper::Default();
+    wifi.SetStandard(WIFI_PHY_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager", "DataMode",
+                                 StringValue("OfdmRate24Mbps"));
+
+    YansWifiChannelHelper wifiChannel;
+    wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    wifiChannel.AddPropagationLoss("ns3::RangePropagationLossModel", "MaxRange", DoubleValue(50));
+
+    YansWifiPhyHelper wifiPhyHelper = YansWifiPhyHelper::Default();
+    wifiPhyHelper.SetChannel(wifiChannel.Create());
+
+    Ssid ssid("ndn");
+    NqosWifiMacHelper wifiMacHelper = NqosWifiMacHelper::Default();
+    wifiMacHelper.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    wifi.Install(wifiPhyHelper, wifiMacHelper, aps);
+    wifiMacHelper.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid), "ActiveProbing",
+                          BooleanValue(false));
+    Ptr<NetDevice> device = wifi.Install(wifiPhyHelper, wifiMacHelper, mobile).Get(0);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    positions->Add(Vector(apDistance, 0, 0));
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(aps);
+
+    // back and forth between the access points, pausing under each of them
+    mobility.SetMobilityModel("ns3::WaypointMobilityModel");
+    mobility.Install(mobile);
+    Ptr<WaypointMobilityModel> waypoints = mobile->GetObject<WaypointMobilityModel>();
+    Time leg = Seconds(apDistance / speed);
+    Time pause = Seconds(2);
+    Time t = Seconds(0);
+    for (uint32_t i = 0; i <= nCrossings; ++i) {
+      double x = (i % 2 == 0) ? 0 : apDistance;
+      waypoints->AddWaypoint(Waypoint(t, Vector(x, 10, 0)));
+      t += pause;
+      waypoints->AddWaypoint(Waypoint(t, Vector(x, 10, 0)));
+      t += leg;
+    }
+    Simulator::Stop(t + pause);
+
+    Ptr<WifiMac> mac = DynamicCast<WifiNetDevice>(device)->GetMac();
+    mac->TraceConnectWithoutContext("Assoc",
+                                    MakeCallback(&MobilityBenchmarkFixture::onAssoc, this));
+    mac->TraceConnectWithoutContext("DeAssoc",
+                                    MakeCallback(&MobilityBenchmarkFixture::onDeAssoc, this));
+    return device;
+  }
+
+  /**
+   * \brief Follow the Data received by \p consumer, to measure the handover latency
+   */
+  void
+  traceConsumer(Ptr<Application> consumer)
+  {
+    consumer->TraceConnectWithoutContext("LastRetransmittedInterestDataDelay",
+                                         MakeCallback(&MobilityBenchmarkFixture::onData, this));
+  }
+
+  /**
+   * \brief Report the mean delay from an association to the first Data received after it,
+   *        and the mean longest gap between two Data around a handover
+   */
+  void
+  reportHandovers()
+  {
+    BOOST_CHECK_GT(nWifiHandovers, 0);
+    reportMetric("Handovers", nWifiHandovers);
+    reportMetric("RecoveredHandovers", nRecoveredHandovers);
+    if (nRecoveredHandovers > 0) {
+      reportMetric("FirstDataMs", totalLatency.ToDouble(Time::MS) / nRecoveredHandovers);
+      reportMetric("MaxGapMs", totalGap.ToDouble(Time::MS) / nRecoveredHandovers);
+    }
+  }
+
+private:
+  void
+  onDeAssoc(Mac48Address address)
+  {
+    isAssociated = false;
+    deAssocTime = Simulator::Now();
+    maxGap = Simulator::Now() - lastDataTime;
+  }
+
+  void
+  onAssoc(Mac48Address address)
+  {
+    isAssociated = true;
+    if (deAssocTime.IsZero()) {
+      // initial association
+      return;
+    }
+
+    ++nWifiHandovers;
+    assocTime = Simulator::Now();
+    hasFirstData = false;
+  }
+
+  void
+  onData(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount)
+  {
+    Time now = Simulator::Now();
+    if (nWifiHandovers > 0 && !hasFirstData && isAssociated) {
+      hasFirstData = true;
+      ++nRecoveredHandovers;
+      totalLatency += now - assocTime;
+      totalGap += std::max(maxGap, now - lastDataTime);
+    }
+    lastDataTime = now;
+  }
+
+protected:
+  PointToPointHelper p2p;
+
+  NodeContainer routers;
+  NodeContainer accessRouters;
+  Ptr<Node> producer;
+  Ptr<NetDevice> producerDevice;
+  Ptr<NetDevice> accessDevice;
+
+  NodeContainer aps;
+
+private:
+  uint32_t nWifiHandovers;
+  bool isAssociated;
+  bool hasFirstData;
+  Time deAssocTime;
+  Time assocTime;
+  Time lastDataTime;
+  Time maxGap;
+
+  uint32_t nRecoveredHandovers;
+  Time totalLatency;
+  Time totalGap;
+};
+
+#ifdef MAPME
+
+/**
+ * \brief Cost of MAP-Me handovers of a producer serving many prefixes
+ *
+ * No data traffic is generated.  For each handover, the time until the last special
+ * interest is processed (convergence time), and the number and size of MAP-Me packets sent
+ * by all nodes are measured.  Tu is 0, so every handover is signalled with updates.
+ */
+class MapMeBenchmarkFixture : public MobilityBenchmarkFixture
+{
+protected:
+  MapMeBenchmarkFixture()
+    : rand(CreateObject<UniformRandomVariable>())
+    , nHandovers(10)
+    , handoverCount(0)
+    , nMessages(0)
+    , nBytes(0)
+  {
+  }
+
+  void
+  run(uint32_t nPrefixes, bool isBatched)
+  {
+    const uint32_t fanout = 4;
+
+    Config::SetDefault("ns3::ndn::L3Protocol::mobility_scheme", StringValue("mapme"));
+    Config::SetDefault("ns3::ndn::L3Protocol::BatchedUpdates", BooleanValue(isBatched));
+    Config::SetDefault("ns3::ndn::L3Protocol::Tu", UintegerValue(0));
+
+    createTree(fanout, 3);
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto mapme = std::dynamic_pointer_cast<nfd::ForwarderMapMe>(
+                     (*node)->GetObject<L3Protocol>()->getForwarder());
+      BOOST_REQUIRE(mapme != nullptr);
+      mapme->m_onProcessing = MakeCallback(&MapMeBenchmarkFixture::onSpecialInterest, this);
+    }
+    Config::ConnectWithoutContext("/NodeList/*/$ns3::ndn::L3Protocol/OutInterests",
+                                  MakeCallback(&MapMeBenchmarkFixture::onOutInterest, this));
+
+    // every router points towards the first access router, where the producer starts
+    uint32_t first = routers.GetN() - accessRouters.GetN();
+    std::vector<int32_t> nextHop(routers.GetN(), -1);
+    for (uint32_t i = first; i > 0; i = (i - 1) / fanout) {
+      nextHop[(i - 1) / fanout] = i;
+    }
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    for (uint32_t p = 0; p < nPrefixes; ++p) {
+      std::string prefix = "/prefix/" + std::to_string(p);
+      for (uint32_t i = 0; i < routers.GetN(); ++i) {
+        Ptr<Node> next = i == first ? producer :
+                         nextHop[i] >= 0 ? routers.Get(nextHop[i]) :
+                         routers.Get((i - 1) / fanout);
+        FibHelper::AddRoute(routers.Get(i), prefix, next, 1);
+      }
+      producerHelper.SetPrefix(prefix);
+      producerHelper.Install(producer);
+    }
+
+    Simulator::Schedule(Seconds(1), &MapMeBenchmarkFixture::handover, this);
+
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    BOOST_CHECK_EQUAL(handoverCount, nHandovers);
+    report(nHandovers, d);
+    reportMetric("ConvergenceMs", totalConvergence.ToDouble(Time::MS) / nHandovers);
+    reportMetric("MessagesPerHandover", 1.0 * nMessages / nHandovers);
+    reportMetric("BytesPerHandover", 1.0 * nBytes / nHandovers);
+  }
+
+private:
+  void
+  handover()
+  {
+    if (handoverCount > 0) {
+      totalConvergence += lastUpdateTime - handoverTime;
+    }
+    if (handoverCount == nHandovers) {
+      Simulator::Stop();
+      return;
+    }
+
+    ++handoverCount;
+    handoverTime = lastUpdateTime = Simulator::Now();
+
+    // move to any other access router
+    uint32_t current = getProducerAccessRouter();
+    uint32_t next = rand->GetInteger(0, accessRouters.GetN() - 2);
+    attachProducer(accessRouters.Get(next < current ? next : next + 1));
+
+    Simulator::Schedule(Seconds(1), &MapMeBenchmarkFixture::handover, this);
+  }
+
+  void
+  onSpecialInterest(std::string prefix, uint64_t seq, uint64_t ttl, uint64_t nRetx)
+  {
+    lastUpdateTime = Simulator::Now();
+  }
+
+  void
+  onOutInterest(const Interest& interest, const Face& face)
+  {
+    if (interest.getSpecialInterestType() == ::ndn::tlv::TYPE_UNDEFINED) {
+      return;
+    }
+    ++nMessages;
+    nBytes += interest.wireEncode().size();
+  }
+
+private:
+  Ptr<UniformRandomVariable> rand;
+  const uint32_t nHandovers;
+  uint32_t handoverCount;
+  Time handoverTime;
+  Time lastUpdateTime;
+  Time totalConvergence;
+  uint64_t nMessages;
+  uint64_t nBytes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(MobilityMapMe, MapMeBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Prefixes100)
+{
+  run(100, false);
+}
+
+BOOST_AUTO_TEST_CASE(Prefixes100Batched)
+{
+  run(100, true);
+}
+
+BOOST_AUTO_TEST_CASE(Prefixes1000)
+{
+  run(1000, false);
+}
+
+BOOST_AUTO_TEST_CASE(Prefixes1000Batched)
+{
+  run(1000, true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // MAPME
+
+#ifdef KITE
+
+/**
+ * \brief Per-Interest processing cost of KITE under producer mobility
+ *
+ * 16 consumers spread over the access routers request /prefix/<seq> 100 times per second,
+ * and follow the trace left by the producer towards the root (anchor).  Every second, the
+ * producer moves to a random access router, which triggers a new trace.  The operations are
+ * the Interests received by the forwarders during 60 seconds of simulated time.
+ */
+class KiteBenchmarkFixture : public MobilityBenchmarkFixture
+{
+protected:
+  KiteBenchmarkFixture()
+    : rand(CreateObject<UniformRandomVariable>())
+    , nSpecialInterests(0)
+  {
+  }
+
+  void
+  run(bool isPull)
+  {
+    const uint32_t fanout = 4;
+    const uint32_t nConsumers = 16;
+
+    Config::SetDefault("ns3::ndn::L3Protocol::mobility_scheme", StringValue("kite"));
+
+    createTree(fanout, 3);
+    NodeContainer consumers;
+    consumers.Create(nConsumers);
+    for (uint32_t i = 0; i < nConsumers; ++i) {
+      p2p.Install(consumers.Get(i), accessRouters.Get(i % accessRouters.GetN()));
+    }
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto kite = std::dynamic_pointer_cast<nfd::ForwarderKite>(
+                    (*node)->GetObject<L3Protocol>()->getForwarder());
+      BOOST_REQUIRE(kite != nullptr);
+      kite->setPull(isPull);
+      kite->m_onSpecialInterest = MakeCallback(&KiteBenchmarkFixture::onSpecialInterest, this);
+      kite->m_onProcessing = MakeCallback(&KiteBenchmarkFixture::onSpecialInterest, this);
+    }
+
+    // traced Interests climb the tree towards the anchor, which has no route for the prefix
+    for (uint32_t i = 1; i < routers.GetN(); ++i) {
+      FibHelper::AddRoute(routers.Get(i), "/prefix", routers.Get((i - 1) / fanout), 1);
+    }
+    for (uint32_t i = 0; i < nConsumers; ++i) {
+      FibHelper::AddRoute(consumers.Get(i), "/prefix",
+                          accessRouters.Get(i % accessRouters.GetN()), 1);
+    }
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(100));
+    consumerHelper.Install(consumers);
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producer);
+
+    Simulator::Schedule(Seconds(1), &KiteBenchmarkFixture::handover, this);
+    Simulator::Stop(Seconds(60));
+
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    uint64_t nInterests = 0;
+    uint64_t nPitEntries = 0;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      shared_ptr<nfd::Forwarder> forwarder = (*node)->GetObject<L3Protocol>()->getForwarder();
+      nInterests += forwarder->getCounters().getNInInterests();
+      nPitEntries += forwarder->getPit().size();
+    }
+    BOOST_CHECK_GT(nInterests, 0);
+    report(nInterests, d);
+    reportMetric("SpecialInterests", nSpecialInterests);
+    reportMetric("PitEntries", nPitEntries);
+    reportMetric("MemoryMiB", MemUsage::Get() / 1024.0 / 1024.0);
+  }
+
+private:
+  void
+  handover()
+  {
+    attachProducer(accessRouters.Get(rand->GetInteger(0, accessRouters.GetN() - 1)));
+    Simulator::Schedule(Seconds(1), &KiteBenchmarkFixture::handover, this);
+  }
+
+  void
+  onSpecialInterest(std::string prefix, uint64_t seq, uint64_t ttl, uint64_t nRetx)
+  {
+    ++nSpecialInterests;
+  }
+
+private:
+  Ptr<UniformRandomVariable> rand;
+  uint64_t nSpecialInterests;
+};
+
+BOOST_FIXTURE_TEST_SUITE(MobilityKite, KiteBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Push)
+{
+  run(false);
+}
+
+BOOST_AUTO_TEST_CASE(Pull)
+{
+  run(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // KITE
+
+#ifdef MLDR
+
+/**
+ * \brief Handover latency of a mobile consumer, with and without MLDR
+ *
+ *                       +----------+      +--------+
+ *                       | producer | ---- | router |
+ *                       +----------+      +--------+
+ *                                         /        \
+ *                                   +-----+        +-----+
+ *                                   | AP1 |        | AP2 |
+ *                                   +-----+        +-----+
+ *                                       :            :
+ *                                       consumer <-->
+ *
+ * The consumer requests 100 Data per second and crosses 5 times.  Without MLDR, the
+ * Interests lost on the old access link are only recovered by the consumer RTO.
+ */
+class MldrBenchmarkFixture : public MobilityBenchmarkFixture
+{
+protected:
+  void
+  run(bool isMldrEnabled)
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::Mldr", BooleanValue(isMldrEnabled));
+    Config::SetDefault("ns3::ndn::L3Protocol::Reassociation", BooleanValue(true));
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("5ms"));
+
+    Ptr<Node> router = CreateObject<Node>();
+    producer = CreateObject<Node>();
+    Ptr<Node> consumer = CreateObject<Node>();
+    p2p.Install(producer, router);
+    createWifiAccess(router, consumer, 5);
+
+    StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    ndnHelper.InstallAll();
+
+    FibHelper::AddRoute(router, "/prefix", producer, 1);
+    FibHelper::AddRoute(aps.Get(0), "/prefix", router, 1);
+    FibHelper::AddRoute(aps.Get(1), "/prefix", router, 1);
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producer);
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(100));
+    traceConsumer(consumerHelper.Install(consumer).Get(0));
+
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    report(getNForwardedPackets(), d);
+    reportHandovers();
+    nfd::MldrMechanism* mldr = consumer->GetObject<L3Protocol>()->getForwarder()->getMldr();
+    reportMetric("MldrRetransmissions", mldr == nullptr ? 0 : mldr->getNRetransmissions());
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(MobilityMldr, MldrBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  run(false);
+}
+
+BOOST_AUTO_TEST_CASE(Enabled)
+{
+  run(true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // MLDR
+
+#ifdef CONF_FILE
+
+/**
+ * \brief Handover latency of a mobile producer for each mobility scheme
+ *
+ *                              +------+
+ *                              | root |
+ *                              +------+
+ *                             /   |    \
+ *                       +-----+ +-----+ +----+      +----------+
+ *                       | AP1 | | AP2 | | R3 | ---- | consumer |
+ *                       +-----+ +-----+ +----+      +----------+
+ *                           :     :
+ *                          producer
+ *
+ * The consumer requests 100 Data per second and the producer crosses 5 times.  Routes
+ * initially point towards AP1: vanilla forwarding only recovers when the producer is back
+ * under AP1.
+ */
+class HandoverBenchmarkFixture : public MobilityBenchmarkFixture
+{
+protected:
+  void
+  run(const std::string& scheme)
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::mobility_scheme", StringValue(scheme));
+    Config::SetDefault("ns3::ndn::L3Protocol::Reassociation", BooleanValue(true));
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("5ms"));
+
+    Ptr<Node> root = CreateObject<Node>();
+    Ptr<Node> router = CreateObject<Node>();
+    producer = CreateObject<Node>();
+    Ptr<Node> consumer = CreateObject<Node>();
+    createWifiAccess(root, producer, 5);
+    p2p.Install(root, router);
+    p2p.Install(router, consumer);
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    FibHelper::AddRoute(consumer, "/prefix", router, 1);
+    FibHelper::AddRoute(router, "/prefix", root, 1);
+    if (scheme == "kite") {
+      // traced Interests climb towards the root, which has no route for the prefix
+      FibHelper::AddRoute(aps.Get(0), "/prefix", root, 1);
+      FibHelper::AddRoute(aps.Get(1), "/prefix", root, 1);
+    }
+    else {
+      // towards AP1, where the producer starts
+      FibHelper::AddRoute(root, "/prefix", aps.Get(0), 1);
+      FibHelper::AddRoute(aps.Get(0), "/prefix", producer, 1);
+      FibHelper::AddRoute(aps.Get(1), "/prefix", root, 1);
+    }
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producer);
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(100));
+    traceConsumer(consumerHelper.Install(consumer).Get(0));
+
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    report(getNForwardedPackets(), d);
+    reportHandovers();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(MobilityHandover, HandoverBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Vanilla)
+{
+  run("vanilla");
+}
+
+#ifdef MAPME
+BOOST_AUTO_TEST_CASE(MapMe)
+{
+  run("mapme");
+}
+#endif // MAPME
+
+#ifdef KITE
+BOOST_AUTO_TEST_CASE(Kite)
+{
+  run("kite");
+}
+#endif // KITE
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // CONF_FILE
+
+} // namespace ndn
+} // namespace ns3
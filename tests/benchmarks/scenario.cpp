@@ -0,0 +1,388 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark-common.hpp"
+
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+namespace ndn {
+
+class ScenarioBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  /**
+   * \brief Simulate the topology \p fileName of examples/topologies
+   *
+   * The first node of the topology requests 1000 Data per second from the last one, during
+   * 10 seconds of simulated time.  The operations are the packets received by the forwarders.
+   */
+  void
+  runTopology(const std::string& fileName)
+  {
+    AnnotatedTopologyReader topologyReader("", 25);
+    topologyReader.SetFileName("src/ndnSIM/examples/topologies/" + fileName);
+    topologyReader.Read();
+    NodeContainer nodes = topologyReader.GetNodes();
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    routingHelper.AddOrigins("/prefix", nodes.Get(nodes.GetN() - 1));
+    GlobalRoutingHelper::CalculateRoutes();
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(1000));
+    consumerHelper.Install(nodes.Get(0));
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(nodes.Get(nodes.GetN() - 1));
+
+    Simulator::Stop(Seconds(10));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    reportPackets(d);
+  }
+
+  /**
+   * \brief Simulate a dumbbell of \p nPairs consumer-producer pairs sharing a bottleneck
+   *
+   * Consumers request 1000 Data per second each from their producer, during 10 seconds of
+   * simulated time.  Their Interests reach the bottleneck routers at the same times, so
+   * \p isBatched receive forwards them together.
+   */
+  void
+  runDumbbell(size_t nPairs, bool isBatched)
+  {
+    NodeContainer consumers;
+    consumers.Create(nPairs);
+    NodeContainer routers;
+    routers.Create(2);
+    NodeContainer producers;
+    producers.Create(nPairs);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("10ms"));
+    for (size_t i = 0; i < nPairs; ++i) {
+      p2p.Install(consumers.Get(i), routers.Get(0));
+      p2p.Install(routers.Get(1), producers.Get(i));
+    }
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Gbps"));
+    p2p.Install(routers.Get(0), routers.Get(1));
+
+    StackHelper ndnHelper;
+    ndnHelper.SetStackAttributes("BatchedReceive", isBatched ? "true" : "false");
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+
+    for (size_t i = 0; i < nPairs; ++i) {
+      std::string prefix = "/prefix/" + std::to_string(i);
+
+      AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+      consumerHelper.SetPrefix(prefix);
+      consumerHelper.SetAttribute("Frequency", DoubleValue(1000));
+      consumerHelper.Install(consumers.Get(i));
+
+      AppHelper producerHelper("ns3::ndn::Producer");
+      producerHelper.SetPrefix(prefix);
+      producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+      producerHelper.Install(producers.Get(i));
+
+      routingHelper.AddOrigins(prefix, producers.Get(i));
+    }
+    GlobalRoutingHelper::CalculateRoutes();
+
+    Simulator::Stop(Seconds(10));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    reportPackets(d);
+  }
+
+  /**
+   * \brief Simulate a chain of \p nNodes nodes with the forwarders of mobility \p scheme
+   *
+   * The first node requests 1000 Data per second from the last one, during 10 seconds of
+   * simulated time.  No node moves, so the mobility schemes only add the cost of their
+   * forwarding pipelines to the one of the vanilla forwarder.
+   */
+  void
+  runChain(const std::string& scheme, size_t nNodes)
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::mobility_scheme", StringValue(scheme));
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("1ms"));
+    for (size_t i = 0; i + 1 < nNodes; ++i) {
+      p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+    }
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper routingHelper;
+    routingHelper.InstallAll();
+    routingHelper.AddOrigins("/prefix", nodes.Get(nNodes - 1));
+    GlobalRoutingHelper::CalculateRoutes();
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(1000));
+    consumerHelper.Install(nodes.Get(0));
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(nodes.Get(nNodes - 1));
+
+    Simulator::Stop(Seconds(10));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    reportPackets(d);
+  }
+
+  /**
+   * \brief Simulate \p nConsumers consumers connected to a single producer
+   *
+   * Consumers request 100 Data per second each, over links with the same delay, during 10
+   * seconds of simulated time.  Their Interests reach the producer application at the same
+   * times, so \p isBatched AppFace delivery passes them in one event.  The number of
+   * simulator events per packet is reported as the events metric.
+   */
+  void
+  runStar(size_t nConsumers, bool isBatched)
+  {
+    GlobalValue::Bind("NdnAppFaceBatchedDelivery", BooleanValue(isBatched));
+    useCountingScheduler();
+
+    Ptr<Node> producer = CreateObject<Node>();
+    NodeContainer consumers;
+    consumers.Create(nConsumers);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    for (size_t i = 0; i < nConsumers; ++i) {
+      p2p.Install(consumers.Get(i), producer);
+    }
+
+    StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    ndnHelper.InstallAll();
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", DoubleValue(100));
+    consumerHelper.Install(consumers);
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(producer);
+
+    Simulator::Stop(Seconds(10));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    // global values are not reset by Config::Reset
+    GlobalValue::Bind("NdnAppFaceBatchedDelivery", BooleanValue(false));
+
+    uint64_t nPackets = reportPackets(d);
+    reportMetric("EventsPerPacket", 1.0 * CountingScheduler::getNEvents() / nPackets);
+  }
+
+  /**
+   * \brief Simulate \p nConsumers video consumers sharing a 100Mbps bottleneck
+   *
+   * Consumers play a 1Mbps video during 60 seconds of simulated time, with \p isLazy
+   * playback.  The number of simulator events and the download failures (playback stalls)
+   * and successes are reported; failures and successes must not depend on \p isLazy.
+   */
+  void
+  runStreaming(size_t nConsumers, bool isLazy)
+  {
+    useCountingScheduler();
+
+    Ptr<Node> producer = CreateObject<Node>();
+    Ptr<Node> router = CreateObject<Node>();
+    NodeContainer consumers;
+    consumers.Create(nConsumers);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
+    for (size_t i = 0; i < nConsumers; ++i) {
+      p2p.Install(consumers.Get(i), router);
+    }
+    p2p.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    p2p.Install(router, producer);
+
+    StackHelper ndnHelper;
+    ndnHelper.SetDefaultRoutes(true);
+    ndnHelper.InstallAll();
+
+    StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/best-route");
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerStreaming");
+    consumerHelper.SetPrefix("/video");
+    consumerHelper.SetAttribute("PlayBitRate", UintegerValue(1000000));
+    consumerHelper.SetAttribute("LazyPlayback", BooleanValue(isLazy));
+    // successes are reported when applications stop
+    consumerHelper.Install(consumers).Stop(Seconds(60));
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/video");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1040"));
+    producerHelper.Install(producer);
+
+    nDownloadFailures = 0;
+    nDownloadSuccesses = 0;
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerStreaming/"
+                                  "DownloadFailure",
+                                  MakeCallback(&ScenarioBenchmarkFixture::onDownloadFailure, this));
+    Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerStreaming/"
+                                  "DownloadSuccess",
+                                  MakeCallback(&ScenarioBenchmarkFixture::onDownloadSuccess, this));
+
+    Simulator::Stop(Seconds(61));
+    time::nanoseconds d = timedRun([] { Simulator::Run(); });
+
+    reportPackets(d);
+    reportMetric("Events", CountingScheduler::getNEvents());
+    reportMetric("DownloadFailures", nDownloadFailures);
+    reportMetric("DownloadSuccesses", nDownloadSuccesses);
+  }
+
+private:
+  /**
+   * \brief Report the packets received by the forwarders as the operations
+   */
+  uint64_t
+  reportPackets(time::nanoseconds duration)
+  {
+    uint64_t nPackets = getNForwardedPackets();
+    BOOST_CHECK_GT(nPackets, 0);
+    report(nPackets, duration);
+    return nPackets;
+  }
+
+  void
+  onDownloadFailure(uint32_t appId, double bytes, double rate)
+  {
+    ++nDownloadFailures;
+  }
+
+  void
+  onDownloadSuccess(uint32_t appId, double bytes, double rate)
+  {
+    ++nDownloadSuccesses;
+  }
+
+private:
+  uint32_t nDownloadFailures;
+  uint32_t nDownloadSuccesses;
+};
+
+BOOST_FIXTURE_TEST_SUITE(Scenario, ScenarioBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Grid3x3)
+{
+  runTopology("topo-grid-3x3.txt");
+}
+
+BOOST_AUTO_TEST_CASE(Tree25Node)
+{
+  runTopology("topo-tree-25-node.txt");
+}
+
+BOOST_AUTO_TEST_CASE(TwoBottlenecks11Node)
+{
+  runTopology("topo-11-node-two-bottlenecks.txt");
+}
+
+BOOST_AUTO_TEST_CASE(Dumbbell)
+{
+  runDumbbell(20, false);
+}
+
+BOOST_AUTO_TEST_CASE(DumbbellBatched)
+{
+  runDumbbell(20, true);
+}
+
+BOOST_AUTO_TEST_CASE(ChainVanilla)
+{
+  runChain("vanilla", 10);
+}
+
+#ifdef MAPME
+BOOST_AUTO_TEST_CASE(ChainMapMe)
+{
+  runChain("mapme", 10);
+}
+#endif // MAPME
+
+#ifdef ANCHOR
+BOOST_AUTO_TEST_CASE(ChainAnchor)
+{
+  runChain("anchor", 10);
+}
+#endif // ANCHOR
+
+#ifdef KITE
+BOOST_AUTO_TEST_CASE(ChainKite)
+{
+  runChain("kite", 10);
+}
+#endif // KITE
+
+BOOST_AUTO_TEST_CASE(AppFaceStar)
+{
+  runStar(100, false);
+}
+
+BOOST_AUTO_TEST_CASE(AppFaceStarBatched)
+{
+  runStar(100, true);
+}
+
+BOOST_AUTO_TEST_CASE(StreamingEager)
+{
+  runStreaming(100, false);
+}
+
+BOOST_AUTO_TEST_CASE(StreamingLazy)
+{
+  runStreaming(100, true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
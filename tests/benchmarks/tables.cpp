@@ -0,0 +1,408 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark-common.hpp"
+
+#include "NFD/daemon/table/name-tree.hpp"
+#include "NFD/daemon/table/pit.hpp"
+#include "NFD/daemon/table/dead-nonce-list.hpp"
+#include "NFD/daemon/fw/forwarder.hpp"
+#include "NFD/daemon/face/null-face.hpp"
+
+#include "ns3/ndnSIM-module.h"
+#include "utils/mem-usage.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const size_t N_ENTRIES = 100000;
+
+BOOST_FIXTURE_TEST_SUITE(TableNameTree, BenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Insert)
+{
+  std::vector<Name> names;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    names.push_back(makeName(i));
+  }
+
+  nfd::NameTree nameTree;
+  time::nanoseconds d = timedRun([&] {
+    for (const Name& name : names) {
+      nameTree.lookup(name);
+    }
+  });
+  BOOST_CHECK_EQUAL(nameTree.size(), N_ENTRIES + 6);
+  report(N_ENTRIES, d);
+}
+
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  nfd::NameTree nameTree;
+  std::vector<Name> names;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    nameTree.lookup(makeName(i));
+    names.push_back(Name(makeName(i)).append("suffix"));
+  }
+
+  size_t nMatches = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (const Name& name : names) {
+      if (nameTree.findLongestPrefixMatch(name)->getPrefix().size() == 3) {
+        ++nMatches;
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nMatches, N_ENTRIES);
+  report(N_ENTRIES, d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(TablePit, BenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(InsertSatisfy)
+{
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> datas;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    interests.push_back(makeInterest(makeName(i)));
+    datas.push_back(makeData(makeName(i)));
+  }
+
+  nfd::NameTree nameTree;
+  nfd::Pit pit(nameTree);
+  size_t nSatisfied = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      pit.insert(*interests[i]);
+    }
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      nfd::pit::DataMatchResult matches = pit.findAllDataMatches(*datas[i]);
+      for (const shared_ptr<nfd::pit::Entry>& entry : matches) {
+        pit.erase(entry);
+        ++nSatisfied;
+      }
+    }
+  });
+  BOOST_CHECK_EQUAL(nSatisfied, N_ENTRIES);
+  BOOST_CHECK_EQUAL(pit.size(), 0);
+  report(N_ENTRIES, d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/**
+ * PIT entries with in-records and out-records, which are stored inline up to
+ * nfd::pit::N_INLINE_FACE_RECORDS records per entry.
+ */
+class PitRecordsBenchmarkFixture : public BenchmarkFixture
+{
+public:
+  PitRecordsBenchmarkFixture()
+    : pit(nameTree)
+  {
+    for (size_t i = 0; i < N_FACES; ++i) {
+      faces.push_back(make_shared<nfd::NullFace>());
+    }
+
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      interests.push_back(makeInterest(makeName(i)));
+      interests.back()->setNonce(static_cast<uint32_t>(i));
+      datas.push_back(makeData(makeName(i)));
+    }
+  }
+
+  /**
+   * \brief Insert a PIT entry with \p nInRecords downstreams and one upstream
+   */
+  shared_ptr<nfd::pit::Entry>
+  insertEntry(const Interest& interest, size_t nInRecords)
+  {
+    shared_ptr<nfd::pit::Entry> entry = pit.insert(interest).first;
+    for (size_t j = 0; j < nInRecords; ++j) {
+      entry->insertOrUpdateInRecord(faces[j + 1], interest);
+    }
+    entry->insertOrUpdateOutRecord(faces[0], interest);
+    return entry;
+  }
+
+  /**
+   * \brief Satisfy the PIT entries matching \p data, as the incoming Data pipeline does
+   */
+  void
+  satisfy(const Data& data)
+  {
+    nfd::pit::DataMatchResult matches = pit.findAllDataMatches(data);
+    for (const shared_ptr<nfd::pit::Entry>& entry : matches) {
+      entry->findNonce(0, *faces[0]);
+      entry->deleteInRecords();
+      entry->deleteOutRecord(*faces[0]);
+      pit.erase(entry);
+    }
+  }
+
+  void
+  runInsertSatisfy(size_t nInRecords)
+  {
+    time::nanoseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_ENTRIES; ++i) {
+        insertEntry(*interests[i], nInRecords);
+      }
+      for (size_t i = 0; i < N_ENTRIES; ++i) {
+        satisfy(*datas[i]);
+      }
+    });
+    BOOST_CHECK_EQUAL(pit.size(), 0);
+    report(N_ENTRIES, d);
+  }
+
+public:
+  static const size_t N_FACES = 8;
+
+  nfd::NameTree nameTree;
+  nfd::Pit pit;
+  std::vector<shared_ptr<nfd::Face>> faces;
+  std::vector<shared_ptr<Interest>> interests;
+  std::vector<shared_ptr<Data>> datas;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TablePitRecords, PitRecordsBenchmarkFixture)
+
+// memory footprint of a PIT entry, excluding its Name and NameTree entry
+BOOST_AUTO_TEST_CASE(EntrySize)
+{
+  reportMetric("EntryBytes", sizeof(nfd::pit::Entry));
+  reportMetric("InRecordBytes", sizeof(nfd::pit::InRecord));
+  reportMetric("OutRecordBytes", sizeof(nfd::pit::OutRecord));
+  reportMetric("InlineRecords", nfd::pit::N_INLINE_FACE_RECORDS);
+
+  // in-records beyond the inline capacity are allocated on the heap
+  for (size_t nInRecords = 1; nInRecords <= 4; ++nInRecords) {
+    size_t nHeapRecords = nInRecords > nfd::pit::N_INLINE_FACE_RECORDS ?
+                          nInRecords - nfd::pit::N_INLINE_FACE_RECORDS : 0;
+    reportMetric("BytesPerEntryWith" + std::to_string(nInRecords) + "InRecords",
+                 sizeof(nfd::pit::Entry) + nHeapRecords * sizeof(nfd::pit::InRecord));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(InsertSatisfy1)
+{
+  runInsertSatisfy(1);
+}
+
+BOOST_AUTO_TEST_CASE(InsertSatisfy2)
+{
+  runInsertSatisfy(2);
+}
+
+BOOST_AUTO_TEST_CASE(InsertSatisfy4)
+{
+  runInsertSatisfy(4);
+}
+
+// aggregation of retransmitted Interests into existing PIT entries
+BOOST_AUTO_TEST_CASE(InsertOrUpdateRecords)
+{
+  std::vector<shared_ptr<nfd::pit::Entry>> entries;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    entries.push_back(insertEntry(*interests[i], 2));
+  }
+
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      const nfd::Face& inFace = *faces[1 + i % 2];
+      entries[i]->findNonce(interests[i]->getNonce(), inFace);
+      entries[i]->getInRecord(inFace);
+      entries[i]->insertOrUpdateOutRecord(faces[0], *interests[i]);
+    }
+  });
+  report(N_ENTRIES, d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_FIXTURE_TEST_SUITE(TableDeadNonceList, BenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(AddFind)
+{
+  std::vector<Name> names;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    names.push_back(makeName(i));
+  }
+
+  nfd::DeadNonceList dnl;
+  size_t nFound = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      dnl.add(names[i], i);
+    }
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      if (dnl.has(names[i], i)) {
+        ++nFound;
+      }
+    }
+  });
+  BOOST_CHECK_GT(nFound, 0);
+  report(N_ENTRIES * 2, d);
+}
+
+BOOST_AUTO_TEST_CASE(AddFindNameHash)
+{
+  // the forwarding pipelines pass the hash cached in the PIT entry instead of the Name
+  std::vector<size_t> nameHashes;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    nameHashes.push_back(nfd::name_tree::computeHash(makeName(i)));
+  }
+
+  nfd::DeadNonceList dnl;
+  size_t nFound = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      dnl.add(nameHashes[i], i);
+    }
+    for (size_t i = 0; i < N_ENTRIES; ++i) {
+      if (dnl.has(nameHashes[i], i)) {
+        ++nFound;
+      }
+    }
+  });
+  BOOST_CHECK_GT(nFound, 0);
+  report(N_ENTRIES * 2, d);
+}
+
+static void
+addDeadNonces(nfd::DeadNonceList* dnl, const std::vector<size_t>* nameHashes, size_t first,
+              size_t nNonces)
+{
+  for (size_t i = first; i < first + nNonces; ++i) {
+    dnl->add((*nameHashes)[i % nameHashes->size()], i);
+  }
+}
+
+/**
+ * Each Interest is checked against the list, then its Nonce is added, evicting the oldest one.
+ * The list has first adapted its capacity to N_ENTRIES Interests per lifetime, during a
+ * simulation with a lifetime of 100ms.  BytesPerEntry is the memory of the ring buffer and of
+ * the hash table per stored Nonce.
+ */
+BOOST_AUTO_TEST_CASE(SteadyState)
+{
+  const int64_t LIFETIME_MS = 100;
+  const size_t N_BURSTS = 100; // per lifetime, one per millisecond
+  const size_t N_LIFETIMES = 50;
+
+  std::vector<size_t> nameHashes;
+  for (size_t i = 0; i < N_ENTRIES; ++i) {
+    nameHashes.push_back(nfd::name_tree::computeHash(makeName(i)));
+  }
+
+  nfd::DeadNonceList dnl(time::milliseconds(LIFETIME_MS));
+  const size_t burstSize = N_ENTRIES / N_BURSTS;
+  for (size_t i = 0; i < N_BURSTS * N_LIFETIMES; ++i) {
+    Simulator::Schedule(MicroSeconds(LIFETIME_MS * 1000 / N_BURSTS * i), &addDeadNonces, &dnl,
+                        &nameHashes, i * burstSize, burstSize);
+  }
+  Simulator::Stop(MilliSeconds(LIFETIME_MS * N_LIFETIMES));
+  Simulator::Run();
+
+  size_t nFound = 0;
+  const size_t first = N_BURSTS * N_LIFETIMES * burstSize;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = first; i < first + N_ENTRIES; ++i) {
+      if (dnl.has(nameHashes[i % N_ENTRIES], i)) {
+        ++nFound;
+      }
+      dnl.add(nameHashes[i % N_ENTRIES], i);
+    }
+  });
+  BOOST_CHECK_EQUAL(nFound, 0);
+  report(N_ENTRIES * 2, d);
+
+  nfd::TableMemoryUsage usage = dnl.getMemoryUsage();
+  reportMetric("Entries", usage.nEntries);
+  reportMetric("BytesPerEntry", 1.0 * usage.overheadBytes / usage.nEntries);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/**
+ * Memory used by the FIBs of a Rocketfuel topology, to be compared between builds configured
+ * with and without --with-name-interning.
+ *
+ * Every customer router announces 10 prefixes, and global routing installs a route to each of
+ * them on every node, so that the same names are stored by all the FIBs and name trees.  The
+ * operations are the FIB entries installed.  NameTreePayloadBytes is the bytes of names held
+ * by the name trees, with interned buffers split between their holders; MemoryBytes is the
+ * growth of the process memory while the routes are installed.
+ */
+BOOST_FIXTURE_TEST_SUITE(TableNameInterning, BenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(RocketfuelFib)
+{
+  std::string map = getRocketfuelMap();
+  if (map.empty()) {
+    return;
+  }
+
+  RocketfuelMapReader reader;
+  reader.SetFileName(map);
+  reader.Read(getRocketfuelParams());
+
+  StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll();
+
+  const NodeContainer& producers = reader.GetCustomerRouters();
+  for (NodeContainer::Iterator node = producers.Begin(); node != producers.End(); ++node) {
+    for (uint32_t i = 0; i < 10; ++i) {
+      std::string prefix = "/rocketfuel/customer/" + std::to_string((*node)->GetId())
+                           + "/prefix/" + std::to_string(i);
+      routingHelper.AddOrigin(prefix, *node);
+    }
+  }
+
+  int64_t beginMemory = MemUsage::Get();
+  time::nanoseconds d = timedRun([] { GlobalRoutingHelper::CalculateRoutes(); });
+  int64_t memory = MemUsage::Get() - beginMemory;
+
+  size_t nFibEntries = 0;
+  size_t nNameTreeEntries = 0;
+  size_t payloadBytes = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); ++node) {
+    shared_ptr<nfd::Forwarder> forwarder = (*node)->GetObject<L3Protocol>()->getForwarder();
+    nfd::TableMemoryUsage usage = forwarder->getNameTree().getMemoryUsage();
+    nFibEntries += forwarder->getFib().size();
+    nNameTreeEntries += usage.nEntries;
+    payloadBytes += usage.payloadBytes;
+  }
+
+  BOOST_CHECK_GT(nFibEntries, 0);
+  report(nFibEntries, d);
+  reportMetric("NameTreeEntries", nNameTreeEntries);
+  reportMetric("NameTreePayloadBytes", payloadBytes);
+  reportMetric("MemoryBytes", memory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "benchmark-common.hpp"
+
+#include "helper/ndn-stack-helper.hpp"
+
+#include <ndn-cxx/util/random.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(EncodingTlv, BenchmarkFixture)
+
+const size_t N_PACKETS = 200000;
+
+BOOST_AUTO_TEST_CASE(InterestEncode)
+{
+  size_t size = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Interest interest(makeName(i));
+      interest.setNonce(i);
+      size += interest.wireEncode().size();
+    }
+  });
+  BOOST_CHECK_GT(size, 0);
+  report(N_PACKETS, d);
+}
+
+BOOST_AUTO_TEST_CASE(InterestDecode)
+{
+  Block wire = makeInterest(makeName(0))->wireEncode();
+
+  size_t nComponents = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Interest interest(wire);
+      nComponents += interest.getName().size();
+    }
+  });
+  BOOST_CHECK_EQUAL(nComponents, N_PACKETS * 3);
+  report(N_PACKETS, d);
+}
+
+BOOST_AUTO_TEST_CASE(DataEncode)
+{
+  shared_ptr<Data> prototype = makeData(makeName(0));
+
+  size_t size = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Data data(makeName(i));
+      data.setFreshnessPeriod(prototype->getFreshnessPeriod());
+      data.setContent(prototype->getContent());
+      data.setSignature(prototype->getSignature());
+      size += data.wireEncode().size();
+    }
+  });
+  BOOST_CHECK_GT(size, 0);
+  report(N_PACKETS, d);
+}
+
+BOOST_AUTO_TEST_CASE(DataDecode)
+{
+  Block wire = makeData(makeName(0))->wireEncode();
+
+  size_t nComponents = 0;
+  time::nanoseconds d = timedRun([&] {
+    for (size_t i = 0; i < N_PACKETS; ++i) {
+      Data data(wire);
+      nComponents += data.getName().size();
+    }
+  });
+  BOOST_CHECK_EQUAL(nComponents, N_PACKETS * 3);
+  report(N_PACKETS, d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/**
+ * \brief Creation and encoding of Interests that get their nonce from ndn-cxx
+ */
+class NonceBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  void
+  createInterests()
+  {
+    Name prefix("/prefix");
+
+    time::nanoseconds d = timedRun([&] {
+      for (size_t i = 0; i < N_PACKETS; ++i) {
+        Interest interest(Name(prefix).appendSequenceNumber(i));
+        interest.wireEncode();
+      }
+    });
+    report(N_PACKETS, d);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(EncodingNonce, NonceBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(NdnCxx)
+{
+  ::ndn::random::setCustomNonceGenerator(nullptr);
+  createInterests();
+
+  // restore the nonce source of ndnSIM for the following benchmarks
+  StackHelper ndnHelper;
+}
+
+BOOST_AUTO_TEST_CASE(NdnSim)
+{
+  // reproducible per-node nonce source, installed by StackHelper
+  StackHelper ndnHelper;
+  createInterests();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
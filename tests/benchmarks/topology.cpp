@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "benchmark-common.hpp"
+
+#include "ns3/names.h"
+#include "utils/topology/rocketfuel-map-reader.hpp"
+
+#include <cstdio>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Loading of a Rocketfuel map, from the .cch file with RocketfuelMapReader::Read, and
+ *        from the same processed topology saved in the binary format
+ *
+ * Both loads create the same nodes and point-to-point links.  The map is named by the
+ * NDNSIM_BENCHMARK_ROCKETFUEL_MAP environment variable, the cases are skipped without it.
+ */
+class TopologyLoadBenchmarkFixture : public BenchmarkFixture
+{
+protected:
+  TopologyLoadBenchmarkFixture()
+    : binaryFile("benchmark-topology.bin")
+  {
+  }
+
+  ~TopologyLoadBenchmarkFixture()
+  {
+    std::remove(binaryFile.c_str());
+  }
+
+  /**
+   * \brief Read the map with \p textReader, and save it in binaryFile
+   * \return duration of the read
+   */
+  time::nanoseconds
+  readText(RocketfuelMapReader& textReader, const std::string& map)
+  {
+    textReader.SetFileName(map);
+    time::nanoseconds d = timedRun([&] { textReader.Read(getRocketfuelParams()); });
+    textReader.SaveBinaryTopology(binaryFile);
+
+    // the same node names are registered again by the next reader
+    Names::Clear();
+    return d;
+  }
+
+protected:
+  const std::string binaryFile;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TopologyLoad, TopologyLoadBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Text)
+{
+  std::string map = getRocketfuelMap();
+  if (map.empty()) {
+    return;
+  }
+
+  RocketfuelMapReader textReader;
+  time::nanoseconds d = readText(textReader, map);
+  report(textReader.GetNodes().GetN(), d);
+}
+
+BOOST_AUTO_TEST_CASE(Binary)
+{
+  std::string map = getRocketfuelMap();
+  if (map.empty()) {
+    return;
+  }
+
+  RocketfuelMapReader textReader;
+  readText(textReader, map);
+
+  RocketfuelMapReader binaryReader;
+  binaryReader.SetFileName(binaryFile);
+  time::nanoseconds d = timedRun([&] { binaryReader.ReadBinary(); });
+
+  BOOST_CHECK_EQUAL(binaryReader.GetNodes().GetN(), textReader.GetNodes().GetN());
+  BOOST_CHECK_EQUAL(binaryReader.GetLinks().size(), textReader.GetLinks().size());
+  BOOST_CHECK_EQUAL(binaryReader.GetBackboneRouters().GetN(),
+                    textReader.GetBackboneRouters().GetN());
+  BOOST_CHECK_EQUAL(binaryReader.GetCustomerRouters().GetN(),
+                    textReader.GetCustomerRouters().GetN());
+  report(binaryReader.GetNodes().GetN(), d);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
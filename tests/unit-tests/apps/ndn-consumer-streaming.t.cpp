@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "apps/ndn-consumer-streaming.hpp"
+#include "model/ndn-net-device-face.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class ConsumerStreamingFixture : public CleanupFixture
+{
+protected:
+  struct Traces
+  {
+    std::vector<std::string> failures;
+    std::vector<std::string> successes;
+  };
+
+  /**
+   * \brief Simulate two video consumers for 30 seconds, and record their download traces
+   *
+   * Consumer 1 plays a 1Mbps video through a 500Kbps bottleneck and stalls repeatedly, waiting
+   * 2 seconds before each restart.  Consumer 4 plays a 500Kbps video over a 10Mbps link and
+   * does not stall.
+   */
+  Traces
+  run(bool isLazy)
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    ScenarioHelper helper;
+    helper.createTopology({
+        {"1", "2"},
+        {"2", "3"},
+        {"4", "5"},
+      });
+
+    auto bottleneck = std::dynamic_pointer_cast<NetDeviceFace>(helper.getFace("3", "2"));
+    BOOST_REQUIRE(bottleneck != nullptr);
+    bottleneck->GetNetDevice()->SetAttribute("DataRate", StringValue("500Kbps"));
+
+    helper.addRoutes({
+        {"1", "2", "/video", 1},
+        {"2", "3", "/video", 1},
+        {"4", "5", "/video", 1},
+      });
+
+    std::string lazyPlayback = isLazy ? "true" : "false";
+    helper.addApps({
+        {"1", "ns3::ndn::ConsumerStreaming",
+            {{"Prefix", "/video"}, {"PlayBitRate", "1000000"}, {"LazyPlayback", lazyPlayback},
+             {"RestartDelay", "ns3::ConstantRandomVariable[Constant=2.0]"}},
+            "0s", "29.99s"},
+        {"4", "ns3::ndn::ConsumerStreaming",
+            {{"Prefix", "/video"}, {"PlayBitRate", "500000"}, {"LazyPlayback", lazyPlayback}},
+            "0s", "29.99s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/video"}, {"PayloadSize", "1040"}},
+            "0s", "100s"},
+        {"5", "ns3::ndn::Producer",
+            {{"Prefix", "/video"}, {"PayloadSize", "1040"}},
+            "0s", "100s"},
+      });
+
+    Traces traces;
+    m_traces = &traces;
+    Config::Connect("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerStreaming/DownloadFailure",
+                    MakeCallback(&ConsumerStreamingFixture::onFailure, this));
+    Config::Connect("/NodeList/*/ApplicationList/*/$ns3::ndn::ConsumerStreaming/DownloadSuccess",
+                    MakeCallback(&ConsumerStreamingFixture::onSuccess, this));
+
+    Simulator::Stop(Seconds(31));
+    Simulator::Run();
+
+    Simulator::Destroy();
+    Names::Clear();
+    GlobalRouter::clear();
+    m_traces = nullptr;
+    return traces;
+  }
+
+private:
+  static std::string
+  formatTrace(const std::string& context, double bytes, double rate)
+  {
+    std::ostringstream os;
+    os << context << " " << Simulator::Now().GetTimeStep() << " " << bytes << " " << rate;
+    return os.str();
+  }
+
+  void
+  onFailure(std::string context, uint32_t appId, double bytes, double rate)
+  {
+    m_traces->failures.push_back(formatTrace(context, bytes, rate));
+  }
+
+  void
+  onSuccess(std::string context, uint32_t appId, double bytes, double rate)
+  {
+    m_traces->successes.push_back(formatTrace(context, bytes, rate));
+  }
+
+private:
+  Traces* m_traces;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerStreaming, ConsumerStreamingFixture)
+
+BOOST_AUTO_TEST_CASE(LazyPlayback)
+{
+  Traces eager = run(false);
+  Traces lazy = run(true);
+
+  // stalls are reported at the same times, with the same amounts of downloaded data
+  BOOST_CHECK_GT(eager.failures.size(), 0);
+  BOOST_CHECK_EQUAL_COLLECTIONS(lazy.failures.begin(), lazy.failures.end(),
+                                eager.failures.begin(), eager.failures.end());
+
+  BOOST_CHECK_EQUAL(eager.successes.size(), 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(lazy.successes.begin(), lazy.successes.end(),
+                                eager.successes.begin(), eager.successes.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
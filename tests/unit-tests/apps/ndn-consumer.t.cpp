@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+#include "apps/ndn-consumer.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Consumer requesting 5 sequence numbers, 30ms apart, and recording their timeouts
+ */
+class RetxTestConsumer : public Consumer
+{
+public:
+  using Consumer::SeqStatesContainer;
+
+  struct Timeout
+  {
+    uint32_t seq;
+    Time pendingSince;
+    Time time;
+  };
+
+  RetxTestConsumer()
+  {
+    m_seqMax = 5;
+  }
+
+  Time
+  getRetxTimerOrigin() const
+  {
+    return m_retxTimerOrigin;
+  }
+
+  /**
+   * \brief Returns the RTO used by a retransmission check at \p time
+   *
+   * The RTO only changes on timeouts, as no Data is received.  A check sees the changes made
+   * strictly before it.
+   */
+  Time
+  getRtoAt(Time time) const
+  {
+    Time rto = initialRto;
+    for (const auto& change : rtoChanges) {
+      if (change.first >= time) {
+        break;
+      }
+      rto = change.second;
+    }
+    return rto;
+  }
+
+protected:
+  virtual void
+  StartApplication()
+  {
+    initialRto = m_rtt->RetransmitTimeout();
+    Consumer::StartApplication();
+  }
+
+  virtual void
+  ScheduleNextPacket()
+  {
+    if (!m_retxSeqs.empty()) {
+      Simulator::Cancel(m_sendEvent);
+      m_sendEvent = Simulator::ScheduleNow(&Consumer::SendPacket, this);
+    }
+    else if (!m_sendEvent.IsRunning() && m_seq < m_seqMax) {
+      m_sendEvent = Simulator::Schedule(m_seq == 0 ? Seconds(0) : MilliSeconds(30),
+                                        &Consumer::SendPacket, this);
+    }
+  }
+
+  virtual void
+  WillSendOutInterest(uint32_t sequenceNumber)
+  {
+    pendingSince[sequenceNumber] = Simulator::Now();
+    Consumer::WillSendOutInterest(sequenceNumber);
+  }
+
+  virtual void
+  OnTimeout(uint32_t sequenceNumber)
+  {
+    timeouts.push_back({sequenceNumber, pendingSince[sequenceNumber], Simulator::Now()});
+    Consumer::OnTimeout(sequenceNumber);
+    rtoChanges.push_back(std::make_pair(Simulator::Now(), m_rtt->RetransmitTimeout()));
+  }
+
+public:
+  std::vector<Timeout> timeouts;
+
+private:
+  std::map<uint32_t, Time> pendingSince;
+  Time initialRto;
+  std::vector<std::pair<Time, Time>> rtoChanges;
+};
+
+BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumer, ScenarioHelperWithCleanupFixture)
+
+BOOST_AUTO_TEST_CASE(RetxTimeout)
+{
+  createTopology({
+      {"1", "2"},
+    });
+
+  // no route, Interests are never satisfied
+  Ptr<RetxTestConsumer> consumer = CreateObject<RetxTestConsumer>();
+  consumer->SetAttribute("Prefix", StringValue("/prefix"));
+  consumer->SetAttribute("RetxTimer", StringValue("50ms"));
+  getNode("1")->AddApplication(consumer);
+  consumer->SetStartTime(Seconds(0));
+  consumer->SetStopTime(Seconds(20));
+
+  Simulator::Stop(Seconds(20));
+  Simulator::Run();
+
+  BOOST_REQUIRE_GE(consumer->timeouts.size(), 10);
+
+  // each timeout fires at the first multiple of RetxTimer at which the Interest is found
+  // expired, as when the retransmission timeouts were checked periodically
+  const int64_t period = MilliSeconds(50).GetTimeStep();
+  const Time origin = consumer->getRetxTimerOrigin();
+  for (const auto& timeout : consumer->timeouts) {
+    BOOST_CHECK_EQUAL((timeout.time - origin).GetTimeStep() % period, 0);
+    BOOST_CHECK_LE(timeout.pendingSince + consumer->getRtoAt(timeout.time), timeout.time);
+
+    int64_t firstTick = ((timeout.pendingSince - origin).GetTimeStep() + period - 1) / period;
+    for (Time tick = origin + TimeStep(firstTick * period); tick < timeout.time;
+         tick += TimeStep(period)) {
+      BOOST_CHECK_GT(timeout.pendingSince + consumer->getRtoAt(tick), tick);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SeqStatesResize)
+{
+  typedef RetxTestConsumer::SeqStatesContainer SeqStates;
+  SeqStates states;
+  BOOST_CHECK_EQUAL(states.capacity(), SeqStates::INITIAL_CAPACITY);
+
+  for (uint32_t seq = 0; seq < SeqStates::INITIAL_CAPACITY; ++seq) {
+    states.insert(seq).retxCount = seq;
+  }
+  BOOST_CHECK_EQUAL(states.capacity(), SeqStates::INITIAL_CAPACITY);
+
+  // collides with 0, the capacity is doubled and all states are kept
+  states.insert(SeqStates::INITIAL_CAPACITY).retxCount = SeqStates::INITIAL_CAPACITY;
+  BOOST_CHECK_EQUAL(states.capacity(), 2 * SeqStates::INITIAL_CAPACITY);
+  BOOST_CHECK_EQUAL(states.size(), SeqStates::INITIAL_CAPACITY + 1);
+  for (uint32_t seq = 0; seq <= SeqStates::INITIAL_CAPACITY; ++seq) {
+    BOOST_REQUIRE(states.find(seq) != nullptr);
+    BOOST_CHECK_EQUAL(states.find(seq)->seq, seq);
+    BOOST_CHECK_EQUAL(states.find(seq)->retxCount, seq);
+  }
+
+  // the slot of an erased state is reused without resizing
+  states.erase(0);
+  BOOST_CHECK(states.find(0) == nullptr);
+  states.insert(2 * SeqStates::INITIAL_CAPACITY);
+  BOOST_CHECK_EQUAL(states.capacity(), 2 * SeqStates::INITIAL_CAPACITY);
+  BOOST_CHECK_EQUAL(states.size(), SeqStates::INITIAL_CAPACITY + 1);
+
+  // inserting an existing state does not reset it
+  BOOST_CHECK_EQUAL(states.insert(1).retxCount, 1);
+  BOOST_CHECK_EQUAL(states.size(), SeqStates::INITIAL_CAPACITY + 1);
+}
+
+BOOST_AUTO_TEST_CASE(SeqStatesMaxCapacity)
+{
+  typedef RetxTestConsumer::SeqStatesContainer SeqStates;
+  SeqStates states;
+
+  // a state never erased, while much later sequence numbers are requested
+  states.insert(0);
+  states.insert(SeqStates::MAX_CAPACITY).retxCount = 1;
+  states.insert(2 * SeqStates::MAX_CAPACITY).retxCount = 2;
+  BOOST_CHECK_EQUAL(states.capacity(), SeqStates::MAX_CAPACITY);
+  BOOST_CHECK_EQUAL(states.size(), 3);
+
+  BOOST_REQUIRE(states.find(SeqStates::MAX_CAPACITY) != nullptr);
+  BOOST_CHECK_EQUAL(states.find(SeqStates::MAX_CAPACITY)->retxCount, 1);
+  BOOST_REQUIRE(states.find(2 * SeqStates::MAX_CAPACITY) != nullptr);
+  BOOST_CHECK_EQUAL(states.find(2 * SeqStates::MAX_CAPACITY)->retxCount, 2);
+  BOOST_CHECK(states.find(3 * SeqStates::MAX_CAPACITY) == nullptr);
+
+  states.erase(SeqStates::MAX_CAPACITY);
+  BOOST_CHECK(states.find(SeqStates::MAX_CAPACITY) == nullptr);
+  BOOST_CHECK(states.find(0) != nullptr);
+  BOOST_CHECK_EQUAL(states.size(), 2);
+
+  states.clear();
+  BOOST_CHECK_EQUAL(states.size(), 0);
+  BOOST_CHECK(states.find(2 * SeqStates::MAX_CAPACITY) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-replication-helper.hpp"
+
+#include "ns3/rng-seed-manager.h"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_REPLICATIONS =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "replications";
+
+class ReplicationHelperFixture : public CleanupFixture
+{
+public:
+  ReplicationHelperFixture()
+    : prefix((TEST_REPLICATIONS / "scenario-").string())
+  {
+    boost::filesystem::remove_all(TEST_REPLICATIONS);
+    boost::filesystem::create_directories(TEST_REPLICATIONS);
+
+    replications.SetOutputPrefix(prefix);
+    replications.SetRuns(3);
+    replications.SetFirstRun(5);
+    replications.SetJobs(2);
+  }
+
+  ~ReplicationHelperFixture()
+  {
+    boost::filesystem::remove_all(TEST_REPLICATIONS);
+  }
+
+  static std::string
+  readFile(const std::string& file)
+  {
+    std::ifstream is(file.c_str());
+    std::string line;
+    std::getline(is, line);
+    return line;
+  }
+
+  /** \brief rows of the merged summary, by metric
+   */
+  std::map<std::string, std::vector<std::string>>
+  readSummary() const
+  {
+    std::map<std::string, std::vector<std::string>> rows;
+    std::ifstream is((prefix + "summary.txt").c_str());
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      std::istringstream ls(line);
+      std::string field;
+      while (std::getline(ls, field, '\t')) {
+        fields.push_back(field);
+      }
+      rows[fields.front()] = fields;
+    }
+    return rows;
+  }
+
+public:
+  std::string prefix;
+  ReplicationHelper replications;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnReplicationHelper, ReplicationHelperFixture)
+
+BOOST_AUTO_TEST_CASE(Placement)
+{
+  int status = replications.Run([] (uint32_t run, const std::string& runPrefix) {
+      std::ofstream os((runPrefix + "output.txt").c_str());
+      os << run << " " << RngSeedManager::GetRun() << std::endl;
+      std::cout << "replication " << run << std::endl;
+
+      ReplicationHelper::Report("Run", run);
+      ReplicationHelper::Report("Sample", 1);
+      ReplicationHelper::Report("Sample", 3);
+      return 0;
+    });
+  BOOST_CHECK_EQUAL(status, 0);
+
+  // each replication writes its outputs under its own prefix, with its own random stream
+  for (uint32_t run = 5; run <= 7; ++run) {
+    std::string runPrefix = prefix + "run" + std::to_string(run);
+    BOOST_CHECK_EQUAL(readFile(runPrefix + "-output.txt"),
+                      std::to_string(run) + " " + std::to_string(run));
+    BOOST_CHECK_EQUAL(readFile(runPrefix + ".log"), "replication " + std::to_string(run));
+    BOOST_CHECK(boost::filesystem::exists(runPrefix + "-summary.txt"));
+  }
+  BOOST_CHECK(!boost::filesystem::exists(prefix + "run4-output.txt"));
+  BOOST_CHECK(!boost::filesystem::exists(prefix + "run8-output.txt"));
+
+  std::map<std::string, std::vector<std::string>> summary = readSummary();
+  BOOST_REQUIRE_EQUAL(summary.size(), 3);
+  BOOST_CHECK_EQUAL(summary["Metric"].size(), 7);
+
+  const std::vector<std::string>& runs = summary["Run"];
+  BOOST_REQUIRE_EQUAL(runs.size(), 7);
+  BOOST_CHECK_EQUAL(runs[1], "3"); // Runs
+  BOOST_CHECK_EQUAL(runs[2], "3"); // Samples
+  BOOST_CHECK_EQUAL(runs[3], "6"); // Mean
+  BOOST_CHECK_EQUAL(runs[4], "1"); // StdDev
+  BOOST_CHECK_EQUAL(runs[5], "5"); // Min
+  BOOST_CHECK_EQUAL(runs[6], "7"); // Max
+
+  // values reported twice by each replication are separate samples
+  const std::vector<std::string>& samples = summary["Sample"];
+  BOOST_REQUIRE_EQUAL(samples.size(), 7);
+  BOOST_CHECK_EQUAL(samples[1], "3");
+  BOOST_CHECK_EQUAL(samples[2], "6");
+  BOOST_CHECK_EQUAL(samples[3], "2");
+}
+
+BOOST_AUTO_TEST_CASE(FailedReplication)
+{
+  int status = replications.Run([] (uint32_t run, const std::string&) {
+      ReplicationHelper::Report("Run", run);
+      return run == 6 ? 1 : 0;
+    });
+  BOOST_CHECK_EQUAL(status, 1);
+
+  // the failed replication is left out of the summary
+  std::map<std::string, std::vector<std::string>> summary = readSummary();
+  const std::vector<std::string>& runs = summary["Run"];
+  BOOST_REQUIRE_EQUAL(runs.size(), 7);
+  BOOST_CHECK_EQUAL(runs[1], "2");
+  BOOST_CHECK_EQUAL(runs[5], "5");
+  BOOST_CHECK_EQUAL(runs[6], "7");
+}
+
+BOOST_AUTO_TEST_CASE(ThrowingReplication)
+{
+  int status = replications.Run([] (uint32_t run, const std::string&) -> int {
+      ReplicationHelper::Report("Run", run);
+      if (run == 6) {
+        throw std::runtime_error("scenario error");
+      }
+      return 0;
+    });
+  BOOST_CHECK_EQUAL(status, 1);
+
+  // the exception is logged by the replication, which does not start replications itself
+  BOOST_CHECK_EQUAL(readFile(prefix + "run6.log"), "Replication 6 failed: scenario error");
+
+  std::map<std::string, std::vector<std::string>> summary = readSummary();
+  const std::vector<std::string>& runs = summary["Run"];
+  BOOST_REQUIRE_EQUAL(runs.size(), 7);
+  BOOST_CHECK_EQUAL(runs[1], "2");
+  BOOST_CHECK_EQUAL(runs[2], "2");
+}
+
+BOOST_AUTO_TEST_CASE(ReportOutsideReplication)
+{
+  // ignored, and does not create a summary
+  ReplicationHelper::Report("Run", 1);
+  BOOST_CHECK(!boost::filesystem::exists(prefix + "summary.txt"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-app-face.hpp"
+#include "apps/ndn-app.hpp"
+
+#include "ns3/boolean.h"
+#include "ns3/global-value.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <functional>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Delivery of a packet to an application, as seen by the application
+ */
+struct Delivery
+{
+  std::string app;
+  std::string name;
+  bool isNodeContext; ///< delivered in the context of the node of the application
+  Time time;
+};
+
+bool
+operator==(const Delivery& a, const Delivery& b)
+{
+  return a.app == b.app && a.name == b.name && a.isNodeContext == b.isNodeContext
+         && a.time == b.time;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const Delivery& delivery)
+{
+  return os << delivery.app << " " << delivery.name << " isNodeContext="
+            << delivery.isNodeContext << " time=" << delivery.time.GetSeconds();
+}
+
+/**
+ * \brief Application recording the packets delivered by its AppFace
+ *
+ * An Interest whose name ends with "echo" is answered by the application itself, from the
+ * callback, with a Data named after the Interest.
+ */
+class RecordingApp : public App
+{
+public:
+  RecordingApp(const std::string& name, std::vector<Delivery>& deliveries)
+    : m_name(name)
+    , m_deliveries(deliveries)
+  {
+  }
+
+  shared_ptr<AppFace>
+  getFace() const
+  {
+    return m_face;
+  }
+
+  virtual void
+  OnInterest(shared_ptr<const Interest> interest)
+  {
+    App::OnInterest(interest);
+    record(interest->getName());
+
+    if (interest->getName().get(-1).toUri() == "echo") {
+      auto data = make_shared<Data>(Name(interest->getName()).append("reply"));
+      m_face->sendData(*data);
+    }
+  }
+
+  virtual void
+  OnData(shared_ptr<const Data> data)
+  {
+    App::OnData(data);
+    record(data->getName());
+  }
+
+private:
+  void
+  record(const Name& name)
+  {
+    m_deliveries.push_back({m_name, name.toUri(), Simulator::GetContext() == GetNode()->GetId(),
+                            Simulator::Now()});
+  }
+
+private:
+  std::string m_name;
+  std::vector<Delivery>& m_deliveries;
+};
+
+class AppFaceFixture : public CleanupFixture
+{
+public:
+  ~AppFaceFixture()
+  {
+    // global values are not reset by Config::Reset
+    GlobalValue::Bind("NdnAppFaceBatchedDelivery", BooleanValue(false));
+  }
+
+  /**
+   * \brief Send packets to two applications on node 0 and one on node 1 at the same time,
+   *        and return the packets delivered to the applications of each node
+   */
+  std::vector<std::vector<Delivery>>
+  run(bool isBatched)
+  {
+    GlobalValue::Bind("NdnAppFaceBatchedDelivery", BooleanValue(isBatched));
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    PointToPointHelper p2p;
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    std::vector<std::vector<Delivery>> deliveries(nodes.GetN());
+    Ptr<RecordingApp> a = CreateObject<RecordingApp>("a", std::ref(deliveries[0]));
+    Ptr<RecordingApp> b = CreateObject<RecordingApp>("b", std::ref(deliveries[0]));
+    Ptr<RecordingApp> c = CreateObject<RecordingApp>("c", std::ref(deliveries[1]));
+    nodes.Get(0)->AddApplication(a);
+    nodes.Get(0)->AddApplication(b);
+    nodes.Get(1)->AddApplication(c);
+
+    // packets are sent from the context of each node, as the forwarder does
+    Simulator::ScheduleWithContext(nodes.Get(0)->GetId(), Seconds(1),
+                                   &AppFaceFixture::sendToNode0, a, b);
+    Simulator::ScheduleWithContext(nodes.Get(1)->GetId(), Seconds(1),
+                                   &AppFaceFixture::sendToNode1, c);
+
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    return deliveries;
+  }
+
+private:
+  static void
+  sendToNode0(Ptr<RecordingApp> a, Ptr<RecordingApp> b)
+  {
+    sendData(a, "/a/1");
+    sendInterest(b, "/b/2");
+    sendInterest(a, "/a/3/echo");
+    sendData(b, "/b/4");
+    sendData(a, "/a/5");
+  }
+
+  static void
+  sendToNode1(Ptr<RecordingApp> c)
+  {
+    sendInterest(c, "/c/1/echo");
+    sendData(c, "/c/2");
+  }
+
+  static void
+  sendInterest(Ptr<RecordingApp> app, const std::string& name)
+  {
+    auto interest = make_shared<Interest>(name);
+    app->getFace()->sendInterest(*interest);
+  }
+
+  static void
+  sendData(Ptr<RecordingApp> app, const std::string& name)
+  {
+    auto data = make_shared<Data>(name);
+    app->getFace()->sendData(*data);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnAppFace, AppFaceFixture)
+
+BOOST_AUTO_TEST_CASE(BatchedDelivery)
+{
+  std::vector<std::vector<Delivery>> eager = run(false);
+  std::vector<std::vector<Delivery>> batched = run(true);
+
+  // the Data sent by the echo callbacks are delivered after the packets already pending
+  std::vector<Delivery> expected0 = {
+    {"a", "/a/1", true, Seconds(1)},
+    {"b", "/b/2", true, Seconds(1)},
+    {"a", "/a/3/echo", true, Seconds(1)},
+    {"b", "/b/4", true, Seconds(1)},
+    {"a", "/a/5", true, Seconds(1)},
+    {"a", "/a/3/echo/reply", true, Seconds(1)}
+  };
+  std::vector<Delivery> expected1 = {
+    {"c", "/c/1/echo", true, Seconds(1)},
+    {"c", "/c/2", true, Seconds(1)},
+    {"c", "/c/1/echo/reply", true, Seconds(1)}
+  };
+
+  BOOST_REQUIRE_EQUAL(eager.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(eager[0].begin(), eager[0].end(),
+                                expected0.begin(), expected0.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(eager[1].begin(), eager[1].end(),
+                                expected1.begin(), expected1.end());
+
+  BOOST_REQUIRE_EQUAL(batched.size(), 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(batched[0].begin(), batched[0].end(),
+                                expected0.begin(), expected0.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(batched[1].begin(), batched[1].end(),
+                                expected1.begin(), expected1.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
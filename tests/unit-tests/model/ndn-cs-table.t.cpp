@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/cs.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Fixture looking up Data in the content store of NFD
+ *
+ * Each Data carries its id as content, find() returns the id of the Data found, or 0.
+ */
+class CsTableFixture : public CleanupFixture
+{
+public:
+  void
+  insert(uint32_t id, const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    data->setFreshnessPeriod(time::seconds(3600));
+    data->setContent(reinterpret_cast<const uint8_t*>(&id), sizeof(id));
+
+    Signature signature;
+    SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+    signature.setInfo(signatureInfo);
+    signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 0));
+    data->setSignature(signature);
+    data->wireEncode();
+
+    cs.insert(*data);
+  }
+
+  uint32_t
+  find(const Name& name, int childSelector = 0)
+  {
+    Interest interest(name);
+    interest.setChildSelector(childSelector);
+
+    uint32_t found = 0;
+    cs.find(interest,
+            [&found] (const Interest&, const Data& data) {
+              found = *reinterpret_cast<const uint32_t*>(data.getContent().value());
+            },
+            [] (const Interest&) {});
+    return found;
+  }
+
+public:
+  nfd::Cs cs;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelCsTable, CsTableFixture)
+
+BOOST_AUTO_TEST_CASE(Leftmost)
+{
+  insert(1, "/A");
+  insert(2, "/B/p/1");
+  insert(3, "/B/p/2");
+  insert(4, "/B/q/1");
+  insert(5, "/B/q/2");
+  insert(6, "/C");
+
+  BOOST_CHECK_EQUAL(find("/B"), 2);
+  BOOST_CHECK_EQUAL(find("/A"), 1);
+  BOOST_CHECK_EQUAL(find("/D"), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Rightmost)
+{
+  insert(1, "/A");
+  insert(2, "/B/p/1");
+  insert(3, "/B/p/2");
+  insert(4, "/B/q/1");
+  insert(5, "/B/q/2");
+  insert(6, "/C");
+
+  // rightmost child q, then leftmost Data under it
+  BOOST_CHECK_EQUAL(find("/B", 1), 4);
+}
+
+BOOST_AUTO_TEST_CASE(LongComponents)
+{
+  // component length encoded on one byte (< 253) and on three bytes (>= 253)
+  Name b252("/B");
+  b252.append(std::string(252, 'a'));
+  Name b253("/B");
+  b253.append(std::string(253, 'a'));
+  Name b300("/B");
+  b300.append(std::string(300, 'a'));
+
+  insert(1, "/A");
+  insert(2, Name(b300).append("1"));
+  insert(3, Name(b253).append("1"));
+  insert(4, Name(b252).append("1"));
+  insert(5, "/B/%FF/1");
+  insert(6, "/C");
+
+  // canonical order sorts by component length first: %FF < 252 < 253 < 300 bytes
+  BOOST_CHECK_EQUAL(find("/B"), 5);
+  BOOST_CHECK_EQUAL(find("/B", 1), 2);
+  BOOST_CHECK_EQUAL(find(b253), 3);
+  BOOST_CHECK_EQUAL(find(b253, 1), 3);
+  BOOST_CHECK_EQUAL(find(b252), 4);
+}
+
+BOOST_AUTO_TEST_CASE(PrefixOfLongerComponent)
+{
+  insert(1, "/A/%FF%FF");
+  insert(2, "/A/%FF%FF/1");
+
+  // the key of /A/%FF is not a byte prefix of the keys of /A/%FF%FF
+  BOOST_CHECK_EQUAL(find("/A/%FF"), 0);
+  BOOST_CHECK_EQUAL(find("/A/%FF", 1), 0);
+  BOOST_CHECK_EQUAL(find("/A/%FF%FF"), 1);
+  BOOST_CHECK_EQUAL(find("/A/%FF%FF", 1), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/dead-nonce-list.hpp"
+#include "table/name-tree.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Fill \p dnl past its capacity, so that it only holds Nonces and evicts the oldest one
+ *        at each addition, without time passing
+ * \return capacity of the list
+ */
+static size_t
+fillDeadNonceList(nfd::DeadNonceList& dnl)
+{
+  for (uint32_t nonce = 0; nonce < 1000; ++nonce) {
+    dnl.add(Name("/fill"), nonce);
+  }
+  return dnl.size();
+}
+
+static void
+addDeadNonces(nfd::DeadNonceList* dnl, uint32_t first, uint32_t nNonces)
+{
+  for (uint32_t nonce = first; nonce < first + nNonces; ++nonce) {
+    dnl->add(Name("/A"), nonce);
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(ModelDeadNonceList, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(NameHash)
+{
+  Name nameA("/A");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  nfd::DeadNonceList dnl;
+  dnl.add(nfd::name_tree::computeHash(nameA), nonce1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nfd::name_tree::computeHash(nameA), nonce1), true);
+  BOOST_CHECK_EQUAL(dnl.has(nfd::name_tree::computeHash(nameA), ~nonce1), false);
+  BOOST_CHECK_EQUAL(dnl.has(Name("/B"), nonce1), false);
+}
+
+BOOST_AUTO_TEST_CASE(Duplicate)
+{
+  Name nameA("/A");
+  const uint32_t nonce1 = 0x53b4eaa8;
+
+  nfd::DeadNonceList dnl;
+  const size_t capacity = fillDeadNonceList(dnl);
+  BOOST_REQUIRE_GT(capacity, 2);
+
+  // each copy takes its own slot, and is evicted in turn
+  dnl.add(nameA, nonce1);
+  dnl.add(nameA, nonce1);
+  addDeadNonces(&dnl, 0, capacity - 2);
+  BOOST_CHECK_EQUAL(dnl.size(), capacity);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+
+  addDeadNonces(&dnl, capacity - 2, 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+
+  addDeadNonces(&dnl, capacity - 1, 1);
+  BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  nfd::DeadNonceList dnl;
+  const size_t capacity = fillDeadNonceList(dnl);
+
+  // the ring buffer wraps around many times, and every eviction erases an entry from the hash
+  // table with backward shift deletion, which must keep the other entries reachable
+  const uint32_t N_NONCES = 20000;
+  for (uint32_t nonce = 0; nonce < N_NONCES; ++nonce) {
+    addDeadNonces(&dnl, nonce, 1);
+    BOOST_REQUIRE_EQUAL(dnl.size(), capacity);
+    if (nonce >= capacity) {
+      BOOST_REQUIRE_EQUAL(dnl.has(Name("/A"), nonce - capacity), false);
+    }
+
+    if (nonce % 1000 == 999) {
+      for (uint32_t kept = nonce + 1 - capacity; kept <= nonce; ++kept) {
+        BOOST_REQUIRE_EQUAL(dnl.has(Name("/A"), kept), true);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Compact)
+{
+  const int64_t LIFETIME_MS = 100;
+  nfd::DeadNonceList dnl(time::milliseconds(LIFETIME_MS));
+  const nfd::TableMemoryUsage initialUsage = dnl.getMemoryUsage();
+
+  // 10000 Nonces per lifetime during 3s: the capacity, the ring buffer and the hash table grow
+  for (uint32_t i = 0; i < 300; ++i) {
+    Simulator::Schedule(MilliSeconds(LIFETIME_MS / 10 * i), &addDeadNonces, &dnl, 1000 * i, 1000);
+  }
+  Simulator::Stop(Seconds(3));
+  Simulator::Run();
+
+  BOOST_CHECK_GT(dnl.size(), 1000);
+  BOOST_CHECK_GT(dnl.getMemoryUsage().overheadBytes, 4 * initialUsage.overheadBytes);
+  BOOST_CHECK_EQUAL(dnl.has(Name("/A"), 299999), true);
+
+  // without new Nonces, the capacity decreases and the buffers are shrunk back
+  Simulator::Stop(Seconds(60));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(dnl.size(), 0);
+  BOOST_CHECK_EQUAL(dnl.getMemoryUsage().overheadBytes, initialUsage.overheadBytes);
+  BOOST_CHECK_EQUAL(dnl.has(Name("/A"), 299999), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
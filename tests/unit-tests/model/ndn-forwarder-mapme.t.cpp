@@ -0,0 +1,229 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "fw/forwarder-mapme.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+using nfd::tests::DummyLocalFace;
+
+class MapMeBatchFixture : public CleanupFixture
+{
+protected:
+  MapMeBatchFixture()
+    : forwarder(MAPME_DEFAULT_TU)
+    , appFace(make_shared<DummyLocalFace>("appFace://", "appFace://"))
+    , wifiFace(make_shared<DummyFace>())
+  {
+    forwarder.setBatchedUpdates(true);
+    // the forwarder reports every special interest it sends and processes
+    forwarder.m_onSpecialInterest = MakeCallback(&MapMeBatchFixture::ignoreSpecialInterest);
+    forwarder.m_onProcessing = MakeCallback(&MapMeBatchFixture::ignoreSpecialInterest);
+    forwarder.addFace(appFace);
+    forwarder.getFib().insert("/A").first->addNextHop(appFace, 0);
+  }
+
+  /** \brief runs the scheduler of NFD, which is driven by the simulator
+   */
+  void
+  advance(Time duration)
+  {
+    Simulator::Stop(duration);
+    Simulator::Run();
+  }
+
+  /** \brief (prefix, seq) pairs carried by a batched special interest
+   */
+  static std::vector<std::pair<Name, uint64_t>>
+  decodeBatch(const Interest& interest)
+  {
+    std::vector<std::pair<Name, uint64_t>> entries;
+    const Name& name = interest.getName();
+    for (size_t i = Name(MAPME_BATCH_PREFIX).size(); i + 1 < name.size(); i += 2) {
+      entries.emplace_back(Name(name[i].blockFromValue()), name[i + 1].toNumber());
+    }
+    return entries;
+  }
+
+  static Interest
+  makeBatch(const std::vector<std::pair<Name, uint64_t>>& entries,
+            ::ndn::tlv::SpecialInterestTypeValue type)
+  {
+    Name name(MAPME_BATCH_PREFIX);
+    for (const auto& entry : entries) {
+      name.append(entry.first.wireEncode()).appendNumber(entry.second);
+    }
+    Interest interest(name);
+    interest.setAsSpecialInterest(type, 0);
+    return interest;
+  }
+
+private:
+  static void
+  ignoreSpecialInterest(std::string, uint64_t, uint64_t, uint64_t)
+  {
+  }
+
+protected:
+  nfd::ForwarderMapMe forwarder;
+  shared_ptr<DummyLocalFace> appFace;
+  shared_ptr<DummyFace> wifiFace;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelForwarderMapMe, MapMeBatchFixture)
+
+BOOST_AUTO_TEST_CASE(BatchSurvivesFaceDown)
+{
+  // the producer prefix is announced on the new face
+  forwarder.addFace(wifiFace);
+  advance(MilliSeconds(1));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  BOOST_CHECK(Name(MAPME_BATCH_PREFIX).isPrefixOf(wifiFace->m_sentInterests[0].getName()));
+
+  // no acknowledgement: the retransmission timer expires while the face is down
+  wifiFace->setUp(false);
+  advance(MilliSeconds(2 * MAPME_DEFAULT_RETX));
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 1);
+
+  // the same face comes back up: the batch is retransmitted
+  wifiFace->setUp(true);
+  advance(MilliSeconds(MAPME_DEFAULT_RETX));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests[1].getName(),
+                    wifiFace->m_sentInterests[0].getName());
+
+  // a removed face does not come back: the batch is dropped
+  wifiFace->close();
+  advance(MilliSeconds(3 * MAPME_DEFAULT_RETX));
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Aggregation)
+{
+  // the producer prefixes all move to the new face at once
+  std::set<Name> prefixes{"/A"};
+  for (size_t i = 0; i < MAPME_BATCH_MAX_PREFIXES + 8; ++i) {
+    Name prefix = Name("/P").appendNumber(i);
+    forwarder.getFib().insert(prefix).first->addNextHop(appFace, 0);
+    prefixes.insert(prefix);
+  }
+
+  forwarder.addFace(wifiFace);
+  advance(MilliSeconds(1));
+
+  // they are carried by a full batch, then a batch with the remaining prefixes
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+  std::set<Name> sentPrefixes;
+  for (const Interest& interest : wifiFace->m_sentInterests) {
+    BOOST_CHECK(Name(MAPME_BATCH_PREFIX).isPrefixOf(interest.getName()));
+    BOOST_CHECK(interest.getSpecialInterestType() == ::ndn::tlv::TYPE_IU);
+    for (const auto& entry : decodeBatch(interest)) {
+      BOOST_CHECK_EQUAL(entry.second, forwarder.getFib().findExactMatch(entry.first)->getSeq());
+      sentPrefixes.insert(entry.first);
+    }
+  }
+  BOOST_CHECK_EQUAL(decodeBatch(wifiFace->m_sentInterests[0]).size(),
+                    static_cast<size_t>(MAPME_BATCH_MAX_PREFIXES));
+  BOOST_CHECK_EQUAL(decodeBatch(wifiFace->m_sentInterests[1]).size(), 9);
+  BOOST_CHECK_EQUAL_COLLECTIONS(sentPrefixes.begin(), sentPrefixes.end(),
+                                prefixes.begin(), prefixes.end());
+}
+
+BOOST_AUTO_TEST_CASE(ReceiveBatch)
+{
+  forwarder.addFace(wifiFace);
+  advance(MilliSeconds(1));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  appFace->m_sentInterests.clear();
+
+  // the producers of /P/1, /P/2 and of the local prefix /A have moved behind the wifi face
+  std::vector<std::pair<Name, uint64_t>> updates = {{"/P/1", 3}, {"/P/2", 5}, {"/A", 10}};
+  Interest batch = makeBatch(updates, ::ndn::tlv::TYPE_IU);
+  forwarder.onBatchedSpecialInterest(*wifiFace, batch);
+
+  // a single acknowledgement covers the whole batch
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests[1].getName(), batch.getName());
+  BOOST_CHECK(wifiFace->m_sentInterests[1].getSpecialInterestType() == ::ndn::tlv::TYPE_IU_ACK);
+
+  // every prefix is routed towards the wifi face, with the sequence number of the update
+  for (const auto& update : updates) {
+    shared_ptr<nfd::fib::Entry> fibEntry = forwarder.getFib().findExactMatch(update.first);
+    BOOST_REQUIRE(fibEntry != nullptr);
+    BOOST_CHECK_EQUAL(fibEntry->getSeq(), update.second);
+    BOOST_CHECK_EQUAL(fibEntry->getNextHops().size(), 1);
+    BOOST_CHECK(fibEntry->hasNextHop(wifiFace));
+  }
+
+  // the update of /A is forwarded to its previous next hop, and is no longer pending on the
+  // wifi face, which sent it
+  advance(MilliSeconds(1));
+  BOOST_REQUIRE_GE(appFace->m_sentInterests.size(), 1);
+  std::vector<std::pair<Name, uint64_t>> forwarded = decodeBatch(appFace->m_sentInterests[0]);
+  BOOST_REQUIRE_EQUAL(forwarded.size(), 1);
+  BOOST_CHECK_EQUAL(forwarded[0].first, Name("/A"));
+  BOOST_CHECK_EQUAL(forwarded[0].second, 10);
+
+  advance(MilliSeconds(3 * MAPME_DEFAULT_RETX));
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(PartialAck)
+{
+  forwarder.getFib().insert("/B").first->addNextHop(appFace, 0);
+  forwarder.getFib().insert("/C").first->addNextHop(appFace, 0);
+  forwarder.addFace(wifiFace);
+  advance(MilliSeconds(1));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  std::vector<std::pair<Name, uint64_t>> sent = decodeBatch(wifiFace->m_sentInterests[0]);
+  BOOST_REQUIRE_EQUAL(sent.size(), 3);
+
+  // /A and /C are acknowledged, /B is not
+  std::vector<std::pair<Name, uint64_t>> acked;
+  std::vector<std::pair<Name, uint64_t>> notAcked;
+  for (const auto& entry : sent) {
+    (entry.first == "/B" ? notAcked : acked).push_back(entry);
+  }
+  forwarder.onBatchedSpecialInterestAck(*wifiFace, makeBatch(acked, ::ndn::tlv::TYPE_IU_ACK));
+
+  // only /B is retransmitted
+  advance(MilliSeconds(MAPME_DEFAULT_RETX));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+  std::vector<std::pair<Name, uint64_t>> retransmitted =
+    decodeBatch(wifiFace->m_sentInterests[1]);
+  BOOST_CHECK_EQUAL(retransmitted.size(), 1);
+  BOOST_CHECK(retransmitted == notAcked);
+
+  // once /B is acknowledged, nothing is pending any more
+  forwarder.onBatchedSpecialInterestAck(*wifiFace, makeBatch(notAcked, ::ndn::tlv::TYPE_IU_ACK));
+  advance(MilliSeconds(3 * MAPME_DEFAULT_RETX));
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
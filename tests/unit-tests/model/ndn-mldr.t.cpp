@@ -0,0 +1,199 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "fw/mldr-mechanism.hpp"
+#include "fw/forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <ndn-cxx/security/signature-sha256-with-rsa.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::MldrMechanism;
+using nfd::tests::DummyFace;
+using nfd::tests::DummyLocalFace;
+
+class MldrFixture : public CleanupFixture
+{
+protected:
+  MldrFixture()
+    : appFace(make_shared<DummyLocalFace>())
+    , wifiFace(make_shared<DummyFace>())
+  {
+    forwarder.enableMldr();
+    forwarder.addFace(appFace);
+    forwarder.addFace(wifiFace);
+  }
+
+  MldrMechanism&
+  getMldr()
+  {
+    BOOST_REQUIRE(forwarder.getMldr() != nullptr);
+    return *forwarder.getMldr();
+  }
+
+  static shared_ptr<Interest>
+  makeInterest(const Name& name)
+  {
+    return make_shared<Interest>(name);
+  }
+
+  static shared_ptr<Data>
+  makeData(const Name& name)
+  {
+    auto data = make_shared<Data>(name);
+    ::ndn::SignatureSha256WithRsa fakeSignature;
+    fakeSignature.setValue(::ndn::dataBlock(::ndn::tlv::SignatureValue,
+                                            static_cast<const uint8_t*>(nullptr), 0));
+    data->setSignature(fakeSignature);
+    data->wireEncode();
+    return data;
+  }
+
+protected:
+  nfd::Forwarder forwarder;
+  shared_ptr<DummyLocalFace> appFace;
+  shared_ptr<DummyFace> wifiFace;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelMldr, MldrFixture)
+
+BOOST_AUTO_TEST_CASE(FirstAssociation)
+{
+  forwarder.getFib().insert("/A").first->addNextHop(wifiFace, 0);
+  appFace->receiveInterest(*makeInterest("/A/1"));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+
+  // no disassociation before: nothing was lost
+  getMldr().onAssociation(*wifiFace);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(getMldr().getNRetransmissions(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConsumerHandover)
+{
+  forwarder.getFib().insert("/A").first->addNextHop(wifiFace, 0);
+  appFace->receiveInterest(*makeInterest("/A/1"));
+  appFace->receiveInterest(*makeInterest("/A/2"));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+
+  // /A/2 is satisfied before the handover
+  wifiFace->receiveData(*makeData("/A/2"));
+  BOOST_REQUIRE_EQUAL(appFace->m_sentDatas.size(), 1);
+
+  getMldr().onDisassociation(*wifiFace);
+  getMldr().onAssociation(*wifiFace);
+
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests[2].getName(), "/A/1");
+  BOOST_CHECK_NE(wifiFace->m_sentInterests[2].getNonce(),
+                 wifiFace->m_sentInterests[0].getNonce());
+  BOOST_CHECK_EQUAL(getMldr().getNRetransmissions(), 1);
+
+  // consumer only: no notification
+  BOOST_CHECK_EQUAL(getMldr().getNOutNotifications(), 0);
+
+  // handover is over
+  getMldr().onAssociation(*wifiFace);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(HandoverToOtherFace)
+{
+  shared_ptr<DummyFace> newFace = make_shared<DummyFace>();
+  forwarder.addFace(newFace);
+
+  forwarder.getFib().insert("/A").first->addNextHop(wifiFace, 0);
+  forwarder.getFib().insert("/B").first->addNextHop(newFace, 0);
+  appFace->receiveInterest(*makeInterest("/A/1"));
+  appFace->receiveInterest(*makeInterest("/B/1"));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  BOOST_REQUIRE_EQUAL(newFace->m_sentInterests.size(), 1);
+
+  getMldr().onDisassociation(*wifiFace);
+  getMldr().onAssociation(*newFace);
+
+  // only Interests sent on the detached face are re-expressed
+  BOOST_REQUIRE_EQUAL(newFace->m_sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(newFace->m_sentInterests[1].getName(), "/A/1");
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ProducerHandover)
+{
+  forwarder.getFib().insert("/P").first->addNextHop(appFace, 0);
+  forwarder.getFib().insert("/A").first->addNextHop(wifiFace, 0);
+
+  getMldr().onDisassociation(*wifiFace);
+  getMldr().onAssociation(*wifiFace);
+
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+  const Name& name = wifiFace->m_sentInterests[0].getName();
+  BOOST_CHECK(MldrMechanism::isNotification(wifiFace->m_sentInterests[0]));
+  BOOST_REQUIRE_EQUAL(name.size(), Name(MLDR_NOTIFICATION_PREFIX).size() + 1);
+  BOOST_CHECK_EQUAL(Name(name[-1].blockFromValue()), "/P");
+  BOOST_CHECK_EQUAL(getMldr().getNOutNotifications(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Notification)
+{
+  // upstream node: appFace plays the consumer side, wifiFace the old access link
+  shared_ptr<DummyFace> newFace = make_shared<DummyFace>();
+  forwarder.addFace(newFace);
+
+  forwarder.getFib().insert("/P").first->addNextHop(wifiFace, 0);
+  forwarder.getFib().insert("/Q").first->addNextHop(wifiFace, 0);
+  appFace->receiveInterest(*makeInterest("/P/1"));
+  appFace->receiveInterest(*makeInterest("/Q/1"));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+
+  Name name(MLDR_NOTIFICATION_PREFIX);
+  name.append(Name("/P").wireEncode());
+  newFace->receiveInterest(*makeInterest(name));
+
+  BOOST_CHECK_EQUAL(getMldr().getNInNotifications(), 1);
+  BOOST_REQUIRE_EQUAL(newFace->m_sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(newFace->m_sentInterests[0].getName(), "/P/1");
+  BOOST_CHECK_EQUAL(getMldr().getNRetransmissions(), 1);
+
+  // the notification does not create a PIT entry
+  BOOST_CHECK_EQUAL(forwarder.getPit().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(MalformedNotification)
+{
+  forwarder.getFib().insert("/P").first->addNextHop(wifiFace, 0);
+  appFace->receiveInterest(*makeInterest("/P/1"));
+
+  Name name(MLDR_NOTIFICATION_PREFIX);
+  name.append("not-a-name");
+  wifiFace->receiveInterest(*makeInterest(name));
+
+  BOOST_CHECK_EQUAL(getMldr().getNInNotifications(), 1);
+  BOOST_CHECK_EQUAL(getMldr().getNRetransmissions(), 0);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
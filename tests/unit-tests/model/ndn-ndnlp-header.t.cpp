@@ -0,0 +1,98 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-ndnlp-header.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/face/ndnlp-data.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnNdnlpHeader, CleanupFixture)
+
+static std::vector<uint8_t>
+serialize(const NdnlpHeader& header, uint32_t payloadSize)
+{
+  std::vector<uint8_t> payload(payloadSize, 0xBB);
+  Ptr<Packet> packet = Create<Packet>(payload.data(), payload.size());
+  packet->AddHeader(header);
+
+  std::vector<uint8_t> buffer(packet->GetSize());
+  packet->CopyData(buffer.data(), buffer.size());
+  return buffer;
+}
+
+BOOST_AUTO_TEST_CASE(Fragment)
+{
+  NdnlpHeader header(0x1234, 300, 301, 1000);
+  std::vector<uint8_t> wire = serialize(header, 1000);
+  BOOST_CHECK_EQUAL(wire.size(), header.GetSerializedSize() + 1000);
+
+  // compatible with NFD's NDNLP implementation
+  bool isOk = false;
+  nfd::ndnlp::NdnlpData parsed;
+  std::tie(isOk, parsed) = nfd::ndnlp::NdnlpData::fromBlock(Block(wire.data(), wire.size()));
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(parsed.seq, 0x1234);
+  BOOST_CHECK_EQUAL(parsed.fragIndex, 300);
+  BOOST_CHECK_EQUAL(parsed.fragCount, 301);
+  BOOST_CHECK_EQUAL(parsed.payload.value_size(), 1000);
+
+  Ptr<Packet> packet = Create<Packet>(wire.data(), wire.size());
+  NdnlpHeader decoded;
+  packet->RemoveHeader(decoded);
+  BOOST_CHECK_EQUAL(decoded.GetSequence(), 0x1234);
+  BOOST_CHECK_EQUAL(decoded.GetFragIndex(), 300);
+  BOOST_CHECK_EQUAL(decoded.GetFragCount(), 301);
+  BOOST_CHECK_EQUAL(decoded.GetPayloadSize(), 1000);
+  BOOST_CHECK_EQUAL(packet->GetSize(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(SingleFragment)
+{
+  NdnlpHeader header(7, 0, 1, 100);
+  std::vector<uint8_t> wire = serialize(header, 100);
+
+  bool isOk = false;
+  nfd::ndnlp::NdnlpData parsed;
+  std::tie(isOk, parsed) = nfd::ndnlp::NdnlpData::fromBlock(Block(wire.data(), wire.size()));
+  BOOST_REQUIRE(isOk);
+  BOOST_CHECK_EQUAL(parsed.fragCount, 1);
+
+  Ptr<Packet> packet = Create<Packet>(wire.data(), wire.size());
+  NdnlpHeader decoded;
+  packet->RemoveHeader(decoded);
+  BOOST_CHECK_EQUAL(decoded.GetSequence(), 7);
+  BOOST_CHECK_EQUAL(decoded.GetFragCount(), 1);
+  BOOST_CHECK_EQUAL(packet->GetSize(), 100);
+}
+
+BOOST_AUTO_TEST_CASE(MaxPayloadSize)
+{
+  uint32_t maxPayloadSize = NdnlpHeader::GetMaxPayloadSize(1500);
+  NdnlpHeader header(std::numeric_limits<uint64_t>::max(), 65534, 65535, maxPayloadSize);
+  BOOST_CHECK_LE(header.GetSerializedSize() + maxPayloadSize, 1500);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
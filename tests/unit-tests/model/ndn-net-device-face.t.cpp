@@ -60,6 +60,100 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
 }
 
+BOOST_AUTO_TEST_CASE(Fragmentation)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointNetDevice::Mtu", StringValue("1500"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "2"},
+    });
+
+  addRoutes({
+      {"1", "2", "/prefix", 1},
+    });
+
+  // Data packets are about 8KB, and sent in six NDNLP fragments
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "8000"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getFaceStatus().getNInDatas(), 100);
+
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNInInterests(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getFaceStatus().getNOutDatas(), 100);
+}
+
+class BatchedReceiveFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  BatchedReceiveFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::BatchedReceive", BooleanValue(true));
+  }
+
+  ~BatchedReceiveFixture()
+  {
+    Config::SetDefault("ns3::ndn::L3Protocol::BatchedReceive", BooleanValue(false));
+  }
+};
+
+BOOST_FIXTURE_TEST_CASE(BatchedReceive, BatchedReceiveFixture)
+{
+  Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+  Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+  Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+  createTopology({
+      {"1", "3"},
+      {"2", "3"},
+      {"3", "4"},
+    });
+
+  addRoutes({
+      {"1", "3", "/prefix", 1},
+      {"2", "3", "/prefix", 1},
+      {"3", "4", "/prefix", 1},
+    });
+
+  // Interests of both consumers reach router 3 at the same times, and are forwarded together
+  addApps({
+      {"1", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"2", "ns3::ndn::ConsumerCbr",
+          {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+          "0s", "9.99s"},
+      {"4", "ns3::ndn::Producer",
+          {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+          "0s", "100s"}
+    });
+
+  Simulator::Stop(Seconds(20.001));
+  Simulator::Run();
+
+  BOOST_CHECK_EQUAL(getFace("3", "1")->getFaceStatus().getNInInterests(), 100);
+  BOOST_CHECK_EQUAL(getFace("3", "2")->getFaceStatus().getNInInterests(), 100);
+
+  // the second Interest of each pair is aggregated in the PIT entry of the first
+  BOOST_CHECK_EQUAL(getFace("3", "4")->getFaceStatus().getNOutInterests(), 100);
+  BOOST_CHECK_EQUAL(getFace("3", "4")->getFaceStatus().getNInDatas(), 100);
+
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getFaceStatus().getNInDatas(), 100);
+  BOOST_CHECK_EQUAL(getFace("2", "3")->getFaceStatus().getNInDatas(), 100);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/pit-entry.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+using nfd::pit::N_INLINE_FACE_RECORDS;
+
+class PitEntryFixture : public CleanupFixture
+{
+public:
+  PitEntryFixture()
+    : interest(make_shared<Interest>("/Z3pOBGNn"))
+  {
+    interest->setNonce(1);
+
+    // enough faces for the records to outgrow the inline storage of the entry
+    for (size_t i = 0; i < N_INLINE_FACE_RECORDS + 3; ++i) {
+      faces.push_back(make_shared<DummyFace>());
+    }
+  }
+
+public:
+  shared_ptr<Interest> interest;
+  std::vector<shared_ptr<nfd::Face>> faces;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelPitEntry, PitEntryFixture)
+
+BOOST_AUTO_TEST_CASE(FrontInsertion)
+{
+  nfd::pit::Entry entry(*interest);
+
+  for (const shared_ptr<nfd::Face>& face : faces) {
+    nfd::pit::InRecordCollection::iterator inRecord =
+      entry.insertOrUpdateInRecord(face, *interest);
+    BOOST_CHECK(inRecord == entry.getInRecords().begin());
+    nfd::pit::OutRecordCollection::iterator outRecord =
+      entry.insertOrUpdateOutRecord(face, *interest);
+    BOOST_CHECK(outRecord == entry.getOutRecords().begin());
+  }
+
+  // the newest record comes first
+  BOOST_REQUIRE_EQUAL(entry.getInRecords().size(), faces.size());
+  BOOST_REQUIRE_EQUAL(entry.getOutRecords().size(), faces.size());
+  auto face = faces.rbegin();
+  auto inRecord = entry.getInRecords().begin();
+  auto outRecord = entry.getOutRecords().begin();
+  for (; face != faces.rend(); ++face, ++inRecord, ++outRecord) {
+    BOOST_CHECK_EQUAL(inRecord->getFace(), *face);
+    BOOST_CHECK_EQUAL(outRecord->getFace(), *face);
+  }
+
+  // updating an existing record neither adds nor moves it
+  entry.insertOrUpdateInRecord(faces.front(), *interest);
+  entry.insertOrUpdateOutRecord(faces.front(), *interest);
+  BOOST_CHECK_EQUAL(entry.getInRecords().size(), faces.size());
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), faces.size());
+  BOOST_CHECK_EQUAL(entry.getInRecords().back().getFace(), faces.front());
+  BOOST_CHECK_EQUAL(entry.getOutRecords().back().getFace(), faces.front());
+}
+
+BOOST_AUTO_TEST_CASE(LookupAfterGrowth)
+{
+  nfd::pit::Entry entry(*interest);
+
+  for (size_t i = 0; i < faces.size(); ++i) {
+    entry.insertOrUpdateInRecord(faces[i], *interest);
+    entry.insertOrUpdateOutRecord(faces[i], *interest);
+
+    // records inserted before the storage grew are still found
+    for (size_t j = 0; j <= i; ++j) {
+      auto inRecord = entry.getInRecord(*faces[j]);
+      BOOST_REQUIRE(inRecord != entry.getInRecords().end());
+      BOOST_CHECK_EQUAL(inRecord->getFace(), faces[j]);
+
+      auto outRecord = entry.getOutRecord(*faces[j]);
+      BOOST_REQUIRE(outRecord != entry.getOutRecords().end());
+      BOOST_CHECK_EQUAL(outRecord->getFace(), faces[j]);
+    }
+  }
+
+  shared_ptr<nfd::Face> otherFace = make_shared<DummyFace>();
+  BOOST_CHECK(entry.getInRecord(*otherFace) == entry.getInRecords().end());
+  BOOST_CHECK(entry.getOutRecord(*otherFace) == entry.getOutRecords().end());
+}
+
+BOOST_AUTO_TEST_CASE(EraseWhileIterating)
+{
+  nfd::pit::Entry entry(*interest);
+  std::set<shared_ptr<nfd::Face>> erasedFaces;
+  for (size_t i = 0; i < faces.size(); ++i) {
+    entry.insertOrUpdateOutRecord(faces[i], *interest);
+    if (i % 2 == 0) {
+      erasedFaces.insert(faces[i]);
+    }
+  }
+
+  // deleting a record invalidates the iterators, so the loop resumes at the same position
+  // after each deletion
+  for (auto outRecord = entry.getOutRecords().begin();
+       outRecord != entry.getOutRecords().end(); ) {
+    if (erasedFaces.count(outRecord->getFace()) > 0) {
+      size_t position = outRecord - entry.getOutRecords().begin();
+      entry.deleteOutRecord(*outRecord->getFace());
+      outRecord = entry.getOutRecords().begin() + position;
+    }
+    else {
+      ++outRecord;
+    }
+  }
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), faces.size() - erasedFaces.size());
+
+  // the remaining records keep their order and are still found
+  auto outRecord = entry.getOutRecords().begin();
+  for (auto face = faces.rbegin(); face != faces.rend(); ++face) {
+    if (erasedFaces.count(*face) > 0) {
+      BOOST_CHECK(entry.getOutRecord(**face) == entry.getOutRecords().end());
+    }
+    else {
+      BOOST_REQUIRE(outRecord != entry.getOutRecords().end());
+      BOOST_CHECK_EQUAL(outRecord->getFace(), *face);
+      BOOST_CHECK(entry.getOutRecord(**face) == outRecord);
+      ++outRecord;
+    }
+  }
+
+  // the collection can be emptied and filled again
+  for (const shared_ptr<nfd::Face>& face : faces) {
+    entry.deleteOutRecord(*face);
+  }
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 0);
+  entry.insertOrUpdateOutRecord(faces.front(), *interest);
+  BOOST_CHECK_EQUAL(entry.getOutRecords().size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
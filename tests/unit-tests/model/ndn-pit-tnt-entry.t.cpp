@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/pit-tnt-entry.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::pit::TntEntry;
+using nfd::pit::TNT_MIN_CLEANUP_THRESHOLD;
+
+class TracingInterests
+{
+public:
+  explicit
+  TracingInterests(const Name& traceName)
+    : m_traceName(traceName)
+  {
+  }
+
+  void
+  add(TntEntry& tntEntry, const Name& name, const time::milliseconds& lifetime)
+  {
+    shared_ptr<Interest> interest = make_shared<Interest>(name);
+    interest->setTraceName(m_traceName);
+    interest->setInterestLifetime(lifetime);
+    shared_ptr<nfd::pit::Entry> pitEntry = make_shared<nfd::pit::Entry>(*interest);
+    m_interests.push_back(interest);
+    m_pitEntries.push_back(pitEntry);
+    tntEntry.addTracingRecord(interest, m_face, pitEntry);
+  }
+
+private:
+  Name m_traceName;
+  shared_ptr<nfd::Face> m_face = make_shared<nfd::tests::DummyFace>();
+  std::vector<shared_ptr<Interest>> m_interests;
+  std::vector<shared_ptr<nfd::pit::Entry>> m_pitEntries;
+};
+
+class PitTntEntryFixture : public CleanupFixture
+{
+protected:
+  /** \brief advances the simulation time, which is the time of NFD's clocks
+   */
+  void
+  advance(Time duration)
+  {
+    Simulator::Stop(duration);
+    Simulator::Run();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelPitTntEntry, PitTntEntryFixture)
+
+BOOST_AUTO_TEST_CASE(AddRecords)
+{
+  TntEntry tntEntry("/trace");
+  TracingInterests interests("/trace");
+
+  interests.add(tntEntry, "/A/1", time::milliseconds(100));
+  interests.add(tntEntry, "/A/2", time::milliseconds(100));
+  BOOST_CHECK_EQUAL(tntEntry.getTracingInterests().size(), 2);
+
+  // same name: one record, with the latest expiry
+  interests.add(tntEntry, "/A/1", time::milliseconds(500));
+  BOOST_REQUIRE_EQUAL(tntEntry.getTracingInterests().size(), 2);
+  BOOST_CHECK(tntEntry.getTracingInterests().at("/A/1").getExpiry() >
+              tntEntry.getTracingInterests().at("/A/2").getExpiry());
+
+  // trace name mismatch
+  TracingInterests otherInterests("/other");
+  otherInterests.add(tntEntry, "/A/3", time::milliseconds(100));
+  BOOST_CHECK_EQUAL(tntEntry.getTracingInterests().size(), 2);
+
+  TntEntry::TracingInterestList::const_iterator it = tntEntry.getTracingInterests().begin();
+  it = tntEntry.removeTracingRecord(it);
+  BOOST_CHECK_EQUAL(tntEntry.getTracingInterests().size(), 1);
+  BOOST_CHECK(it == tntEntry.getTracingInterests().begin());
+}
+
+BOOST_AUTO_TEST_CASE(RemoveInvalidRecords)
+{
+  TntEntry tntEntry("/trace");
+  TracingInterests interests("/trace");
+
+  for (size_t i = 0; i < TNT_MIN_CLEANUP_THRESHOLD - 1; ++i) {
+    interests.add(tntEntry, Name("/A").appendNumber(i), time::milliseconds(100));
+  }
+  BOOST_CHECK_EQUAL(tntEntry.getTracingInterests().size(), TNT_MIN_CLEANUP_THRESHOLD - 1);
+
+  advance(MilliSeconds(200));
+
+  // reaching the threshold collects expired records
+  interests.add(tntEntry, "/B", time::milliseconds(100));
+  BOOST_REQUIRE_EQUAL(tntEntry.getTracingInterests().size(), 1);
+  BOOST_CHECK(tntEntry.getTracingInterests().count("/B") == 1);
+
+  // the number of stale records stays bounded without explicit cleanup
+  for (size_t i = 0; i < 10 * TNT_MIN_CLEANUP_THRESHOLD; ++i) {
+    interests.add(tntEntry, Name("/C").appendNumber(i), time::milliseconds(100));
+    advance(MilliSeconds(200));
+    BOOST_CHECK_LT(tntEntry.getTracingInterests().size(), TNT_MIN_CLEANUP_THRESHOLD);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
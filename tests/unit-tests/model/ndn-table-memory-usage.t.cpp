@@ -0,0 +1,57 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "table/table-memory-usage.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(ModelTableMemoryUsage)
+
+BOOST_AUTO_TEST_CASE(InternedNameHeapSize)
+{
+  Name interned = Name("/A/B/C/D").intern();
+  Name interned2 = Name("/A/B/C/D").intern();
+  const size_t wireSize = interned.wireEncode().size();
+  const size_t componentsSize = 4 * sizeof(name::Component);
+
+  // each holder references the buffer from the Name block and from its four components
+  BOOST_CHECK_EQUAL(nfd::getNameHolderCount(interned), 2);
+  BOOST_CHECK_EQUAL(nfd::getNameHeapSize(interned), wireSize / 2 + componentsSize);
+
+  {
+    Name copy = interned;
+    BOOST_CHECK_EQUAL(nfd::getNameHolderCount(interned), 3);
+    BOOST_CHECK_EQUAL(nfd::getNameHeapSize(copy), wireSize / 3 + componentsSize);
+  }
+
+  // prefixes are interned in their own buffers
+  Name prefix = interned.getPrefix(2);
+  BOOST_CHECK_EQUAL(nfd::getNameHolderCount(prefix), 1);
+  BOOST_CHECK_EQUAL(nfd::getNameHolderCount(interned2), 2);
+  BOOST_CHECK_EQUAL(nfd::getNameHeapSize(prefix),
+                    prefix.wireEncode().size() + 2 * sizeof(name::Component));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
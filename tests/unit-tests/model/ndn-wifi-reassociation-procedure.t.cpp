@@ -0,0 +1,100 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "fw/wifi-reassociation-procedure.hpp"
+#include "fw/forwarder.hpp"
+#include "tests/daemon/face/dummy-face.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::tests::DummyFace;
+using nfd::tests::DummyLocalFace;
+
+class WifiReassociationFixture : public CleanupFixture
+{
+protected:
+  WifiReassociationFixture()
+    : procedure(forwarder)
+    , wifiFace(make_shared<DummyFace>())
+  {
+    forwarder.addFace(wifiFace);
+
+    forwarder.afterFaceAssociated.connect([this] (shared_ptr<nfd::Face> face) {
+        associatedFaces.push_back(face->getId());
+      });
+    forwarder.afterFaceDisassociated.connect([this] (shared_ptr<nfd::Face> face) {
+        disassociatedFaces.push_back(face->getId());
+      });
+  }
+
+protected:
+  nfd::Forwarder forwarder;
+  nfd::WifiReassociationProcedure procedure;
+  shared_ptr<DummyFace> wifiFace;
+
+  std::vector<nfd::FaceId> associatedFaces;
+  std::vector<nfd::FaceId> disassociatedFaces;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelWifiReassociationProcedure, WifiReassociationFixture)
+
+BOOST_AUTO_TEST_CASE(Handover)
+{
+  procedure.onDisassociation(wifiFace);
+  BOOST_CHECK(!wifiFace->isUp());
+  BOOST_REQUIRE_EQUAL(disassociatedFaces.size(), 1);
+  BOOST_CHECK_EQUAL(disassociatedFaces[0], wifiFace->getId());
+  BOOST_CHECK_EQUAL(associatedFaces.size(), 0);
+
+  procedure.onAssociation(wifiFace);
+  BOOST_CHECK(wifiFace->isUp());
+  BOOST_REQUIRE_EQUAL(associatedFaces.size(), 1);
+  BOOST_CHECK_EQUAL(associatedFaces[0], wifiFace->getId());
+
+  BOOST_CHECK_EQUAL(procedure.getNAssociations(), 1);
+  BOOST_CHECK_EQUAL(procedure.getNDisassociations(), 1);
+}
+
+#ifdef MLDR
+BOOST_AUTO_TEST_CASE(Mldr)
+{
+  forwarder.enableMldr();
+  shared_ptr<DummyLocalFace> appFace = make_shared<DummyLocalFace>();
+  forwarder.addFace(appFace);
+  forwarder.getFib().insert("/A").first->addNextHop(wifiFace, 0);
+
+  appFace->receiveInterest(*make_shared<Interest>("/A/1"));
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 1);
+
+  procedure.onDisassociation(wifiFace);
+  procedure.onAssociation(wifiFace);
+
+  // Interest lost during the handover is re-expressed
+  BOOST_REQUIRE_EQUAL(wifiFace->m_sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(wifiFace->m_sentInterests[1].getName(), "/A/1");
+}
+#endif // MLDR
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
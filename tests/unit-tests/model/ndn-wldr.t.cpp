@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "face/wldr.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+using nfd::Wldr;
+
+class WldrFixture : public CleanupFixture
+{
+protected:
+  WldrFixture()
+    : sender(SENDER_ID, 8, 1)
+    , receiver(RECEIVER_ID, 8, 1)
+  {
+    // link: notifications of the receiver reach the sender
+    receiver.onSendLossNotification.connect([this] (const Block& notification) {
+      notifications.push_back(notification);
+      sender.receiveLossNotification(notification);
+    });
+    sender.onRetransmit.connect([this] (uint64_t seq) {
+      retransmitted.push_back(seq);
+    });
+  }
+
+protected:
+  static const uint64_t SENDER_ID = 0x0a;
+  static const uint64_t RECEIVER_ID = 0x0b;
+
+  Wldr sender;
+  Wldr receiver;
+  std::vector<Block> notifications;
+  std::vector<uint64_t> retransmitted;
+};
+
+BOOST_FIXTURE_TEST_SUITE(ModelWldr, WldrFixture)
+
+BOOST_AUTO_TEST_CASE(Header)
+{
+  Block header = Wldr::encodeHeader(0x0102030405060708);
+  BOOST_CHECK_EQUAL(header.type(), nfd::tlv::WldrHeader);
+  BOOST_CHECK_EQUAL(header.size(), Wldr::getHeaderSize());
+
+  bool isOk = false;
+  uint64_t seq = 0;
+  std::tie(isOk, seq) = Wldr::decodeHeader(header);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(seq, 0x0102030405060708);
+
+  Block invalid = ::ndn::makeNonNegativeIntegerBlock(nfd::tlv::WldrHeader, 1);
+  std::tie(isOk, seq) = Wldr::decodeHeader(invalid);
+  BOOST_CHECK(!isOk);
+}
+BOOST_AUTO_TEST_CASE(NoLoss)
+{
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK(receiver.receivePacket(SENDER_ID, sender.assignSequence()));
+  }
+  BOOST_CHECK_EQUAL(notifications.size(), 0);
+  BOOST_CHECK_EQUAL(receiver.getNLosses(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(LossRecovery)
+{
+  for (int i = 0; i < 6; ++i) {
+    uint64_t seq = sender.assignSequence();
+    if (seq == 2 || seq == 3) {
+      continue; // lost
+    }
+    BOOST_CHECK(receiver.receivePacket(SENDER_ID, seq));
+  }
+
+  // loss detected on reception of 4
+  BOOST_REQUIRE_EQUAL(notifications.size(), 1);
+  BOOST_CHECK_EQUAL(receiver.getNLosses(), 2);
+  BOOST_REQUIRE_EQUAL(retransmitted.size(), 2);
+  BOOST_CHECK_EQUAL(retransmitted[0], 2);
+  BOOST_CHECK_EQUAL(retransmitted[1], 3);
+  BOOST_CHECK_EQUAL(sender.getNRetransmissions(), 2);
+
+  // retransmissions are passed up once
+  BOOST_CHECK(receiver.receivePacket(SENDER_ID, 3));
+  BOOST_CHECK(!receiver.receivePacket(SENDER_ID, 3));
+  BOOST_CHECK(receiver.receivePacket(SENDER_ID, 2));
+  BOOST_CHECK_EQUAL(receiver.getNRecovered(), 2);
+  BOOST_CHECK_EQUAL(receiver.getNDuplicates(), 1);
+
+  // already received
+  BOOST_CHECK(!receiver.receivePacket(SENDER_ID, 4));
+}
+
+BOOST_AUTO_TEST_CASE(MaxRetransmissions)
+{
+  sender.assignSequence(); // 0
+  sender.assignSequence(); // 1
+
+  receiver.receivePacket(SENDER_ID, 0);
+  receiver.receivePacket(SENDER_ID, 2);
+  BOOST_REQUIRE_EQUAL(retransmitted.size(), 1);
+
+  // notification of the loss again: already retransmitted once
+  sender.receiveLossNotification(notifications.back());
+  BOOST_CHECK_EQUAL(retransmitted.size(), 1);
+  BOOST_CHECK_EQUAL(sender.getNUnrecoverable(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(OutOfBuffer)
+{
+  for (int i = 0; i < 20; ++i) {
+    sender.assignSequence();
+  }
+
+  // 12..16 lost, still buffered
+  receiver.receivePacket(SENDER_ID, 11);
+  receiver.receivePacket(SENDER_ID, 17);
+  BOOST_REQUIRE_EQUAL(notifications.size(), 1);
+  BOOST_CHECK_EQUAL(sender.getNUnrecoverable(), 0);
+  BOOST_CHECK_EQUAL(retransmitted.size(), 5);
+
+  // gap larger than the buffer: no notification
+  receiver.receivePacket(SENDER_ID, 40);
+  BOOST_CHECK_EQUAL(notifications.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(OtherDestination)
+{
+  Wldr other(0x0c, 8, 1);
+  other.onRetransmit.connect([this] (uint64_t seq) {
+    retransmitted.push_back(seq);
+  });
+  other.assignSequence();
+  other.assignSequence();
+
+  receiver.receivePacket(SENDER_ID, 0);
+  receiver.receivePacket(SENDER_ID, 2);
+  other.receiveLossNotification(notifications.back());
+  BOOST_CHECK_EQUAL(other.getNRetransmissions(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Peers)
+{
+  // sequence numbers are tracked per peer
+  BOOST_CHECK(receiver.receivePacket(1, 100));
+  BOOST_CHECK(receiver.receivePacket(2, 50));
+  BOOST_CHECK(receiver.receivePacket(1, 101));
+  BOOST_CHECK(receiver.receivePacket(2, 51));
+  BOOST_CHECK_EQUAL(notifications.size(), 0);
+
+  // peer 2 restarted
+  BOOST_CHECK(receiver.receivePacket(2, 0));
+  BOOST_CHECK(receiver.receivePacket(2, 1));
+  BOOST_CHECK_EQUAL(notifications.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-nonce-generator.hpp"
+#include "helper/ndn-app-helper.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <set>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class NonceGeneratorFixture : public CleanupFixture
+{
+public:
+  NonceGeneratorFixture()
+    : m_originalRun(RngSeedManager::GetRun())
+  {
+  }
+
+  ~NonceGeneratorFixture()
+  {
+    RngSeedManager::SetRun(m_originalRun);
+  }
+
+  /**
+   * @brief Run a scenario where ndn-cxx applications on two nodes express Interests without
+   *        nonce, and return the trace of Interests received by the forwarders
+   */
+  std::vector<std::string>
+  runScenario(uint64_t run)
+  {
+    RngSeedManager::SetRun(run);
+    m_trace.clear();
+
+    {
+      ScenarioHelper scenario;
+      scenario.createTopology({{"A", "C"}, {"B", "C"}});
+      scenario.addRoutes({{"A", "C", "/prefix", 1}, {"B", "C", "/prefix", 1}});
+      scenario.addApps({{"C", "ns3::ndn::Producer", {{"Prefix", "/prefix"}}, "0s", "100s"}});
+
+      for (const std::string& node : {"A", "B"}) {
+        FactoryCallbackApp::Install(scenario.getNode(node), [node] () -> shared_ptr<void> {
+            auto face = make_shared<::ndn::Face>();
+            for (int i = 0; i < 10; ++i) {
+              face->expressInterest(Name("/prefix").append(node).appendNumber(i),
+                                    [] (const Interest&, const Data&) {},
+                                    [] (const Interest&) {});
+            }
+            return face;
+          })
+          .Start(Seconds(0.1));
+      }
+
+      Config::ConnectWithoutContext("/NodeList/*/$ns3::ndn::L3Protocol/InInterests",
+                                    MakeCallback(&NonceGeneratorFixture::onInterest, this));
+
+      Simulator::Stop(Seconds(1));
+      Simulator::Run();
+    }
+
+    Simulator::Destroy();
+    Names::Clear();
+    GlobalRouter::clear();
+
+    return m_trace;
+  }
+
+private:
+  void
+  onInterest(const Interest& interest, const Face& face)
+  {
+    std::ostringstream os;
+    os << Simulator::Now() << " " << interest.getName() << " " << interest.getNonce();
+    m_trace.push_back(os.str());
+  }
+
+private:
+  uint64_t m_originalRun;
+  std::vector<std::string> m_trace;
+};
+
+static void
+drawNonces(NonceGenerator* generator, std::vector<uint32_t>* nonces)
+{
+  for (int i = 0; i < 10; ++i) {
+    nonces->push_back(generator->generateNonce());
+  }
+}
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnNonceGenerator, NonceGeneratorFixture)
+
+BOOST_AUTO_TEST_CASE(SameRun)
+{
+  std::vector<std::string> trace1 = runScenario(1);
+  std::vector<std::string> trace2 = runScenario(1);
+
+  // each Interest is received by the forwarder of the consumer and of the producer
+  BOOST_CHECK_EQUAL(trace1.size(), 40);
+  BOOST_CHECK_EQUAL_COLLECTIONS(trace1.begin(), trace1.end(), trace2.begin(), trace2.end());
+}
+
+BOOST_AUTO_TEST_CASE(DifferentRuns)
+{
+  std::vector<std::string> trace1 = runScenario(1);
+  std::vector<std::string> trace2 = runScenario(2);
+
+  BOOST_CHECK_EQUAL(trace1.size(), trace2.size());
+  BOOST_CHECK(trace1 != trace2);
+}
+
+BOOST_AUTO_TEST_CASE(Streams)
+{
+  NonceGenerator generator;
+
+  // nonces drawn in the context of different nodes come from different streams
+  std::vector<uint32_t> nonces1;
+  std::vector<uint32_t> nonces2;
+  Simulator::ScheduleWithContext(1, Seconds(0), &drawNonces, &generator, &nonces1);
+  Simulator::ScheduleWithContext(2, Seconds(0), &drawNonces, &generator, &nonces2);
+  Simulator::Run();
+
+  BOOST_CHECK(nonces1 != nonces2);
+  BOOST_CHECK_EQUAL(std::set<uint32_t>(nonces1.begin(), nonces1.end()).size(), 10);
+
+  // resets the streams while the generator is alive
+  Simulator::Destroy();
+}
+
+BOOST_AUTO_TEST_CASE(DestroyedBeforeSimulator)
+{
+  {
+    NonceGenerator generator;
+    std::vector<uint32_t> nonces;
+    Simulator::ScheduleWithContext(1, Seconds(0), &drawNonces, &generator, &nonces);
+    Simulator::Run();
+    BOOST_CHECK_EQUAL(nonces.size(), 10);
+  }
+
+  // the reset of the destroyed generator is cancelled
+  Simulator::Destroy();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-ns3-packet-tag.hpp"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+
+#include <boost/mpl/vector.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \brief Tag without an inline slot, stored in the map of TagHost
+ */
+class MapTag : public ::ndn::Tag
+{
+public:
+  static size_t
+  getTypeId()
+  {
+    return 0x2b8b1e7c;
+  }
+};
+
+static_assert(::ndn::TagSlot<MapTag>::value == ::ndn::NO_TAG_SLOT,
+              "MapTag must not have an inline slot");
+static_assert(::ndn::TagSlot<Ns3PacketTag>::value < ::ndn::TagHost::N_TAG_SLOTS,
+              "Ns3PacketTag must have an inline slot");
+
+class Ns3PacketTagFixture : public CleanupFixture
+{
+public:
+  Ns3PacketTagFixture()
+    : packetTag(make_shared<Ns3PacketTag>(Create<Packet>(100)))
+    , mapTag(make_shared<MapTag>())
+  {
+  }
+
+public:
+  shared_ptr<Ns3PacketTag> packetTag;
+  shared_ptr<MapTag> mapTag;
+};
+
+static shared_ptr<Interest>
+makePacket(Interest*)
+{
+  return make_shared<Interest>("/A");
+}
+
+static shared_ptr<Data>
+makePacket(Data*)
+{
+  return make_shared<Data>("/A");
+}
+
+typedef boost::mpl::vector<Interest, Data> Packets;
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnNs3PacketTag, Ns3PacketTagFixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SetGetRemove, T, Packets)
+{
+  shared_ptr<T> pkt = makePacket(static_cast<T*>(nullptr));
+  BOOST_CHECK(pkt->template getTag<Ns3PacketTag>() == nullptr);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == nullptr);
+
+  pkt->setTag(packetTag);
+  pkt->setTag(mapTag);
+  BOOST_CHECK(pkt->template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == mapTag);
+  BOOST_CHECK_EQUAL(pkt->template getTag<Ns3PacketTag>()->getPacket()->GetSize(), 100);
+
+  // removing the tag of the inline slot keeps the tag of the map, and vice versa
+  pkt->template removeTag<Ns3PacketTag>();
+  BOOST_CHECK(pkt->template getTag<Ns3PacketTag>() == nullptr);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == mapTag);
+
+  pkt->setTag(packetTag);
+  pkt->template removeTag<MapTag>();
+  BOOST_CHECK(pkt->template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(Copy, T, Packets)
+{
+  shared_ptr<T> pkt = makePacket(static_cast<T*>(nullptr));
+  pkt->setTag(packetTag);
+  pkt->setTag(mapTag);
+
+  // copies share the tags, but set and remove them independently
+  T copy(*pkt);
+  BOOST_CHECK(copy.template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(copy.template getTag<MapTag>() == mapTag);
+
+  pkt->template removeTag<Ns3PacketTag>();
+  BOOST_CHECK(pkt->template getTag<Ns3PacketTag>() == nullptr);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == mapTag);
+  BOOST_CHECK(copy.template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(copy.template getTag<MapTag>() == mapTag);
+
+  copy.template removeTag<MapTag>();
+  BOOST_CHECK(copy.template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(copy.template getTag<MapTag>() == nullptr);
+  BOOST_CHECK(pkt->template getTag<MapTag>() == mapTag);
+
+  T copyOfCopy(copy);
+  BOOST_CHECK(copyOfCopy.template getTag<Ns3PacketTag>() == packetTag);
+  BOOST_CHECK(copyOfCopy.template getTag<MapTag>() == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
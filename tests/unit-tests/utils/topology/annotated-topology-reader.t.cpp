@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/annotated-topology-reader.hpp"
+
+#include "ns3/mobility-model.h"
+
+#include "../../tests-common.hpp"
+
+#include <boost/filesystem.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TOPO_TXT = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.txt";
+const boost::filesystem::path TEST_TOPO_BIN = boost::filesystem::path(TEST_CONFIG_PATH) / "topo.bin";
+
+class AnnotatedTopologyReaderFixture : public CleanupFixture
+{
+public:
+  AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+  }
+
+  ~AnnotatedTopologyReaderFixture()
+  {
+    boost::filesystem::remove(TEST_TOPO_TXT);
+    boost::filesystem::remove(TEST_TOPO_BIN);
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTopologyAnnotatedTopologyReader, AnnotatedTopologyReaderFixture)
+
+BOOST_AUTO_TEST_CASE(BinaryTopology)
+{
+  std::ofstream file(TEST_TOPO_TXT.string().c_str());
+  file << "router\n\n"
+       << "#node city  y x mpi-partition\n"
+       << "A  NA  1 2 0\n"
+       << "B  NA  80  -40 0\n"
+       << "C  NA  80  40  0\n\n"
+       << "link\n\n"
+       << "# from  to  capacity  metric  delay queue\n"
+       << "A      B  10Mbps    100 1ms 100\n"
+       << "A      C  10Mbps    50  2ms 100\n"
+       << "B      C  1Mbps    1 3ms\n";
+  file.close();
+
+  AnnotatedTopologyReader textReader("");
+  textReader.SetFileName(TEST_TOPO_TXT.string());
+  textReader.Read();
+  textReader.SaveBinaryTopology(TEST_TOPO_BIN.string());
+
+  Names::Clear();
+
+  AnnotatedTopologyReader binaryReader("");
+  binaryReader.SetFileName(TEST_TOPO_BIN.string());
+  NodeContainer nodes = binaryReader.ReadBinary();
+
+  BOOST_REQUIRE_EQUAL(nodes.GetN(), 3);
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(0)), "A");
+  BOOST_CHECK_EQUAL(Names::FindName(nodes.Get(2)), "C");
+  for (uint32_t i = 0; i < nodes.GetN(); i++) {
+    Vector original = textReader.GetNodes().Get(i)->GetObject<MobilityModel>()->GetPosition();
+    Vector loaded = nodes.Get(i)->GetObject<MobilityModel>()->GetPosition();
+    BOOST_CHECK_EQUAL(loaded.x, original.x);
+    BOOST_CHECK_EQUAL(loaded.y, original.y);
+  }
+
+  const std::list<TopologyReader::Link>& links = binaryReader.GetLinks();
+  BOOST_REQUIRE_EQUAL(links.size(), 3);
+  std::list<TopologyReader::Link>::const_iterator original = textReader.GetLinks().begin();
+  for (const auto& link : links) {
+    BOOST_CHECK_EQUAL(link.GetFromNodeName(), original->GetFromNodeName());
+    BOOST_CHECK_EQUAL(link.GetToNodeName(), original->GetToNodeName());
+    BOOST_CHECK_EQUAL(link.GetAttribute("DataRate"), original->GetAttribute("DataRate"));
+    BOOST_CHECK_EQUAL(link.GetAttribute("OSPF"), original->GetAttribute("OSPF"));
+    BOOST_CHECK_EQUAL(link.GetAttribute("Delay"), original->GetAttribute("Delay"));
+    BOOST_CHECK(link.GetFromNetDevice() != 0);
+    original++;
+  }
+
+  std::string maxPackets;
+  BOOST_CHECK(!links.back().GetAttributeFailSafe("MaxPackets", maxPackets));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/topology/topology-partitioner.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_AUTO_TEST_SUITE(UtilsTopologyPartitioner)
+
+static void
+addGrid(TopologyPartitioner& partitioner, uint32_t size, Time delay)
+{
+  uint32_t first = partitioner.AddNode();
+  for (uint32_t i = 1; i < size * size; i++)
+    partitioner.AddNode();
+
+  for (uint32_t x = 0; x < size; x++) {
+    for (uint32_t y = 0; y < size; y++) {
+      uint32_t node = first + x * size + y;
+      if (x + 1 < size)
+        partitioner.AddLink(node, node + size, delay);
+      if (y + 1 < size)
+        partitioner.AddLink(node, node + 1, delay);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TwoClusters)
+{
+  // two 10x10 grids with 1ms links, connected by three 20ms links
+  TopologyPartitioner partitioner(2);
+  addGrid(partitioner, 10, MilliSeconds(1));
+  addGrid(partitioner, 10, MilliSeconds(1));
+  for (uint32_t i = 0; i < 3; i++)
+    partitioner.AddLink(i * 10, 100 + i * 10 + 9, MilliSeconds(20));
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition();
+  BOOST_REQUIRE_EQUAL(partitions.size(), 200);
+
+  for (uint32_t i = 1; i < 100; i++) {
+    BOOST_CHECK_EQUAL(partitions[i], partitions[0]);
+    BOOST_CHECK_EQUAL(partitions[100 + i], partitions[100]);
+  }
+  BOOST_CHECK_NE(partitions[0], partitions[100]);
+
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 3);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(BalancedGrid)
+{
+  TopologyPartitioner partitioner(4);
+  addGrid(partitioner, 20, MilliSeconds(1));
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition();
+  BOOST_REQUIRE_EQUAL(partitions.size(), 400);
+
+  std::vector<uint32_t> sizes(4, 0);
+  for (uint32_t partition : partitions) {
+    BOOST_REQUIRE_LT(partition, 4);
+    sizes[partition]++;
+  }
+  for (uint32_t size : sizes) {
+    BOOST_CHECK_GE(size, 95);
+    BOOST_CHECK_LE(size, 105);
+  }
+
+  // cutting the grid into four quadrants needs 40 links, allow some slack
+  BOOST_CHECK_LE(partitioner.GetNCutLinks(), 60);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), MilliSeconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(SinglePartition)
+{
+  TopologyPartitioner partitioner(1);
+  addGrid(partitioner, 5, MilliSeconds(1));
+
+  const std::vector<uint32_t>& partitions = partitioner.Partition();
+  BOOST_REQUIRE_EQUAL(partitions.size(), 25);
+  for (uint32_t partition : partitions)
+    BOOST_CHECK_EQUAL(partition, 0);
+
+  BOOST_CHECK_EQUAL(partitioner.GetNCutLinks(), 0);
+  BOOST_CHECK_EQUAL(partitioner.GetLookahead(), Seconds(0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
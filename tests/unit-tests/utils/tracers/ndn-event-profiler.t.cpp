@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-event-profiler.hpp"
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+static void
+doNothing()
+{
+}
+
+class EventProfilerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  EventProfilerFixture()
+    : output(make_shared<std::stringstream>())
+  {
+    // the profiler must be installed before nodes are created
+    EventProfiler::Install(output, Seconds(1));
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~EventProfilerFixture()
+  {
+    EventProfiler::Destroy(); // next simulations are not profiled
+  }
+
+  /** \brief splits trace into rows of tab-separated fields
+   */
+  static std::vector<std::vector<std::string>>
+  parse(std::istream& is)
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      std::istringstream ls(line);
+      std::string field;
+      while (std::getline(ls, field, '\t')) {
+        fields.push_back(field);
+      }
+      rows.push_back(fields);
+    }
+    return rows;
+  }
+
+public:
+  shared_ptr<std::stringstream> output;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnEventProfiler, EventProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(Profile)
+{
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+  Simulator::Destroy(); // to force totals to be written
+
+  std::vector<std::vector<std::string>> rows = parse(*output);
+  BOOST_REQUIRE_GT(rows.size(), 1);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(rows[0], " "),
+                    "Time Type Label Scheduled Executed Cancelled Pending WallTime");
+
+  std::map<std::string, std::vector<std::string>> totals;
+  std::set<std::string> periods;
+  for (size_t i = 1; i < rows.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(rows[i].size(), 8);
+    if (rows[i][1] == "Total") {
+      BOOST_CHECK_EQUAL(rows[i][0], "2.5");
+      totals[rows[i][2]] = rows[i];
+    }
+    else {
+      BOOST_CHECK_EQUAL(rows[i][1], "Period");
+      periods.insert(rows[i][0]);
+    }
+  }
+  BOOST_CHECK(periods == (std::set<std::string>{"1", "2"}));
+
+  // consumer packets and retransmission checks
+  BOOST_REQUIRE_EQUAL(totals.count("ns3::ndn::Consumer"), 1);
+  BOOST_CHECK_GE(boost::lexical_cast<uint64_t>(totals["ns3::ndn::Consumer"][4]), 25);
+
+#ifdef EVENT_PROFILING
+  // PIT timers, most of them cancelled by the Data
+  BOOST_REQUIRE_EQUAL(totals.count("nfd::Forwarder"), 1);
+  BOOST_CHECK_GT(boost::lexical_cast<uint64_t>(totals["nfd::Forwarder"][5]), 0);
+#endif // EVENT_PROFILING
+
+  for (const auto& total : totals) {
+    uint64_t nScheduled = boost::lexical_cast<uint64_t>(total.second[3]);
+    uint64_t nExecuted = boost::lexical_cast<uint64_t>(total.second[4]);
+    uint64_t nCancelled = boost::lexical_cast<uint64_t>(total.second[5]);
+    uint64_t nPending = boost::lexical_cast<uint64_t>(total.second[6]);
+    BOOST_CHECK_EQUAL(nScheduled, nExecuted + nCancelled + nPending);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ScopedLabel)
+{
+  {
+    EventProfiler::ScopedLabel label("TestLabel");
+    Simulator::Schedule(Seconds(0.5), &doNothing);
+    Simulator::Schedule(Seconds(10), &doNothing);
+  }
+
+  Simulator::Stop(Seconds(1));
+  Simulator::Run();
+  Simulator::Destroy();
+
+  std::vector<std::vector<std::string>> rows = parse(*output);
+  auto row = std::find_if(rows.begin(), rows.end(), [] (const std::vector<std::string>& row) {
+      return row.size() == 8 && row[1] == "Total" && row[2] == "TestLabel";
+    });
+  BOOST_REQUIRE(row != rows.end());
+  BOOST_CHECK_EQUAL((*row)[0], "1");
+  BOOST_CHECK_EQUAL((*row)[3], "2"); // Scheduled
+  BOOST_CHECK_EQUAL((*row)[4], "1"); // Executed
+  BOOST_CHECK_EQUAL((*row)[5], "0"); // Cancelled
+  BOOST_CHECK_EQUAL((*row)[6], "1"); // Pending
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
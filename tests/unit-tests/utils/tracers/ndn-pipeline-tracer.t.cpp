@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-pipeline-tracer.hpp"
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <set>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class PipelineTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  PipelineTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~PipelineTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    PipelineTracer::Destroy(); // additional cleanup
+  }
+
+  /** \brief splits trace into rows of tab-separated fields
+   */
+  static std::vector<std::vector<std::string>>
+  parse(std::istream& is)
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      std::istringstream ls(line);
+      std::string field;
+      while (std::getline(ls, field, '\t')) {
+        fields.push_back(field);
+      }
+      rows.push_back(fields);
+    }
+    return rows;
+  }
+
+  /** \brief row of \p stage in the sample starting at \p firstRow
+   */
+  static const std::vector<std::string>&
+  getStage(const std::vector<std::vector<std::string>>& rows, size_t firstRow,
+           nfd::PipelineStage stage)
+  {
+    return rows[firstRow + stage];
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnPipelineTracer, PipelineTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallNode)
+{
+  PipelineTracer::Install(getNode("2"), TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  PipelineTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::vector<std::vector<std::string>> rows = parse(t);
+
+  // header + 2 samples of all stages
+  BOOST_REQUIRE_EQUAL(rows.size(), 1 + 2 * nfd::N_PIPELINE_STAGES);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(rows[0], " "),
+                    "Time Node Stage Calls Cycles CyclesPerCall");
+
+  for (size_t i = 1; i < rows.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(rows[i].size(), 6);
+    BOOST_CHECK_EQUAL(rows[i][0], i <= nfd::N_PIPELINE_STAGES ? "1" : "2");
+    BOOST_CHECK_EQUAL(rows[i][1], "2");
+    nfd::PipelineStage stage = static_cast<nfd::PipelineStage>((i - 1) % nfd::N_PIPELINE_STAGES);
+    BOOST_CHECK_EQUAL(rows[i][2], nfd::getPipelineStageName(stage));
+  }
+
+#ifdef PIPELINE_PROFILING
+  // second sample: 10 Interests and Data forwarded by the router during the period
+  size_t second = 1 + nfd::N_PIPELINE_STAGES;
+  const auto& incomingInterest = getStage(rows, second, nfd::STAGE_INCOMING_INTEREST);
+  BOOST_CHECK_EQUAL(incomingInterest[3], "10");
+  BOOST_CHECK_GT(boost::lexical_cast<uint64_t>(incomingInterest[4]), 0);
+  BOOST_CHECK_EQUAL(getStage(rows, second, nfd::STAGE_PIT_INSERT)[3], "10");
+  BOOST_CHECK_EQUAL(getStage(rows, second, nfd::STAGE_OUTGOING_INTEREST)[3], "10");
+  BOOST_CHECK_EQUAL(getStage(rows, second, nfd::STAGE_INCOMING_DATA)[3], "10");
+  BOOST_CHECK_EQUAL(getStage(rows, second, nfd::STAGE_OUTGOING_DATA)[3], "10");
+#endif // PIPELINE_PROFILING
+}
+
+BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<PipelineTracer> tracer = PipelineTracer::Install(getNode("1"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  std::vector<std::vector<std::string>> rows = parse(*output);
+  BOOST_REQUIRE_EQUAL(rows.size(), nfd::N_PIPELINE_STAGES);
+  BOOST_CHECK_EQUAL(rows[nfd::STAGE_CS_LOOKUP][2], "CsLookup");
+#ifdef PIPELINE_PROFILING
+  BOOST_CHECK_GT(boost::lexical_cast<uint64_t>(rows[nfd::STAGE_INCOMING_INTEREST][3]), 0);
+#endif // PIPELINE_PROFILING
+}
+
+BOOST_AUTO_TEST_CASE(StageNames)
+{
+  std::set<std::string> names;
+  for (size_t i = 0; i < nfd::N_PIPELINE_STAGES; ++i) {
+    std::string name = nfd::getPipelineStageName(static_cast<nfd::PipelineStage>(i));
+    BOOST_CHECK(!name.empty());
+    BOOST_CHECK_EQUAL(name.find_first_of(" \t"), std::string::npos);
+    names.insert(name);
+  }
+  BOOST_CHECK_EQUAL(names.size(), static_cast<size_t>(nfd::N_PIPELINE_STAGES));
+  BOOST_CHECK_EQUAL(nfd::getPipelineStageName(nfd::STAGE_INCOMING_INTEREST),
+                    std::string("IncomingInterest"));
+  BOOST_CHECK_EQUAL(nfd::getPipelineStageName(nfd::STAGE_OUTGOING_DATA),
+                    std::string("OutgoingData"));
+}
+
+#ifndef PIPELINE_PROFILING
+BOOST_AUTO_TEST_CASE(Disabled)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<PipelineTracer> tracer = PipelineTracer::Install(getNode("2"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  // the rows are written, but the forwarder does not count anything
+  std::vector<std::vector<std::string>> rows = parse(*output);
+  BOOST_REQUIRE_EQUAL(rows.size(), 2 * nfd::N_PIPELINE_STAGES);
+  for (const auto& row : rows) {
+    BOOST_REQUIRE_EQUAL(row.size(), 6);
+    BOOST_CHECK_EQUAL(row[3], "0");
+    BOOST_CHECK_EQUAL(row[4], "0");
+    BOOST_CHECK_EQUAL(row[5], "0");
+  }
+}
+#endif // PIPELINE_PROFILING
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
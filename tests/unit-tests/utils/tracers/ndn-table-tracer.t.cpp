@@ -0,0 +1,228 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-table-tracer.hpp"
+
+#include "helper/ndn-app-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "model/cs/ndn-content-store.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "NFD/daemon/fw/forwarder.hpp"
+
+#include "ns3/point-to-point-helper.h"
+
+#include <boost/algorithm/string/join.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "trace.txt";
+
+class TableTracerFixture : public ScenarioHelperWithCleanupFixture
+{
+public:
+  TableTracerFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    // setting default parameters for PointToPoint links and channels
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    createTopology({
+        {"1", "2"},
+        {"2", "3"}
+      });
+
+    addRoutes({
+        {"1", "2", "/prefix", 1},
+        {"2", "3", "/prefix", 1}
+      });
+
+    addApps({
+        {"1", "ns3::ndn::ConsumerCbr",
+            {{"Prefix", "/prefix"}, {"Frequency", "10"}},
+            "0s", "100s"},
+        {"3", "ns3::ndn::Producer",
+            {{"Prefix", "/prefix"}, {"PayloadSize", "1024"}},
+            "0s", "100s"}
+      });
+  }
+
+  ~TableTracerFixture()
+  {
+    boost::filesystem::remove(TEST_TRACE);
+    TableTracer::Destroy(); // additional cleanup
+  }
+
+  /** \brief splits trace into rows of tab-separated fields
+   */
+  static std::vector<std::vector<std::string>>
+  parse(std::istream& is)
+  {
+    std::vector<std::vector<std::string>> rows;
+    std::string line;
+    while (std::getline(is, line)) {
+      std::vector<std::string> fields;
+      std::istringstream ls(line);
+      std::string field;
+      while (std::getline(ls, field, '\t')) {
+        fields.push_back(field);
+      }
+      rows.push_back(fields);
+    }
+    return rows;
+  }
+};
+
+/** \brief same scenario, with the content store of ndnSIM instead of the one of NFD
+ */
+class OldContentStoreFixture : public CleanupFixture
+{
+public:
+  OldContentStoreFixture()
+  {
+    Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+    Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+    Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+    NodeContainer nodes;
+    nodes.Create(3);
+    Names::Add("1", nodes.Get(0));
+    Names::Add("2", nodes.Get(1));
+    Names::Add("3", nodes.Get(2));
+
+    PointToPointHelper p2p;
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+    p2p.Install(nodes.Get(1), nodes.Get(2));
+
+    StackHelper ndnHelper;
+    ndnHelper.SetOldContentStore("ns3::ndn::cs::Lru", "MaxSize", "100");
+    ndnHelper.InstallAll();
+
+    FibHelper::AddRoute("1", "/prefix", "2", 1);
+    FibHelper::AddRoute("2", "/prefix", "3", 1);
+
+    AppHelper consumerHelper("ns3::ndn::ConsumerCbr");
+    consumerHelper.SetPrefix("/prefix");
+    consumerHelper.SetAttribute("Frequency", StringValue("10"));
+    consumerHelper.Install(nodes.Get(0));
+
+    AppHelper producerHelper("ns3::ndn::Producer");
+    producerHelper.SetPrefix("/prefix");
+    producerHelper.SetAttribute("PayloadSize", StringValue("1024"));
+    producerHelper.Install(nodes.Get(2));
+
+    router = nodes.Get(1);
+  }
+
+  ~OldContentStoreFixture()
+  {
+    TableTracer::Destroy();
+  }
+
+public:
+  Ptr<Node> router;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnTableTracer, TableTracerFixture)
+
+BOOST_AUTO_TEST_CASE(InstallNode)
+{
+  TableTracer::Install(getNode("2"), TEST_TRACE.string(), Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  TableTracer::Destroy(); // to force log to be written
+
+  std::ifstream t(TEST_TRACE.string().c_str());
+  std::vector<std::vector<std::string>> rows = parse(t);
+
+  // header + 2 samples of 6 tables
+  BOOST_REQUIRE_EQUAL(rows.size(), 13);
+  BOOST_CHECK_EQUAL(boost::algorithm::join(rows[0], " "),
+                    "Time Node Table Entries OverheadBytes PayloadBytes");
+
+  const std::vector<std::string> tables = {"NameTree", "Fib", "Pit", "Cs",
+                                           "Measurements", "DeadNonceList"};
+  for (size_t i = 1; i < rows.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(rows[i].size(), 6);
+    BOOST_CHECK_EQUAL(rows[i][0], i <= tables.size() ? "1" : "2");
+    BOOST_CHECK_EQUAL(rows[i][1], "2");
+    BOOST_CHECK_EQUAL(rows[i][2], tables[(i - 1) % tables.size()]);
+  }
+
+  // second sample: /prefix route installed, and Data cached on the router
+  BOOST_CHECK_GE(boost::lexical_cast<size_t>(rows[8][3]), 1); // Fib
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[10][3]), 0); // Cs
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[10][5]), 1024 * 10); // Cs payload
+}
+
+BOOST_AUTO_TEST_CASE(InstallNodeDumpStream)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<TableTracer> tracer = TableTracer::Install(getNode("1"), output, Seconds(1));
+
+  Simulator::Stop(Seconds(1.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  std::vector<std::vector<std::string>> rows = parse(*output);
+  BOOST_REQUIRE_EQUAL(rows.size(), 6);
+  BOOST_CHECK_EQUAL(rows[2][2], "Pit");
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[0][3]), 0); // NameTree
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[0][4]), 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(OldContentStore, OldContentStoreFixture)
+{
+  auto output = make_shared<std::stringstream>();
+  Ptr<TableTracer> tracer = TableTracer::Install(router, output, Seconds(1));
+
+  Simulator::Stop(Seconds(2.5));
+  Simulator::Run();
+
+  tracer = nullptr; // destroy tracer
+
+  // the CS row samples the content store of ndnSIM, which caches the Data
+  Ptr<ContentStore> cs = router->GetObject<ContentStore>();
+  BOOST_REQUIRE(cs != nullptr);
+  BOOST_REQUIRE_GT(cs->GetSize(), 10u);
+  BOOST_REQUIRE_EQUAL(router->GetObject<L3Protocol>()->getForwarder()->getCs().size(), 0u);
+
+  std::vector<std::vector<std::string>> rows = TableTracerFixture::parse(*output);
+  BOOST_REQUIRE_EQUAL(rows.size(), 12);
+  BOOST_CHECK_EQUAL(rows[9][2], "Cs");
+  BOOST_CHECK_EQUAL(boost::lexical_cast<uint32_t>(rows[9][3]), cs->GetSize());
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[9][4]), 0);
+  BOOST_CHECK_GT(boost::lexical_cast<size_t>(rows[9][5]), 1024 * 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-nonce-generator.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/event-impl.h"
+
+namespace ns3 {
+namespace ndn {
+
+static uint64_t
+splitMix64(uint64_t& state)
+{
+  uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+NonceGenerator::~NonceGenerator()
+{
+  // the generator may outlive the simulator, which must not be re-created to cancel the event
+  if (m_resetEvent.PeekEventImpl() != nullptr) {
+    m_resetEvent.PeekEventImpl()->Cancel();
+  }
+}
+
+uint32_t
+NonceGenerator::generateNonce()
+{
+  // Context of the current event is the id of the node it is running on
+  uint32_t nodeId = Simulator::GetContext();
+
+  auto stream = m_streams.find(nodeId);
+  if (stream == m_streams.end()) {
+    if (m_streams.empty()) {
+      m_resetEvent = Simulator::ScheduleDestroy(&NonceGenerator::Reset, this);
+    }
+
+    uint64_t seed = static_cast<uint64_t>(RngSeedManager::GetSeed()) << 32;
+    seed ^= RngSeedManager::GetRun();
+    seed = splitMix64(seed) ^ nodeId;
+
+    Stream newStream;
+    newStream.state[0] = splitMix64(seed);
+    newStream.state[1] = splitMix64(seed);
+    stream = m_streams.insert(std::make_pair(nodeId, newStream)).first;
+  }
+
+  // xorshift128+
+  uint64_t* state = stream->second.state;
+  uint64_t s1 = state[0];
+  const uint64_t s0 = state[1];
+  state[0] = s0;
+  s1 ^= s1 << 23;
+  state[1] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+
+  // high bits have the best statistical quality
+  return static_cast<uint32_t>((state[1] + s0) >> 32);
+}
+
+void
+NonceGenerator::Reset()
+{
+  m_streams.clear();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDNSIM_UTILS_NONCE_GENERATOR_HPP
+#define NDNSIM_UTILS_NONCE_GENERATOR_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/event-id.h"
+
+#include <ndn-cxx/util/random.hpp>
+
+#include <unordered_map>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @brief Reproducible source of Interest nonces
+ *
+ * Each node draws nonces from its own stream of a fast non-cryptographic generator
+ * (xorshift128+).  Streams are seeded from the ns-3 RNG configuration (RngSeed and RngRun)
+ * and the node id, so runs with the same configuration produce the same nonces, independently
+ * of the other random variables of the simulation.  Streams are reset when the simulator is
+ * destroyed.
+ */
+class NonceGenerator : public ::ndn::random::CustomNonceGenerator {
+public:
+  virtual
+  ~NonceGenerator();
+
+  virtual uint32_t
+  generateNonce();
+
+private:
+  void
+  Reset();
+
+private:
+  struct Stream {
+    uint64_t state[2];
+  };
+
+  std::unordered_map<uint32_t, Stream> m_streams; ///< @brief streams indexed by node id
+  EventId m_resetEvent; ///< @brief resets the streams when the simulator is destroyed
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDNSIM_UTILS_NONCE_GENERATOR_HPP
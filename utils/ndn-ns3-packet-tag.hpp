@@ -53,4 +53,18 @@ private:
 } // namespace ndn
 } // namespace ns3
 
+namespace ndn {
+
+/**
+ * @brief Ns3PacketTag is attached to every packet received from a NetDevice, keep it in an
+ *        inline slot of TagHost
+ */
+template<>
+struct TagSlot<ns3::ndn::Ns3PacketTag>
+{
+  static constexpr size_t value = 0;
+};
+
+} // namespace ndn
+
 #endif // NDN_NS3_PACKET_TAG_HPP
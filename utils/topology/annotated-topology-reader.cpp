@@ -20,6 +20,7 @@
 // Based on the code by Hajime Tazaki <tazaki@sfc.wide.ad.jp>
 
 #include "annotated-topology-reader.hpp"
+#include "topology-partitioner.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -69,6 +70,7 @@ AnnotatedTopologyReader::AnnotatedTopologyReader(const std::string& path, double
   , m_randX(CreateObject<UniformRandomVariable>())
   , m_randY(CreateObject<UniformRandomVariable>())
   , m_scale(scale)
+  , m_nPartitions(0)
   , m_requiredPartitions(1)
 {
   NS_LOG_FUNCTION(this);
@@ -101,6 +103,14 @@ AnnotatedTopologyReader::SetMobilityModel(const std::string& model)
   m_mobilityFactory.SetTypeId(model);
 }
 
+void
+AnnotatedTopologyReader::SetPartitions(uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION(this << nPartitions);
+  m_nPartitions = nPartitions;
+  m_requiredPartitions = std::max<uint32_t>(1, nPartitions);
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader()
 {
   NS_LOG_FUNCTION(this);
@@ -175,6 +185,15 @@ AnnotatedTopologyReader::Read(void)
     return m_nodes;
   }
 
+  struct NodeRecord {
+    string name;
+    double latitude;
+    double longitude;
+    uint32_t systemId;
+  };
+  vector<NodeRecord> nodeRecords;
+  map<string, uint32_t> nodeIndices;
+
   while (!topgen.eof()) {
     string line;
     getline(topgen, line);
@@ -184,32 +203,43 @@ AnnotatedTopologyReader::Read(void)
       break; // stop reading nodes
 
     istringstream lineBuffer(line);
-    string name, city;
-    double latitude = 0, longitude = 0;
-    uint32_t systemId = 0;
+    NodeRecord record = {"", 0, 0, 0};
+    string city;
 
-    lineBuffer >> name >> city >> latitude >> longitude >> systemId;
-    if (name.empty())
+    lineBuffer >> record.name >> city >> record.latitude >> record.longitude >> record.systemId;
+    if (record.name.empty())
       continue;
 
-    Ptr<Node> node;
+    nodeIndices[record.name] = nodeRecords.size();
+    nodeRecords.push_back(record);
+  }
 
-    if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
-      node = CreateNode(name, m_scale * longitude, -m_scale * latitude, systemId);
-    else {
-      Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
-      node = CreateNode(name, var->GetValue(0, 200), var->GetValue(0, 200), systemId);
-      // node = CreateNode (name, systemId);
+  auto createNodes = [this, &nodeRecords] {
+    BOOST_FOREACH (const NodeRecord& record, nodeRecords) {
+      if (abs(record.latitude) > 0.001 && abs(record.latitude) > 0.001)
+        CreateNode(record.name, m_scale * record.longitude, -m_scale * record.latitude,
+                   record.systemId);
+      else {
+        Ptr<UniformRandomVariable> var = CreateObject<UniformRandomVariable>();
+        CreateNode(record.name, var->GetValue(0, 200), var->GetValue(0, 200), record.systemId);
+        // node = CreateNode (name, systemId);
+      }
     }
-  }
+  };
 
   map<string, set<string>> processedLinks; // to eliminate duplications
 
   if (topgen.eof()) {
     NS_LOG_ERROR("Topology file " << GetFileName() << " does not have \"link\" section");
+    createNodes();
     return m_nodes;
   }
 
+  struct LinkRecord {
+    string from, to, capacity, metric, delay, maxPackets, lossRate;
+  };
+  vector<LinkRecord> linkRecords;
+
   // SeekToSection ("link");
   while (!topgen.eof()) {
     string line;
@@ -222,44 +252,67 @@ AnnotatedTopologyReader::Read(void)
     // NS_LOG_DEBUG ("Input: [" << line << "]");
 
     istringstream lineBuffer(line);
-    string from, to, capacity, metric, delay, maxPackets, lossRate;
+    LinkRecord record;
 
-    lineBuffer >> from >> to >> capacity >> metric >> delay >> maxPackets >> lossRate;
+    lineBuffer >> record.from >> record.to >> record.capacity >> record.metric >> record.delay
+      >> record.maxPackets >> record.lossRate;
 
-    if (processedLinks[to].size() != 0
-        && processedLinks[to].find(from) != processedLinks[to].end()) {
+    if (processedLinks[record.to].size() != 0
+        && processedLinks[record.to].find(record.from) != processedLinks[record.to].end()) {
       continue; // duplicated link
     }
-    processedLinks[from].insert(to);
+    processedLinks[record.from].insert(record.to);
+
+    NS_ASSERT_MSG(nodeIndices.count(record.from) != 0, record.from << " node not found");
+    NS_ASSERT_MSG(nodeIndices.count(record.to) != 0, record.to << " node not found");
+    linkRecords.push_back(record);
+  }
+  topgen.close();
+
+  // nodes cannot change their systemId once created, partitions are assigned beforehand
+  if (m_nPartitions > 0) {
+    TopologyPartitioner partitioner(m_nPartitions);
+    for (size_t i = 0; i < nodeRecords.size(); i++)
+      partitioner.AddNode();
+
+    BOOST_FOREACH (const LinkRecord& record, linkRecords) {
+      Time delay = record.delay.empty() ? Seconds(0) : Time(record.delay);
+      partitioner.AddLink(nodeIndices[record.from], nodeIndices[record.to], delay);
+    }
 
-    Ptr<Node> fromNode = Names::Find<Node>(m_path, from);
-    NS_ASSERT_MSG(fromNode != 0, from << " node not found");
-    Ptr<Node> toNode = Names::Find<Node>(m_path, to);
-    NS_ASSERT_MSG(toNode != 0, to << " node not found");
+    const vector<uint32_t>& partitions = partitioner.Partition();
+    for (size_t i = 0; i < nodeRecords.size(); i++)
+      nodeRecords[i].systemId = partitions[i];
+  }
 
-    Link link(fromNode, from, toNode, to);
+  createNodes();
 
-    link.SetAttribute("DataRate", capacity);
-    link.SetAttribute("OSPF", metric);
+  BOOST_FOREACH (const LinkRecord& record, linkRecords) {
+    Ptr<Node> fromNode = Names::Find<Node>(m_path, record.from);
+    Ptr<Node> toNode = Names::Find<Node>(m_path, record.to);
 
-    if (!delay.empty())
-      link.SetAttribute("Delay", delay);
-    if (!maxPackets.empty())
-      link.SetAttribute("MaxPackets", maxPackets);
+    Link link(fromNode, record.from, toNode, record.to);
+
+    link.SetAttribute("DataRate", record.capacity);
+    link.SetAttribute("OSPF", record.metric);
+
+    if (!record.delay.empty())
+      link.SetAttribute("Delay", record.delay);
+    if (!record.maxPackets.empty())
+      link.SetAttribute("MaxPackets", record.maxPackets);
 
     // Saran Added lossRate
-    if (!lossRate.empty())
-      link.SetAttribute("LossRate", lossRate);
+    if (!record.lossRate.empty())
+      link.SetAttribute("LossRate", record.lossRate);
 
     AddLink(link);
-    NS_LOG_DEBUG("New link " << from << " <==> " << to << " / " << capacity << " with " << metric
-                             << " metric (" << delay << ", " << maxPackets << ", " << lossRate
-                             << ")");
+    NS_LOG_DEBUG("New link " << record.from << " <==> " << record.to << " / " << record.capacity
+                             << " with " << record.metric << " metric (" << record.delay << ", "
+                             << record.maxPackets << ", " << record.lossRate << ")");
   }
 
   NS_LOG_INFO("Annotated topology created with " << m_nodes.GetN() << " nodes and " << LinksSize()
                                                  << " links");
-  topgen.close();
 
   ApplySettings();
 
@@ -574,4 +627,244 @@ AnnotatedTopologyReader::SaveGraphviz(const std::string& file)
   write_graphviz(of, graph, make_name_writer(names));
 }
 
+
+/// @cond include_hidden
+
+namespace {
+
+const uint32_t BINARY_TOPOLOGY_MAGIC = 0x4e444e54; // "NDNT"
+const uint32_t BINARY_TOPOLOGY_VERSION = 1;
+
+// smallest records: empty name/no attributes
+const size_t MIN_NODE_RECORD_SIZE = sizeof(uint16_t) + sizeof(uint8_t) + 2 * sizeof(double)
+                                    + sizeof(uint32_t) + sizeof(uint8_t);
+const size_t MIN_LINK_RECORD_SIZE = 2 * sizeof(uint32_t) + sizeof(uint16_t);
+
+template<class T>
+void
+writeValue(ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+writeString(ostream& os, const string& value)
+{
+  writeValue<uint16_t>(os, value.size());
+  os.write(value.data(), value.size());
+}
+
+template<class T>
+T
+readValue(istream& is)
+{
+  T value = T();
+  is.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+string
+readString(istream& is)
+{
+  uint16_t size = readValue<uint16_t>(is);
+  string value(size, '\0');
+  is.read(&value[0], size);
+  return value;
+}
+
+/**
+ * \brief Read the number of records that follow, failing the stream if the rest of the stream
+ *        cannot hold that many records of at least \p minRecordSize bytes
+ *
+ * Prevents allocating for a corrupted count.
+ */
+uint32_t
+readCount(istream& is, size_t minRecordSize)
+{
+  uint32_t count = readValue<uint32_t>(is);
+  if (!is)
+    return 0;
+
+  istream::pos_type position = is.tellg();
+  is.seekg(0, ios::end);
+  istream::pos_type end = is.tellg();
+  is.seekg(position);
+  if (!is || position < 0 || end < position
+      || static_cast<uint64_t>(end - position) / minRecordSize < count) {
+    is.setstate(ios::failbit);
+    return 0;
+  }
+  return count;
+}
+
+} // namespace
+
+/// @endcond
+
+void
+AnnotatedTopologyReader::SaveBinaryTopology(const std::string& file)
+{
+  ofstream os(file.c_str(), ios::trunc | ios::binary);
+  if (!os.is_open()) {
+    NS_LOG_ERROR("File " << file << " cannot be opened for writing");
+    return;
+  }
+
+  writeValue(os, BINARY_TOPOLOGY_MAGIC);
+  writeValue(os, BINARY_TOPOLOGY_VERSION);
+
+  map<Ptr<Node>, uint32_t> nodeIndices;
+  writeValue<uint32_t>(os, m_nodes.GetN());
+  for (NodeContainer::Iterator node = m_nodes.Begin(); node != m_nodes.End(); node++) {
+    uint32_t index = nodeIndices.size();
+    nodeIndices[*node] = index;
+
+    writeString(os, Names::FindName(*node));
+
+    Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel>();
+    writeValue<uint8_t>(os, mobility != 0);
+    Vector position = mobility != 0 ? mobility->GetPosition() : Vector();
+    writeValue(os, position.x);
+    writeValue(os, position.y);
+
+    writeValue(os, (*node)->GetSystemId());
+    writeValue(os, GetNodeRole(*node));
+  }
+
+  writeValue<uint32_t>(os, m_linksList.size());
+  BOOST_FOREACH (const Link& link, m_linksList) {
+    writeValue(os, nodeIndices[link.GetFromNode()]);
+    writeValue(os, nodeIndices[link.GetToNode()]);
+
+    writeValue<uint16_t>(os, std::distance(link.AttributesBegin(), link.AttributesEnd()));
+    for (Link::ConstAttributesIterator attribute = link.AttributesBegin();
+         attribute != link.AttributesEnd(); attribute++) {
+      writeString(os, attribute->first);
+      writeString(os, attribute->second);
+    }
+  }
+}
+
+NodeContainer
+AnnotatedTopologyReader::ReadBinary()
+{
+  ifstream is(GetFileName().c_str(), ios::binary);
+  if (!is.is_open()) {
+    NS_FATAL_ERROR("Cannot open file " << GetFileName() << " for reading");
+    return m_nodes;
+  }
+
+  if (readValue<uint32_t>(is) != BINARY_TOPOLOGY_MAGIC
+      || readValue<uint32_t>(is) != BINARY_TOPOLOGY_VERSION) {
+    NS_FATAL_ERROR("File " << GetFileName() << " is not a binary topology of this version "
+                           "(or was saved on a machine with different byte order)");
+    return m_nodes;
+  }
+
+  struct NodeRecord {
+    string name;
+    bool hasPosition;
+    double x;
+    double y;
+    uint32_t systemId;
+    uint8_t role;
+  };
+  vector<NodeRecord> nodeRecords(readCount(is, MIN_NODE_RECORD_SIZE));
+  BOOST_FOREACH (NodeRecord& record, nodeRecords) {
+    record.name = readString(is);
+    record.hasPosition = readValue<uint8_t>(is) != 0;
+    record.x = readValue<double>(is);
+    record.y = readValue<double>(is);
+    record.systemId = readValue<uint32_t>(is);
+    record.role = readValue<uint8_t>(is);
+    if (!is)
+      break;
+  }
+
+  struct LinkRecord {
+    uint32_t from;
+    uint32_t to;
+    vector<pair<string, string>> attributes;
+  };
+  vector<LinkRecord> linkRecords(readCount(is, MIN_LINK_RECORD_SIZE));
+  BOOST_FOREACH (LinkRecord& record, linkRecords) {
+    record.from = readValue<uint32_t>(is);
+    record.to = readValue<uint32_t>(is);
+    record.attributes.resize(readValue<uint16_t>(is));
+    for (size_t i = 0; i < record.attributes.size(); i++) {
+      record.attributes[i].first = readString(is);
+      record.attributes[i].second = readString(is);
+    }
+
+    if (record.from >= nodeRecords.size() || record.to >= nodeRecords.size()) {
+      is.setstate(ios::failbit);
+    }
+    if (!is)
+      break;
+  }
+
+  if (!is) {
+    NS_FATAL_ERROR("Binary topology file " << GetFileName() << " is truncated or corrupted");
+    return m_nodes;
+  }
+  is.close();
+
+  if (m_nPartitions > 0) {
+    TopologyPartitioner partitioner(m_nPartitions);
+    for (size_t i = 0; i < nodeRecords.size(); i++)
+      partitioner.AddNode();
+
+    BOOST_FOREACH (const LinkRecord& record, linkRecords) {
+      Time delay = Seconds(0);
+      for (size_t i = 0; i < record.attributes.size(); i++) {
+        if (record.attributes[i].first == "Delay")
+          delay = Time(record.attributes[i].second);
+      }
+      partitioner.AddLink(record.from, record.to, delay);
+    }
+
+    const vector<uint32_t>& partitions = partitioner.Partition();
+    for (size_t i = 0; i < nodeRecords.size(); i++)
+      nodeRecords[i].systemId = partitions[i];
+  }
+
+  vector<Ptr<Node>> nodes;
+  nodes.reserve(nodeRecords.size());
+  BOOST_FOREACH (const NodeRecord& record, nodeRecords) {
+    Ptr<Node> node = record.hasPosition
+                       ? CreateNode(record.name, record.x, record.y, record.systemId)
+                       : CreateNode(record.name, record.systemId);
+    SetNodeRole(node, record.role);
+    nodes.push_back(node);
+  }
+
+  // nodes are resolved by index, not by name
+  BOOST_FOREACH (const LinkRecord& record, linkRecords) {
+    Link link(nodes[record.from], nodeRecords[record.from].name, nodes[record.to],
+              nodeRecords[record.to].name);
+    for (size_t i = 0; i < record.attributes.size(); i++) {
+      link.SetAttribute(record.attributes[i].first, record.attributes[i].second);
+    }
+    AddLink(link);
+  }
+
+  NS_LOG_INFO("Binary topology loaded with " << m_nodes.GetN() << " nodes and " << LinksSize()
+                                             << " links");
+
+  ApplySettings();
+
+  return m_nodes;
+}
+
+uint8_t
+AnnotatedTopologyReader::GetNodeRole(Ptr<Node> node) const
+{
+  return 0;
+}
+
+void
+AnnotatedTopologyReader::SetNodeRole(Ptr<Node> node, uint8_t role)
+{
+}
+
 }
@@ -97,6 +97,19 @@ public:
   virtual void
   SetMobilityModel(const std::string& model);
 
+  /**
+   * \brief Assign nodes automatically to logical processes of a distributed (MPI) simulation
+   *
+   * When set (before Read), the mpi-partition column of the topology file is ignored, and
+   * nodes are assigned to \p nPartitions partitions so that few links, and only long ones,
+   * cross partitions (see TopologyPartitioner).  With MPI enabled, \p nPartitions should be
+   * MpiInterface::GetSize ().
+   *
+   * \param nPartitions number of partitions, 0 to use the partitions of the topology file
+   */
+  void
+  SetPartitions(uint32_t nPartitions);
+
   /**
    * \brief Apply OSPF metric on Ipv4 (if exists) and Ccnx (if exists) stacks
    */
@@ -115,6 +128,24 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+  /**
+   * \brief Save the topology (nodes, their positions and roles, and link attributes) in a
+   * compact binary format
+   *
+   * Loading the binary file with ReadBinary avoids parsing and processing the original
+   * topology again, e.g., in parameter sweeps over a large Rocketfuel map.  The file uses the
+   * byte order of the machine that saved it.
+   */
+  void
+  SaveBinaryTopology(const std::string& file);
+
+  /**
+   * \brief Read topology saved by SaveBinaryTopology from the file set by SetFileName
+   * \return the container of the nodes created (or empty container if there was an error)
+   */
+  NodeContainer
+  ReadBinary();
+
 protected:
   Ptr<Node>
   CreateNode(const std::string name, uint32_t systemId);
@@ -131,9 +162,22 @@ protected:
   void
   ApplySettings();
 
+  /**
+   * \brief Get the role of \p node, saved with the node in the binary topology format
+   */
+  virtual uint8_t
+  GetNodeRole(Ptr<Node> node) const;
+
+  /**
+   * \brief Restore the role of \p node read from the binary topology format
+   */
+  virtual void
+  SetNodeRole(Ptr<Node> node, uint8_t role);
+
 protected:
   std::string m_path;
   NodeContainer m_nodes;
+  uint32_t m_nPartitions;
 
 private:
   AnnotatedTopologyReader(const AnnotatedTopologyReader&);
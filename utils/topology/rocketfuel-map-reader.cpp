@@ -20,6 +20,7 @@
 // Based on the code by Hajime Tazaki <tazaki@sfc.wide.ad.jp>
 
 #include "rocketfuel-map-reader.hpp"
+#include "topology-partitioner.hpp"
 
 #include "ns3/nstime.h"
 #include "ns3/log.h"
@@ -93,14 +94,12 @@ RocketfuelMapReader::Read()
         "\\(([0-9]+)\\)" SPACE "(&[0-9]+)*" MAYSPACE "->" MAYSPACE "(<[0-9 \t<>]+>)*" MAYSPACE     \
         "(\\{-[0-9\\{\\} \t-]+\\})*" SPACE "=([A-Za-z0-9.!-]+)" SPACE "r([0-9])" MAYSPACE END
 
-void
-RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double averageRtt,
-                                const string& minBw, const string& maxBw, const string& minDelay,
-                                const string& maxDelay)
+TopologyReader::Link
+RocketfuelMapReader::DrawLinkAttributes(double averageRtt, const string& minBw,
+                                        const string& maxBw, const string& minDelay,
+                                        const string& maxDelay)
 {
-  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
-  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
-  Link link(node1, nodeName1, node2, nodeName2);
+  Link link(0, "", 0, "");
 
   DataRate randBandwidth(
     m_randVar->GetInteger(static_cast<uint32_t>(lexical_cast<DataRate>(minBw).GetBitRate()),
@@ -122,6 +121,21 @@ RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, double avera
                     boost::lexical_cast<string>(ceil(randDelay.ToDouble(Time::US))) + "us");
   link.SetAttribute("MaxPackets", boost::lexical_cast<string>(queue));
 
+  return link;
+}
+
+void
+RocketfuelMapReader::CreateLink(string nodeName1, string nodeName2, const Link& attributes)
+{
+  Ptr<Node> node1 = Names::Find<Node>(m_path, nodeName1);
+  Ptr<Node> node2 = Names::Find<Node>(m_path, nodeName2);
+  Link link(node1, nodeName1, node2, nodeName2);
+
+  for (Link::ConstAttributesIterator attribute = attributes.AttributesBegin();
+       attribute != attributes.AttributesEnd(); attribute++) {
+    link.SetAttribute(attribute->first, attribute->second);
+  }
+
   AddLink(link);
 }
 
@@ -396,60 +410,89 @@ RocketfuelMapReader::Read(RocketfuelParams params, bool keepOneComponent /*=true
     NS_LOG_DEBUG("After 2 eliminating disconnected nodes:  " << num_vertices(m_graph));
   }
 
+  // link attributes are drawn before nodes are created, as link delays determine the partitions
+  std::vector<std::pair<Traits::vertex_descriptor, Traits::vertex_descriptor>> linkVertices;
+  std::vector<Link> linkAttributes;
+
+  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
+    Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
+
+    node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
+
+    linkVertices.push_back(std::make_pair(u, v));
+    if (u_type == BACKBONE && v_type == BACKBONE) {
+      linkAttributes.push_back(DrawLinkAttributes(params.averageRtt, params.minb2bBandwidth,
+                                                  params.maxb2bBandwidth, params.minb2bDelay,
+                                                  params.maxb2bDelay));
+    }
+    else if ((u_type == GATEWAY && v_type == BACKBONE)
+             || (u_type == BACKBONE && v_type == GATEWAY)) {
+      linkAttributes.push_back(DrawLinkAttributes(params.averageRtt, params.minb2gBandwidth,
+                                                  params.maxb2gBandwidth, params.minb2gDelay,
+                                                  params.maxb2gDelay));
+    }
+    else if (u_type == GATEWAY && v_type == GATEWAY) {
+      linkAttributes.push_back(DrawLinkAttributes(params.averageRtt, params.minb2gBandwidth,
+                                                  params.maxb2gBandwidth, params.minb2gDelay,
+                                                  params.maxb2gDelay));
+    }
+    else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
+      linkAttributes.push_back(DrawLinkAttributes(params.averageRtt, params.ming2cBandwidth,
+                                                  params.maxg2cBandwidth, params.ming2cDelay,
+                                                  params.maxg2cDelay));
+    }
+    else {
+      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
+    }
+  }
+
+  map<Traits::vertex_descriptor, uint32_t> systemIds;
+  if (m_nPartitions > 0) {
+    TopologyPartitioner partitioner(m_nPartitions);
+    map<Traits::vertex_descriptor, uint32_t> indices;
+    for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
+      indices[*v] = partitioner.AddNode();
+    }
+
+    for (size_t i = 0; i < linkVertices.size(); i++) {
+      partitioner.AddLink(indices[linkVertices[i].first], indices[linkVertices[i].second],
+                          lexical_cast<Time>(linkAttributes[i].GetAttribute("Delay")));
+    }
+
+    const std::vector<uint32_t>& partitions = partitioner.Partition();
+    for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
+      systemIds[*v] = partitions[indices[*v]];
+    }
+  }
+
   for (tie(v, endv) = vertices(m_graph); v != endv; v++) {
     string nodeName = get(vertex_name, m_graph, *v);
-    Ptr<Node> node = CreateNode(nodeName, 0);
+    Ptr<Node> node = CreateNode(nodeName, systemIds[*v]);
 
     node_type_t type = get(vertex_rank, m_graph, *v);
     switch (type) {
     case BACKBONE:
       Names::Rename(nodeName, "bb-" + nodeName);
       put(vertex_name, m_graph, *v, "bb-" + nodeName);
-      m_backboneRouters.Add(node);
       break;
     case CLIENT:
       Names::Rename(nodeName, "leaf-" + nodeName);
       put(vertex_name, m_graph, *v, "leaf-" + nodeName);
-      m_customerRouters.Add(node);
       break;
     case GATEWAY:
       Names::Rename(nodeName, "gw-" + nodeName);
       put(vertex_name, m_graph, *v, "gw-" + nodeName);
-      m_gatewayRouters.Add(node);
       break;
     case UNKNOWN:
       NS_FATAL_ERROR("Should not happen");
       break;
     }
+    SetNodeRole(node, type);
   }
 
-  for (tie(e, ende) = edges(m_graph); e != ende; e++) {
-    Traits::vertex_descriptor u = source(*e, m_graph), v = target(*e, m_graph);
-
-    node_type_t u_type = get(vertex_rank, m_graph, u), v_type = get(vertex_rank, m_graph, v);
-
-    string u_name = get(vertex_name, m_graph, u), v_name = get(vertex_name, m_graph, v);
-
-    if (u_type == BACKBONE && v_type == BACKBONE) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2bBandwidth, params.maxb2bBandwidth,
-                 params.minb2bDelay, params.maxb2bDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == BACKBONE)
-             || (u_type == BACKBONE && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if (u_type == GATEWAY && v_type == GATEWAY) {
-      CreateLink(u_name, v_name, params.averageRtt, params.minb2gBandwidth, params.maxb2gBandwidth,
-                 params.minb2gDelay, params.maxb2gDelay);
-    }
-    else if ((u_type == GATEWAY && v_type == CLIENT) || (u_type == CLIENT && v_type == GATEWAY)) {
-      CreateLink(u_name, v_name, params.averageRtt, params.ming2cBandwidth, params.maxg2cBandwidth,
-                 params.ming2cDelay, params.maxg2cDelay);
-    }
-    else {
-      NS_FATAL_ERROR("Wrong link type between nodes: " << u_type << " <-> " << v_type);
-    }
+  for (size_t i = 0; i < linkVertices.size(); i++) {
+    CreateLink(get(vertex_name, m_graph, linkVertices[i].first),
+               get(vertex_name, m_graph, linkVertices[i].second), linkAttributes[i]);
   }
 
   ApplySettings();
@@ -480,6 +523,33 @@ RocketfuelMapReader::GetCustomerRouters() const
   return m_customerRouters;
 }
 
+uint8_t
+RocketfuelMapReader::GetNodeRole(Ptr<Node> node) const
+{
+  std::map<Ptr<Node>, node_type_t>::const_iterator type = m_nodeTypes.find(node);
+  return type != m_nodeTypes.end() ? type->second : UNKNOWN;
+}
+
+void
+RocketfuelMapReader::SetNodeRole(Ptr<Node> node, uint8_t role)
+{
+  switch (role) {
+  case BACKBONE:
+    m_backboneRouters.Add(node);
+    break;
+  case CLIENT:
+    m_customerRouters.Add(node);
+    break;
+  case GATEWAY:
+    m_gatewayRouters.Add(node);
+    break;
+  default:
+    NS_LOG_WARN("Node " << Names::FindName(node) << " has unknown type " << +role);
+    return;
+  }
+  m_nodeTypes[node] = static_cast<node_type_t>(role);
+}
+
 static void
 nodeWriter(std::ostream& os, NodeContainer& m)
 {
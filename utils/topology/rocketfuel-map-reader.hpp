@@ -124,6 +124,13 @@ public:
   virtual void
   SaveGraphviz(const std::string& file);
 
+protected:
+  virtual uint8_t
+  GetNodeRole(Ptr<Node> node) const;
+
+  virtual void
+  SetNodeRole(Ptr<Node> node, uint8_t role);
+
 private:
   RocketfuelMapReader(const RocketfuelMapReader&);
   RocketfuelMapReader&
@@ -133,9 +140,16 @@ private:
   void
   GenerateFromMapsFile(int argc, char* argv[]);
 
+  /**
+   * \brief Draw random bandwidth, delay, and queue size of a link (nodes of the returned link
+   * are not set)
+   */
+  Link
+  DrawLinkAttributes(double averageRtt, const string& minBw, const string& maxBw,
+                     const string& minDelay, const string& maxDelay);
+
   void
-  CreateLink(string nodeName1, string nodeName2, double averageRtt, const string& minBw,
-             const string& maxBw, const string& minDelay, const string& maxDelay);
+  CreateLink(string nodeName1, string nodeName2, const Link& attributes);
   void
   KeepOnlyBiggestConnectedComponent();
 
@@ -174,6 +188,8 @@ private:
   Graph m_graph;
   uint32_t m_maxNodeId;
 
+  std::map<Ptr<Node>, node_type_t> m_nodeTypes; ///< \brief types of created nodes
+
   const DataRate m_referenceOspfRate; // reference rate of OSPF metric calculation
 
 private:
@@ -0,0 +1,413 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "topology-partitioner.hpp"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <set>
+
+NS_LOG_COMPONENT_DEFINE("TopologyPartitioner");
+
+namespace ns3 {
+
+static const uint32_t MAX_REFINEMENT_PASSES = 10;
+
+// a refinement pass stops after this many moves without improving the cut
+static const uint32_t MAX_UNPRODUCTIVE_MOVES = 200;
+
+TopologyPartitioner::TopologyPartitioner(uint32_t nPartitions)
+  : m_nPartitions(std::max<uint32_t>(nPartitions, 1))
+  , m_nNodes(0)
+  , m_nCutLinks(0)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddNode()
+{
+  return m_nNodes++;
+}
+
+void
+TopologyPartitioner::AddLink(uint32_t node1, uint32_t node2, Time delay)
+{
+  NS_ASSERT(node1 < m_nNodes && node2 < m_nNodes);
+  m_links.push_back({node1, node2, delay});
+}
+
+const std::vector<uint32_t>&
+TopologyPartitioner::Partition()
+{
+  m_partitions.assign(m_nNodes, 0);
+
+  if (m_nPartitions > 1 && m_nNodes > 0) {
+    Time threshold = FindDelayThreshold();
+    uint32_t nGroups, maxGroupSize;
+    std::vector<uint32_t> nodeGroups = GroupNodes(threshold, nGroups, maxGroupSize);
+    NS_LOG_DEBUG(nGroups << " groups of nodes linked by less than " << threshold.ToDouble(Time::MS)
+                         << "ms, largest has " << maxGroupSize << " nodes");
+
+    m_adjacency.assign(nGroups, std::vector<uint32_t>());
+    m_weights.assign(nGroups, 0);
+    for (uint32_t node = 0; node < m_nNodes; ++node) {
+      ++m_weights[nodeGroups[node]];
+    }
+    for (const Link& link : m_links) {
+      uint32_t group1 = nodeGroups[link.node1], group2 = nodeGroups[link.node2];
+      if (group1 != group2) {
+        m_adjacency[group1].push_back(group2);
+        m_adjacency[group2].push_back(group1);
+      }
+    }
+
+    m_groupPartitions.assign(nGroups, 0);
+    m_isActive.assign(nGroups, false);
+    m_side.assign(nGroups, 0);
+
+    std::vector<uint32_t> groups(nGroups);
+    for (uint32_t group = 0; group < nGroups; ++group) {
+      groups[group] = group;
+    }
+    Bisect(groups, m_nPartitions, 0);
+
+    for (uint32_t node = 0; node < m_nNodes; ++node) {
+      m_partitions[node] = m_groupPartitions[nodeGroups[node]];
+    }
+  }
+
+  m_lookahead = Seconds(0);
+  m_nCutLinks = 0;
+  for (const Link& link : m_links) {
+    if (m_partitions[link.node1] == m_partitions[link.node2])
+      continue;
+
+    if (m_nCutLinks == 0 || link.delay < m_lookahead) {
+      m_lookahead = link.delay;
+    }
+    ++m_nCutLinks;
+  }
+
+  NS_LOG_INFO(m_nNodes << " nodes in " << m_nPartitions << " partitions, " << m_nCutLinks
+                       << " links cut, lookahead " << m_lookahead.ToDouble(Time::MS) << "ms");
+  return m_partitions;
+}
+
+Time
+TopologyPartitioner::GetLookahead() const
+{
+  return m_lookahead;
+}
+
+uint32_t
+TopologyPartitioner::GetNCutLinks() const
+{
+  return m_nCutLinks;
+}
+
+std::vector<uint32_t>
+TopologyPartitioner::GroupNodes(Time threshold, uint32_t& nGroups, uint32_t& maxGroupSize) const
+{
+  // union-find
+  std::vector<uint32_t> parents(m_nNodes);
+  for (uint32_t node = 0; node < m_nNodes; ++node) {
+    parents[node] = node;
+  }
+  auto findRoot = [&parents] (uint32_t node) {
+    while (parents[node] != node) {
+      node = parents[node] = parents[parents[node]];
+    }
+    return node;
+  };
+
+  for (const Link& link : m_links) {
+    if (link.delay < threshold) {
+      parents[findRoot(link.node1)] = findRoot(link.node2);
+    }
+  }
+
+  std::vector<uint32_t> groups(m_nNodes, m_nNodes);
+  std::vector<uint32_t> sizes;
+  for (uint32_t node = 0; node < m_nNodes; ++node) {
+    uint32_t root = findRoot(node);
+    if (groups[root] == m_nNodes) {
+      groups[root] = sizes.size();
+      sizes.push_back(0);
+    }
+    groups[node] = groups[root];
+    ++sizes[groups[node]];
+  }
+
+  nGroups = sizes.size();
+  maxGroupSize = *std::max_element(sizes.begin(), sizes.end());
+  return groups;
+}
+
+Time
+TopologyPartitioner::FindDelayThreshold() const
+{
+  std::vector<Time> delays;
+  for (const Link& link : m_links) {
+    delays.push_back(link.delay);
+  }
+  std::sort(delays.begin(), delays.end());
+  delays.erase(std::unique(delays.begin(), delays.end(),
+                           [] (const Time& a, const Time& b) { return !(a < b) && !(b < a); }),
+               delays.end());
+  if (delays.empty())
+    return Seconds(0);
+
+  // grouping is monotonic in the threshold: binary search of the largest acceptable one
+  uint32_t maxGroupSize = std::max<uint32_t>(1, m_nNodes / m_nPartitions / 4);
+  size_t low = 0, high = delays.size() - 1;
+  while (low < high) {
+    size_t middle = (low + high + 1) / 2;
+    uint32_t nGroups, groupSize;
+    GroupNodes(delays[middle], nGroups, groupSize);
+    if (groupSize <= maxGroupSize) {
+      low = middle;
+    }
+    else {
+      high = middle - 1;
+    }
+  }
+  return delays[low];
+}
+
+void
+TopologyPartitioner::Bisect(const std::vector<uint32_t>& groups, uint32_t nPartitions,
+                            uint32_t firstPartition)
+{
+  if (nPartitions == 1 || groups.size() <= 1) {
+    for (uint32_t group : groups) {
+      m_groupPartitions[group] = firstPartition;
+    }
+    return;
+  }
+
+  uint32_t totalWeight = 0, maxWeight = 0;
+  for (uint32_t group : groups) {
+    totalWeight += m_weights[group];
+    maxWeight = std::max(maxWeight, m_weights[group]);
+    m_isActive[group] = true;
+    m_side[group] = 1;
+  }
+
+  uint32_t nFirst = nPartitions / 2;
+  uint32_t targetWeight = (static_cast<uint64_t>(totalWeight) * nFirst + nPartitions / 2) / nPartitions;
+  uint32_t slack = std::max(targetWeight * 3 / 100, maxWeight);
+
+  GrowRegion(groups, targetWeight);
+  Refine(groups, targetWeight, slack);
+
+  std::vector<uint32_t> first, second;
+  for (uint32_t group : groups) {
+    m_isActive[group] = false;
+    (m_side[group] == 0 ? first : second).push_back(group);
+  }
+
+  NS_LOG_DEBUG("Bisection " << firstPartition << "+" << nPartitions << ": " << first.size()
+                            << " / " << second.size() << " groups");
+
+  Bisect(first, nFirst, firstPartition);
+  Bisect(second, nPartitions - nFirst, firstPartition + nFirst);
+}
+
+uint32_t
+TopologyPartitioner::FindPeripheralGroup(const std::vector<uint32_t>& groups, uint32_t start) const
+{
+  // two breadth-first searches: the last group reached is far from the center
+  std::vector<bool> isVisited(m_adjacency.size(), false);
+  for (int i = 0; i < 2; ++i) {
+    for (uint32_t group : groups) {
+      isVisited[group] = false;
+    }
+
+    std::deque<uint32_t> queue{start};
+    isVisited[start] = true;
+    while (!queue.empty()) {
+      start = queue.front();
+      queue.pop_front();
+      for (uint32_t neighbor : m_adjacency[start]) {
+        if (m_isActive[neighbor] && !isVisited[neighbor]) {
+          isVisited[neighbor] = true;
+          queue.push_back(neighbor);
+        }
+      }
+    }
+  }
+  return start;
+}
+
+void
+TopologyPartitioner::GrowRegion(const std::vector<uint32_t>& groups, uint32_t regionWeight)
+{
+  // gain of moving a group into the region: links to the region minus links to the rest
+  std::vector<int32_t> gains(m_adjacency.size(), 0);
+  for (uint32_t group : groups) {
+    int32_t internal, external;
+    GetConnectivity(group, internal, external);
+    gains[group] = -internal;
+  }
+
+  std::set<std::pair<int32_t, uint32_t>> frontier;
+  std::vector<uint32_t>::const_iterator nextSeed = groups.begin();
+  uint32_t seed = FindPeripheralGroup(groups, groups.front());
+
+  for (uint32_t weight = 0; weight < regionWeight;) {
+    uint32_t group;
+    if (!frontier.empty()) {
+      group = std::prev(frontier.end())->second;
+      frontier.erase(std::prev(frontier.end()));
+    }
+    else if (weight == 0) {
+      group = seed;
+    }
+    else {
+      // disconnected component
+      while (m_side[*nextSeed] == 0) {
+        ++nextSeed;
+      }
+      group = *nextSeed;
+    }
+
+    m_side[group] = 0;
+    weight += m_weights[group];
+    for (uint32_t neighbor : m_adjacency[group]) {
+      if (!m_isActive[neighbor] || m_side[neighbor] == 0)
+        continue;
+
+      frontier.erase(std::make_pair(gains[neighbor], neighbor));
+      gains[neighbor] += 2;
+      frontier.insert(std::make_pair(gains[neighbor], neighbor));
+    }
+  }
+}
+
+void
+TopologyPartitioner::Refine(const std::vector<uint32_t>& groups, uint32_t targetWeight,
+                            uint32_t slack)
+{
+  int64_t firstWeight = 0;
+  for (uint32_t group : groups) {
+    if (m_side[group] == 0) {
+      firstWeight += m_weights[group];
+    }
+  }
+
+  // a move must keep the first side within the slack, or bring it closer to the target
+  auto isBalanced = [&] (int64_t weight) {
+    return std::abs(weight - targetWeight) <= slack ||
+           std::abs(weight - targetWeight) < std::abs(firstWeight - targetWeight);
+  };
+
+  std::vector<int32_t> gains(m_adjacency.size(), 0);
+  std::vector<bool> isLocked(m_adjacency.size(), false);
+
+  for (uint32_t pass = 0; pass < MAX_REFINEMENT_PASSES; ++pass) {
+    // gain of moving a group to the other side
+    std::set<std::pair<int32_t, uint32_t>> candidates[2];
+    for (uint32_t group : groups) {
+      int32_t internal, external;
+      GetConnectivity(group, internal, external);
+      gains[group] = external - internal;
+      isLocked[group] = false;
+      candidates[m_side[group]].insert(std::make_pair(gains[group], group));
+    }
+
+    std::vector<uint32_t> moves;
+    int64_t totalGain = 0;
+    int64_t bestGain = 0;
+    size_t nBestMoves = 0;
+    int64_t bestImbalance = std::abs(firstWeight - targetWeight);
+
+    while (moves.size() - nBestMoves < MAX_UNPRODUCTIVE_MOVES) {
+      // best move on each side
+      std::set<std::pair<int32_t, uint32_t>>::reverse_iterator best[2];
+      for (uint8_t side = 0; side < 2; ++side) {
+        int sign = side == 0 ? -1 : 1;
+        best[side] = std::find_if(candidates[side].rbegin(), candidates[side].rend(),
+          [&] (const std::pair<int32_t, uint32_t>& candidate) {
+            return isBalanced(firstWeight + sign * m_weights[candidate.second]);
+          });
+      }
+      bool canMoveFirst = best[0] != candidates[0].rend();
+      bool canMoveSecond = best[1] != candidates[1].rend();
+      if (!canMoveFirst && !canMoveSecond)
+        break;
+
+      uint8_t from = canMoveFirst && (!canMoveSecond || best[0]->first >= best[1]->first) ? 0 : 1;
+      uint32_t group = best[from]->second;
+      candidates[from].erase(std::next(best[from]).base());
+
+      isLocked[group] = true;
+      m_side[group] = 1 - from;
+      firstWeight += from == 0 ? -static_cast<int64_t>(m_weights[group]) : m_weights[group];
+      totalGain += gains[group];
+      moves.push_back(group);
+
+      int64_t imbalance = std::abs(firstWeight - targetWeight);
+      if (totalGain > bestGain || (totalGain == bestGain && imbalance < bestImbalance)) {
+        bestGain = totalGain;
+        bestImbalance = imbalance;
+        nBestMoves = moves.size();
+      }
+
+      for (uint32_t neighbor : m_adjacency[group]) {
+        if (!m_isActive[neighbor] || isLocked[neighbor])
+          continue;
+
+        std::set<std::pair<int32_t, uint32_t>>& neighborCandidates = candidates[m_side[neighbor]];
+        neighborCandidates.erase(std::make_pair(gains[neighbor], neighbor));
+        gains[neighbor] += m_side[neighbor] == from ? 2 : -2;
+        neighborCandidates.insert(std::make_pair(gains[neighbor], neighbor));
+      }
+    }
+
+    // keep the best prefix of the moves
+    for (size_t i = nBestMoves; i < moves.size(); ++i) {
+      uint32_t group = moves[i];
+      firstWeight += m_side[group] == 0 ? -static_cast<int64_t>(m_weights[group]) : m_weights[group];
+      m_side[group] = 1 - m_side[group];
+    }
+
+    NS_LOG_DEBUG("Refinement pass " << pass << ": " << nBestMoves << " moves, gain " << bestGain);
+    if (nBestMoves == 0)
+      break;
+  }
+}
+
+void
+TopologyPartitioner::GetConnectivity(uint32_t group, int32_t& internal, int32_t& external) const
+{
+  internal = 0;
+  external = 0;
+  for (uint32_t neighbor : m_adjacency[group]) {
+    if (!m_isActive[neighbor])
+      continue;
+
+    (m_side[neighbor] == m_side[group] ? internal : external) += 1;
+  }
+}
+
+} // namespace ns3
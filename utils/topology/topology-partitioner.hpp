@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Assigns topology nodes to the logical processes of a distributed (MPI) simulation
+ *
+ * Each logical process can only advance up to the smallest delay of the links that cross
+ * partitions (the lookahead), and every packet sent on such a link is an MPI message.  The
+ * partitioner first maximizes the lookahead: it looks for the largest delay such that the
+ * nodes connected by shorter links form groups small enough to be kept together (at most a
+ * quarter of a partition).  Shorter links are then never cut, and the groups are split into
+ * balanced partitions with a minimum number of links between them.
+ *
+ * The k-way partition is obtained by recursive bisection.  Each bisection grows a region from
+ * a peripheral group, then refines the cut with Fiduccia-Mattheyses passes.  Partitions differ
+ * in size by a few percent, or by the size of the largest group.
+ */
+class TopologyPartitioner {
+public:
+  /**
+   * \param nPartitions number of logical processes
+   */
+  explicit TopologyPartitioner(uint32_t nPartitions);
+
+  /**
+   * \brief Add a node
+   * \return index of the node, to be used in AddLink and in the result of Partition
+   */
+  uint32_t
+  AddNode();
+
+  /**
+   * \brief Add a link between two previously added nodes
+   */
+  void
+  AddLink(uint32_t node1, uint32_t node2, Time delay);
+
+  /**
+   * \brief Compute the partitions
+   * \return partition (system id) of each node, in order of addition
+   */
+  const std::vector<uint32_t>&
+  Partition();
+
+  /**
+   * \brief Smallest delay of the links between two partitions (zero if there is none)
+   */
+  Time
+  GetLookahead() const;
+
+  /**
+   * \brief Number of links between two partitions
+   */
+  uint32_t
+  GetNCutLinks() const;
+
+private:
+  /**
+   * \brief group the nodes connected by links shorter than \p threshold
+   * \return group of each node, groups are numbered from 0
+   */
+  std::vector<uint32_t>
+  GroupNodes(Time threshold, uint32_t& nGroups, uint32_t& maxGroupSize) const;
+
+  /**
+   * \brief largest delay such that links below it can be kept inside partitions
+   */
+  Time
+  FindDelayThreshold() const;
+
+  void
+  Bisect(const std::vector<uint32_t>& groups, uint32_t nPartitions, uint32_t firstPartition);
+
+  void
+  GrowRegion(const std::vector<uint32_t>& groups, uint32_t regionWeight);
+
+  void
+  Refine(const std::vector<uint32_t>& groups, uint32_t targetWeight, uint32_t slack);
+
+  uint32_t
+  FindPeripheralGroup(const std::vector<uint32_t>& groups, uint32_t start) const;
+
+  /**
+   * \brief number of links from \p group to its own side, and to the other side
+   */
+  void
+  GetConnectivity(uint32_t group, int32_t& internal, int32_t& external) const;
+
+private:
+  struct Link {
+    uint32_t node1;
+    uint32_t node2;
+    Time delay;
+  };
+
+  uint32_t m_nPartitions;
+  uint32_t m_nNodes;
+  std::vector<Link> m_links;
+  std::vector<uint32_t> m_partitions;
+  Time m_lookahead;
+  uint32_t m_nCutLinks;
+
+  // graph of the groups of nodes
+  std::vector<std::vector<uint32_t>> m_adjacency;
+  std::vector<uint32_t> m_weights; ///< \brief number of nodes in each group
+  std::vector<uint32_t> m_groupPartitions;
+
+  // state of the current bisection, indexed by group
+  std::vector<bool> m_isActive; ///< \brief whether the group is part of the bisected set
+  std::vector<uint8_t> m_side;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
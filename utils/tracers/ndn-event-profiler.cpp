@@ -0,0 +1,438 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-event-profiler.hpp"
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/event-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/log.h"
+
+#include <boost/algorithm/string/erase.hpp>
+
+#include <cxxabi.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+NS_LOG_COMPONENT_DEFINE("ndn.EventProfiler");
+
+namespace ns3 {
+namespace ndn {
+
+const std::type_info* EventProfiler::s_labelType = nullptr;
+const char* EventProfiler::s_labelName = nullptr;
+
+static shared_ptr<std::ostream> g_os;
+static Time g_samplingPeriod;
+
+/**
+ * @brief Simulator implementation that wraps the scheduled events to count them and time
+ *        their handlers, see EventProfiler
+ */
+class ProfilingSimulatorImpl : public DefaultSimulatorImpl {
+public:
+  static TypeId
+  GetTypeId();
+
+  ProfilingSimulatorImpl();
+
+  virtual void
+  Destroy();
+
+  virtual EventId
+  Schedule(const Time& delay, EventImpl* event);
+
+  virtual void
+  ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event);
+
+  virtual EventId
+  ScheduleNow(EventImpl* event);
+
+  virtual void
+  Remove(const EventId& id);
+
+  virtual void
+  Cancel(const EventId& id);
+
+private:
+  class ProfiledEvent : public EventImpl {
+  public:
+    ProfiledEvent(ProfilingSimulatorImpl& impl, EventImpl* event, size_t label)
+      : m_impl(impl)
+      , m_event(event, false)
+      , m_label(label)
+    {
+    }
+
+  protected:
+    virtual void
+    Notify()
+    {
+      m_impl.Execute(*this);
+    }
+
+  public:
+    ProfilingSimulatorImpl& m_impl;
+    Ptr<EventImpl> m_event;
+    size_t m_label;
+  };
+
+  struct Counters {
+    uint64_t nScheduled = 0;
+    uint64_t nExecuted = 0;
+    uint64_t nCancelled = 0;
+    std::chrono::steady_clock::duration wallTime = std::chrono::steady_clock::duration::zero();
+  };
+
+  EventImpl*
+  Wrap(EventImpl* event);
+
+  size_t
+  GetLabelIndex(const std::string& label);
+
+  void
+  Execute(ProfiledEvent& event);
+
+  void
+  Forget(const EventId& id);
+
+  void
+  Print(const std::string& type, const Time& time, const std::vector<Counters>& base) const;
+
+private:
+  shared_ptr<std::ostream> m_os;
+  Time m_period;
+  Time m_nextSample;
+
+  std::vector<std::string> m_labels;
+  std::vector<Counters> m_counters;
+  std::vector<Counters> m_lastCounters; ///< @brief counters at the last sample
+  std::map<std::string, size_t> m_labelIndex;
+  std::unordered_map<std::type_index, size_t> m_typeIndex;
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingSimulatorImpl);
+
+TypeId
+ProfilingSimulatorImpl::GetTypeId()
+{
+  static TypeId tid = TypeId("ns3::ndn::ProfilingSimulatorImpl")
+                        .SetGroupName("Ndn")
+                        .SetParent<DefaultSimulatorImpl>()
+                        .AddConstructor<ProfilingSimulatorImpl>();
+  return tid;
+}
+
+ProfilingSimulatorImpl::ProfilingSimulatorImpl()
+  : m_os(g_os)
+  , m_period(g_samplingPeriod)
+  , m_nextSample(g_samplingPeriod)
+{
+  if (m_os != nullptr) {
+    EventProfiler::PrintHeader(*m_os);
+    *m_os << "\n";
+  }
+}
+
+void
+ProfilingSimulatorImpl::Destroy()
+{
+  if (m_os != nullptr) {
+    Print("Total", Now(), std::vector<Counters>(m_counters.size()));
+    m_os->flush();
+    m_os = nullptr;
+  }
+
+  DefaultSimulatorImpl::Destroy();
+}
+
+EventId
+ProfilingSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+  return DefaultSimulatorImpl::Schedule(delay, Wrap(event));
+}
+
+void
+ProfilingSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event)
+{
+  DefaultSimulatorImpl::ScheduleWithContext(context, delay, Wrap(event));
+}
+
+EventId
+ProfilingSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+  return DefaultSimulatorImpl::ScheduleNow(Wrap(event));
+}
+
+void
+ProfilingSimulatorImpl::Remove(const EventId& id)
+{
+  Forget(id);
+  DefaultSimulatorImpl::Remove(id);
+}
+
+void
+ProfilingSimulatorImpl::Cancel(const EventId& id)
+{
+  Forget(id);
+  DefaultSimulatorImpl::Cancel(id);
+}
+
+EventImpl*
+ProfilingSimulatorImpl::Wrap(EventImpl* event)
+{
+  size_t label;
+  if (EventProfiler::s_labelName != nullptr) {
+    label = GetLabelIndex(EventProfiler::s_labelName);
+  }
+  else {
+    const std::type_info& type =
+      EventProfiler::s_labelType != nullptr ? *EventProfiler::s_labelType : typeid(*event);
+
+    auto it = m_typeIndex.find(type);
+    if (it == m_typeIndex.end()) {
+      it = m_typeIndex.insert({type, GetLabelIndex(EventProfiler::GetLabel(type))}).first;
+    }
+    label = it->second;
+  }
+
+  ++m_counters[label].nScheduled;
+  return new ProfiledEvent(*this, event, label);
+}
+
+size_t
+ProfilingSimulatorImpl::GetLabelIndex(const std::string& label)
+{
+  auto it = m_labelIndex.find(label);
+  if (it != m_labelIndex.end()) {
+    return it->second;
+  }
+
+  m_labels.push_back(label);
+  m_counters.push_back(Counters());
+  m_lastCounters.push_back(Counters());
+  m_labelIndex[label] = m_labels.size() - 1;
+  return m_labels.size() - 1;
+}
+
+void
+ProfilingSimulatorImpl::Execute(ProfiledEvent& event)
+{
+  if (m_os != nullptr && m_period.IsStrictlyPositive() && Now() >= m_nextSample) {
+    Print("Period", m_nextSample, m_lastCounters);
+    m_lastCounters = m_counters;
+    while (m_nextSample <= Now()) {
+      m_nextSample += m_period;
+    }
+  }
+
+  ++m_counters[event.m_label].nExecuted;
+
+  auto start = std::chrono::steady_clock::now();
+  event.m_event->Invoke();
+  // the counters may be reallocated by events labeled for the first time
+  m_counters[event.m_label].wallTime += std::chrono::steady_clock::now() - start;
+}
+
+void
+ProfilingSimulatorImpl::Forget(const EventId& id)
+{
+  if (IsExpired(id)) {
+    return;
+  }
+
+  auto event = dynamic_cast<ProfiledEvent*>(PeekPointer(id.PeekEventImpl()));
+  if (event != nullptr) {
+    ++m_counters[event->m_label].nCancelled;
+  }
+}
+
+void
+ProfilingSimulatorImpl::Print(const std::string& type, const Time& time,
+                              const std::vector<Counters>& base) const
+{
+  for (size_t i = 0; i < m_labels.size(); ++i) {
+    const Counters& counters = m_counters[i];
+    uint64_t nPending = counters.nScheduled - counters.nExecuted - counters.nCancelled;
+    uint64_t nScheduled = counters.nScheduled - base[i].nScheduled;
+    if (nScheduled == 0 && nPending == 0) {
+      continue;
+    }
+
+    *m_os << time.ToDouble(Time::S) << "\t"
+          << type << "\t"
+          << m_labels[i] << "\t"
+          << nScheduled << "\t"
+          << counters.nExecuted - base[i].nExecuted << "\t"
+          << counters.nCancelled - base[i].nCancelled << "\t"
+          << nPending << "\t"
+          << std::chrono::duration<double>(counters.wallTime - base[i].wallTime).count() << "\n";
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+void
+EventProfiler::Install(const std::string& file, Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Profiling disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  Install(outputStream, samplingPeriod);
+}
+
+void
+EventProfiler::Install(shared_ptr<std::ostream> outputStream,
+                       Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  g_os = outputStream;
+  g_samplingPeriod = samplingPeriod;
+  GlobalValue::Bind("SimulatorImplementationType",
+                    StringValue("ns3::ndn::ProfilingSimulatorImpl"));
+
+  // the simulator is created on first use, with the implementation type set at that time
+  if (DynamicCast<ProfilingSimulatorImpl>(Simulator::GetImplementation()) == nullptr) {
+    NS_FATAL_ERROR("EventProfiler must be installed before the simulator is used");
+  }
+}
+
+void
+EventProfiler::Destroy()
+{
+  g_os = nullptr;
+  GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+void
+EventProfiler::PrintHeader(std::ostream& os)
+{
+  os << "Time"
+     << "\t"
+     << "Type"
+     << "\t"
+     << "Label"
+     << "\t"
+     << "Scheduled"
+     << "\t"
+     << "Executed"
+     << "\t"
+     << "Cancelled"
+     << "\t"
+     << "Pending"
+     << "\t"
+     << "WallTime";
+}
+
+/**
+ * @brief position of the first (or last) occurrence of \p c outside of template arguments
+ */
+static size_t
+findOutsideTemplates(const std::string& name, char c, bool isLast = false)
+{
+  size_t found = std::string::npos;
+  int depth = 0;
+  for (size_t i = 0; i < name.size(); ++i) {
+    if (name[i] == '<') {
+      ++depth;
+    }
+    else if (name[i] == '>') {
+      --depth;
+    }
+    else if (depth == 0 && name[i] == c) {
+      found = i;
+      if (!isLast) {
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+std::string
+EventProfiler::GetLabel(const std::type_info& type)
+{
+  int status = 0;
+  std::unique_ptr<char, void (*)(void*)> demangled(abi::__cxa_demangle(type.name(), nullptr,
+                                                                       nullptr, &status),
+                                                   std::free);
+  std::string name = status == 0 ? demangled.get() : type.name();
+  boost::algorithm::erase_all(name, "(anonymous namespace)::");
+
+  // lambda: "void nfd::Forwarder::f<T>(nfd::Face&)::{lambda()#1}" -> "nfd::Forwarder::f<T>"
+  size_t lambda = name.find("::{lambda");
+  if (lambda != std::string::npos) {
+    name = name.substr(0, lambda);
+    name = name.substr(0, findOutsideTemplates(name, '('));
+    size_t space = findOutsideTemplates(name, ' ', true);
+    return space == std::string::npos ? name : name.substr(space + 1);
+  }
+
+  // member function: "ns3::MakeEvent<void (ns3::ndn::Consumer::*)(), ...>" -> "ns3::ndn::Consumer"
+  size_t member = name.find("::*");
+  if (member != std::string::npos) {
+    size_t begin = member;
+    int depth = 0;
+    for (; begin > 0; --begin) {
+      char c = name[begin - 1];
+      if (c == '>') {
+        ++depth;
+      }
+      else if (c == '<' && depth > 0) {
+        --depth;
+      }
+      else if (depth == 0 && (c == '(' || c == '<' || c == ' ' || c == ',')) {
+        break;
+      }
+    }
+    return name.substr(begin, member - begin);
+  }
+
+  // free function: "ns3::MakeEvent(void (*)())::EventFunctionImpl0"
+  if (name.find("(*)") != std::string::npos) {
+    return "function";
+  }
+
+  return name;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_EVENT_PROFILER_H
+#define NDN_EVENT_PROFILER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ns3/nstime.h>
+
+#include <typeinfo>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-tracers
+ * @brief Profiler of the simulator events, grouped by the component that scheduled them
+ *
+ * Once installed, the profiler replaces the simulator implementation with one that labels
+ * every scheduled event and records, per label, the number of events scheduled, executed and
+ * cancelled, the number of pending events (the share of the event queue held by the label),
+ * and the real time spent in the event handlers.  Counters are written every sampling period,
+ * and totals are written when the simulator is destroyed.
+ *
+ * An event is labeled by the class of the member function it invokes (e.g.,
+ * ``ns3::ndn::Consumer``), or by the function that defines the lambda it invokes (e.g.,
+ * ``nfd::Forwarder::setUnsatisfyTimer``), and call sites can override the label with
+ * ScopedLabel.  Events scheduled through nfd::scheduler::schedule are labeled after the
+ * callback given to the scheduler only when ndnSIM is configured with --with-event-profiling;
+ * otherwise they all share the label of std::function.
+ *
+ * The profiler must be installed before anything is scheduled, including the creation of
+ * nodes.  Distributed (MPI) simulations are not supported.
+ */
+class EventProfiler {
+public:
+  /**
+   * @brief Helper method to install the profiler
+   *
+   * @param file File to which traces will be written.  If filename is -, then std::out is used
+   * @param samplingPeriod How often counters will be written into the trace file (default,
+   *        every second)
+   */
+  static void
+  Install(const std::string& file, Time samplingPeriod = Seconds(1.0));
+
+  /**
+   * @brief Helper method to install the profiler
+   *
+   * @param outputStream Smart pointer to a stream
+   * @param samplingPeriod How often counters will be written into the trace file (default,
+   *        every second)
+   */
+  static void
+  Install(shared_ptr<std::ostream> outputStream, Time samplingPeriod = Seconds(1.0));
+
+  /**
+   * @brief Explicit request to remove the profiler
+   *
+   * The simulator created after the next Simulator::Destroy will not be profiled
+   */
+  static void
+  Destroy();
+
+  /**
+   * @brief Get the label of events of a given type
+   *
+   * @param type type of an ns-3 event, or of a callback given to nfd::scheduler::schedule
+   */
+  static std::string
+  GetLabel(const std::type_info& type);
+
+  /**
+   * @brief Print head of the trace (e.g., for post-processing)
+   *
+   * @param os reference to output stream
+   */
+  static void
+  PrintHeader(std::ostream& os);
+
+  /**
+   * @brief Label the events scheduled during the lifetime of the object
+   */
+  class ScopedLabel {
+  public:
+    /**
+     * @brief Label the events after a type instead of their own type
+     */
+    explicit
+    ScopedLabel(const std::type_info& type)
+      : m_prevType(s_labelType)
+      , m_prevName(s_labelName)
+    {
+      s_labelType = &type;
+      s_labelName = nullptr;
+    }
+
+    /**
+     * @brief Label the events with a fixed label
+     * @param label string with static storage duration
+     */
+    explicit
+    ScopedLabel(const char* label)
+      : m_prevType(s_labelType)
+      , m_prevName(s_labelName)
+    {
+      s_labelType = nullptr;
+      s_labelName = label;
+    }
+
+    ScopedLabel(const ScopedLabel&) = delete;
+
+    ScopedLabel&
+    operator=(const ScopedLabel&) = delete;
+
+    ~ScopedLabel()
+    {
+      s_labelType = m_prevType;
+      s_labelName = m_prevName;
+    }
+
+  private:
+    const std::type_info* m_prevType;
+    const char* m_prevName;
+  };
+
+private:
+  friend class ProfilingSimulatorImpl;
+
+  static const std::type_info* s_labelType;
+  static const char* s_labelName;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_EVENT_PROFILER_H
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-pipeline-tracer.hpp"
+
+#include "ns3/node.h"
+#include "ns3/names.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-partition-helper.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "daemon/fw/forwarder.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PipelineTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<PipelineTracer>>>> g_tracers;
+
+void
+PipelineTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+PipelineTracer::InstallAll(const std::string& file, Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<PipelineTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(PartitionHelper::GetRankFileName(file).c_str(),
+             std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!PartitionHelper::IsLocal(*node))
+      continue;
+
+    Ptr<PipelineTracer> trace = Install(*node, outputStream, averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+PipelineTracer::Install(const NodeContainer& nodes, const std::string& file,
+                  Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<PipelineTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    Ptr<PipelineTracer> trace = Install(*node, outputStream, averagingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+PipelineTracer::Install(Ptr<Node> node, const std::string& file,
+                  Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<PipelineTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  Ptr<PipelineTracer> trace = Install(node, outputStream, averagingPeriod);
+  tracers.push_back(trace);
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<PipelineTracer>
+PipelineTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                     Time averagingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<PipelineTracer> trace = Create<PipelineTracer>(outputStream, node);
+  trace->SetAveragingPeriod(averagingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+PipelineTracer::PipelineTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+
+  Reset();
+}
+
+PipelineTracer::PipelineTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
+  , m_os(os)
+{
+  Reset();
+}
+
+PipelineTracer::~PipelineTracer()
+{
+}
+
+void
+PipelineTracer::SetAveragingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &PipelineTracer::PeriodicPrinter, this);
+}
+
+void
+PipelineTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+  Reset();
+
+  m_printEvent = Simulator::Schedule(m_period, &PipelineTracer::PeriodicPrinter, this);
+}
+
+void
+PipelineTracer::Reset()
+{
+  m_last.fill(nfd::ForwarderProfiler::StageCounters{0, 0});
+
+  if (m_nodePtr == nullptr) {
+    return;
+  }
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  if (l3 == nullptr || l3->getForwarder() == nullptr) {
+    return;
+  }
+
+  const nfd::ForwarderProfiler& profiler = l3->getForwarder()->getProfiler();
+  for (size_t stage = 0; stage < nfd::N_PIPELINE_STAGES; ++stage) {
+    m_last[stage] = profiler.get(static_cast<nfd::PipelineStage>(stage));
+  }
+}
+
+void
+PipelineTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Stage"
+     << "\t"
+     << "Calls"
+     << "\t"
+     << "Cycles"
+     << "\t"
+     << "CyclesPerCall";
+}
+
+void
+PipelineTracer::Print(std::ostream& os) const
+{
+  if (m_nodePtr == nullptr) {
+    return;
+  }
+
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  if (l3 == nullptr) {
+    NS_LOG_DEBUG("Node " << m_node << " has no NDN stack installed");
+    return;
+  }
+  const nfd::ForwarderProfiler& profiler = l3->getForwarder()->getProfiler();
+
+  Time time = Simulator::Now();
+
+  for (size_t i = 0; i < nfd::N_PIPELINE_STAGES; ++i) {
+    nfd::PipelineStage stage = static_cast<nfd::PipelineStage>(i);
+    uint64_t nCalls = profiler.get(stage).nCalls - m_last[i].nCalls;
+    uint64_t nCycles = profiler.get(stage).nCycles - m_last[i].nCycles;
+
+    os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << nfd::getPipelineStageName(stage)
+       << "\t" << nCalls << "\t" << nCycles << "\t"
+       << (nCalls == 0 ? 0 : static_cast<double>(nCycles) / nCalls) << "\n";
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
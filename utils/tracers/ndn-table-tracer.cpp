@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-table-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/names.h"
+
+#include "model/ndn-l3-protocol.hpp"
+#include "model/cs/ndn-content-store.hpp"
+#include "helper/ndn-partition-helper.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include "daemon/fw/forwarder.hpp"
+#include "daemon/table/table-memory-usage.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+NS_LOG_COMPONENT_DEFINE("ndn.TableTracer");
+
+namespace ns3 {
+namespace ndn {
+
+static std::list<std::tuple<shared_ptr<std::ostream>, std::list<Ptr<TableTracer>>>> g_tracers;
+
+/**
+ * @brief Estimate the memory usage of an ndnSIM content store, like nfd::Cs::getMemoryUsage
+ *
+ * Entries are indexed by a trie of name components: each entry is counted with one trie node,
+ * and inner nodes shared by several entries are not counted.
+ */
+static nfd::TableMemoryUsage
+getContentStoreMemoryUsage(ContentStore& cs)
+{
+  // trie node: key, payload, parent pointer, hook, children set and its bucket array, rounded up
+  static const size_t TRIE_NODE_OVERHEAD = 12 * sizeof(void*);
+
+  nfd::TableMemoryUsage usage;
+  usage.nEntries = cs.GetSize();
+  usage.overheadBytes = usage.nEntries * (sizeof(cs::Entry) + TRIE_NODE_OVERHEAD);
+  for (Ptr<cs::Entry> entry = cs.Begin(); entry != cs.End(); entry = cs.Next(entry)) {
+    shared_ptr<const Data> data = entry->GetData();
+    if (data->hasWire()) {
+      usage.payloadBytes += data->wireEncode().size();
+    }
+    else {
+      usage.payloadBytes += nfd::getNameHeapSize(data->getName());
+    }
+  }
+  return usage;
+}
+
+void
+TableTracer::Destroy()
+{
+  g_tracers.clear();
+}
+
+void
+TableTracer::InstallAll(const std::string& file, Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<TableTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(PartitionHelper::GetRankFileName(file).c_str(),
+             std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    if (!PartitionHelper::IsLocal(*node))
+      continue;
+
+    Ptr<TableTracer> trace = Install(*node, outputStream, samplingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+TableTracer::Install(const NodeContainer& nodes, const std::string& file,
+                  Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<TableTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(PartitionHelper::GetRankFileName(file).c_str(),
+             std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+    if (!PartitionHelper::IsLocal(*node))
+      continue;
+
+    Ptr<TableTracer> trace = Install(*node, outputStream, samplingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+void
+TableTracer::Install(Ptr<Node> node, const std::string& file,
+                  Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  using namespace boost;
+  using namespace std;
+
+  std::list<Ptr<TableTracer>> tracers;
+  shared_ptr<std::ostream> outputStream;
+  if (file != "-") {
+    shared_ptr<std::ofstream> os(new std::ofstream());
+    os->open(PartitionHelper::GetRankFileName(file).c_str(),
+             std::ios_base::out | std::ios_base::trunc);
+
+    if (!os->is_open()) {
+      NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+      return;
+    }
+
+    outputStream = os;
+  }
+  else {
+    outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([]{}));
+  }
+
+  if (PartitionHelper::IsLocal(node)) {
+    Ptr<TableTracer> trace = Install(node, outputStream, samplingPeriod);
+    tracers.push_back(trace);
+  }
+
+  if (tracers.size() > 0) {
+    // *m_l3RateTrace << "# "; // not necessary for R's read.table
+    tracers.front()->PrintHeader(*outputStream);
+    *outputStream << "\n";
+  }
+
+  g_tracers.push_back(std::make_tuple(outputStream, tracers));
+}
+
+Ptr<TableTracer>
+TableTracer::Install(Ptr<Node> node, shared_ptr<std::ostream> outputStream,
+                     Time samplingPeriod /* = Seconds (1.0)*/)
+{
+  NS_LOG_DEBUG("Node: " << node->GetId());
+
+  Ptr<TableTracer> trace = Create<TableTracer>(outputStream, node);
+  trace->SetSamplingPeriod(samplingPeriod);
+
+  return trace;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+TableTracer::TableTracer(shared_ptr<std::ostream> os, Ptr<Node> node)
+  : m_nodePtr(node)
+  , m_os(os)
+{
+  m_node = boost::lexical_cast<std::string>(m_nodePtr->GetId());
+
+  std::string name = Names::FindName(node);
+  if (!name.empty()) {
+    m_node = name;
+  }
+}
+
+TableTracer::TableTracer(shared_ptr<std::ostream> os, const std::string& node)
+  : m_node(node)
+  , m_nodePtr(Names::Find<Node>(node))
+  , m_os(os)
+{
+}
+
+TableTracer::~TableTracer()
+{
+}
+
+void
+TableTracer::SetSamplingPeriod(const Time& period)
+{
+  m_period = period;
+  m_printEvent.Cancel();
+  m_printEvent = Simulator::Schedule(m_period, &TableTracer::PeriodicPrinter, this);
+}
+
+void
+TableTracer::PeriodicPrinter()
+{
+  Print(*m_os);
+
+  m_printEvent = Simulator::Schedule(m_period, &TableTracer::PeriodicPrinter, this);
+}
+
+void
+TableTracer::PrintHeader(std::ostream& os) const
+{
+  os << "Time"
+     << "\t"
+
+     << "Node"
+     << "\t"
+
+     << "Table"
+     << "\t"
+     << "Entries"
+     << "\t"
+     << "OverheadBytes"
+     << "\t"
+     << "PayloadBytes";
+}
+
+void
+TableTracer::PrintUsage(std::ostream& os, const Time& time, const std::string& table,
+                        const nfd::TableMemoryUsage& usage) const
+{
+  os << time.ToDouble(Time::S) << "\t" << m_node << "\t" << table << "\t" << usage.nEntries
+     << "\t" << usage.overheadBytes << "\t" << usage.payloadBytes << "\n";
+}
+
+void
+TableTracer::Print(std::ostream& os) const
+{
+  if (m_nodePtr == nullptr) {
+    return;
+  }
+
+  Ptr<L3Protocol> l3 = m_nodePtr->GetObject<L3Protocol>();
+  if (l3 == nullptr) {
+    NS_LOG_DEBUG("Node " << m_node << " has no NDN stack installed");
+    return;
+  }
+  shared_ptr<nfd::Forwarder> forwarder = l3->getForwarder();
+
+  Time time = Simulator::Now();
+
+  PrintUsage(os, time, "NameTree", forwarder->getNameTree().getMemoryUsage());
+  PrintUsage(os, time, "Fib", forwarder->getFib().getMemoryUsage());
+  PrintUsage(os, time, "Pit", forwarder->getPit().getMemoryUsage());
+  // the forwarder uses the content store of ndnSIM instead of its own when one is installed
+  Ptr<ContentStore> csFromNdnSim = m_nodePtr->GetObject<ContentStore>();
+  if (csFromNdnSim != nullptr) {
+    PrintUsage(os, time, "Cs", getContentStoreMemoryUsage(*csFromNdnSim));
+  }
+  else {
+    PrintUsage(os, time, "Cs", forwarder->getCs().getMemoryUsage());
+  }
+  PrintUsage(os, time, "Measurements", forwarder->getMeasurements().getMemoryUsage());
+  PrintUsage(os, time, "DeadNonceList", forwarder->getDeadNonceList().getMemoryUsage());
+}
+
+} // namespace ndn
+} // namespace ns3